@@ -0,0 +1,223 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_batch_compression.cpp
+/// @brief zstd vs LZ4, with and without a trained dictionary, on MQTT batches
+///
+/// Builds the MqttSink's framed topic batches (TopicBatcher) of VSS
+/// signals - 50 paths from three probes, values drifting - as JSON and as
+/// MessagePack, at 10 and 100 messages per batch. A dictionary is trained
+/// with ZDICT_trainFromBuffer on the messages of every other batch, the way
+/// vdr_train_dictionary does on captured traffic, and BatchCompressor is
+/// measured on the remaining batches so that the dictionary has not seen
+/// them. Every compressed batch is checked to decompress to its input.
+/// Reported per format, batch size, algorithm and level: compression
+/// ratio and CPU milliseconds per MiB of input, the two numbers MqttSink
+/// adds to SinkStats.
+///
+/// Usage: bench_batch_compression [signals]
+
+#include "bench_utils.hpp"
+#include "vdr/sinks/batch_compressor.hpp"
+#include "vdr/sinks/json_encoder.hpp"
+#include "vdr/sinks/msgpack_encoder.hpp"
+#include "vdr/sinks/topic_batcher.hpp"
+
+#include <zdict.h>
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using vdr::sinks::Compression;
+using vdr::sinks::CompressionConfig;
+
+std::vector<std::string> make_paths() {
+    const char* branches[] = {"Powertrain.TractionBattery", "Chassis", "Body.Lights", "ADAS",
+                              "Cabin.HVAC"};
+    const char* leaves[] = {"Temperature", "Current", "Voltage", "IsActive", "Angle",
+                            "Position", "Speed", "Pressure", "Level", "Status"};
+    std::vector<std::string> paths;
+    for (const char* branch : branches) {
+        for (const char* leaf : leaves) {
+            paths.push_back(std::string("Vehicle.") + branch + "." + leaf);
+        }
+    }
+    return paths;
+}
+
+// Payloads as MqttSink queues them, one std::string per message
+std::vector<std::string> make_payloads(size_t count, bool msgpack) {
+    static const std::vector<std::string> paths = make_paths();
+    const char* sources[] = {"can_probe", "adas_probe", "hvac_probe"};
+    std::mt19937 gen(42);
+    std::normal_distribution<double> drift(0.0, 0.5);
+    std::vector<double> values(paths.size(), 20.0);
+
+    std::vector<std::string> payloads;
+    vss_Signal s{};
+    s.quality = vss_types_QUALITY_VALID;
+    s.header.correlation_id = const_cast<char*>("");
+    for (size_t i = 0; i < count; ++i) {
+        size_t p = i % paths.size();
+        values[p] += drift(gen);
+        s.path = const_cast<char*>(paths[p].c_str());
+        s.header.source_id = const_cast<char*>(sources[p % 3]);
+        s.header.timestamp_ns = 1700000000000000000LL + static_cast<int64_t>(i) * 2000000;
+        s.header.seq_num = static_cast<uint32_t>(i);
+        if (p % 10 == 3) {
+            s.value.type = vss_types_VALUE_TYPE_BOOL;
+            s.value.bool_value = values[p] > 20.0;
+        } else {
+            s.value.type = vss_types_VALUE_TYPE_FLOAT;
+            s.value.float_value = static_cast<float>(values[p]);
+        }
+        std::string payload;
+        if (msgpack) {
+            vdr::sinks::encode_msgpack(s, payload);
+        } else {
+            payload = vdr::sinks::encode_json(s).dump();
+        }
+        payloads.push_back(std::move(payload));
+    }
+    return payloads;
+}
+
+std::vector<std::string> make_batches(const std::vector<std::string>& payloads,
+                                      size_t batch_size) {
+    vdr::sinks::BatchConfig config;
+    config.max_messages = batch_size;
+    config.max_bytes = 1 << 20;
+    vdr::sinks::TopicBatcher batcher(config);
+    std::vector<std::string> batches;
+    auto emit = [&batches](const char*, const char* data, size_t size, size_t) {
+        batches.emplace_back(data, size);
+    };
+    for (const auto& payload : payloads) {
+        batcher.add("vss/signals", payload, 0, emit);
+    }
+    batcher.flush_all(emit);
+    return batches;
+}
+
+std::string train(const std::vector<std::string>& batches) {
+    std::string samples;
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < batches.size(); i += 2) {
+        const auto& batch = batches[i];
+        vdr::sinks::for_each_batch_message(reinterpret_cast<const uint8_t*>(batch.data()),
+                                           batch.size(), [&](std::string_view m) {
+                                               samples.append(m);
+                                               sizes.push_back(m.size());
+                                           });
+    }
+    std::string dictionary(16 * 1024, '\0');
+    size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(),
+                                        sizes.data(), static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(size)) {
+        std::fprintf(stderr, "dictionary training failed: %s\n", ZDICT_getErrorName(size));
+        return {};
+    }
+    dictionary.resize(size);
+    return dictionary;
+}
+
+// Ratio and CPU per MiB on the odd batches; false if a batch does not
+// decompress to its input
+bool measure(const char* label, const std::vector<std::string>& batches,
+             CompressionConfig config, int level) {
+    config.min_bytes = 0;
+    config.levels = {{0, level}};
+    std::string dictionary = config.dictionary;
+    vdr::sinks::BatchCompressor compressor(std::move(config));
+
+    std::string out;
+    std::string restored;
+    size_t raw = 0;
+    size_t compressed = 0;
+    for (size_t i = 1; i < batches.size(); i += 2) {
+        std::string_view sent = compressor.compress(batches[i], out);
+        raw += batches[i].size();
+        compressed += sent.size();
+        if (!vdr::sinks::decompress_batch(reinterpret_cast<const uint8_t*>(sent.data()),
+                                          sent.size(), restored, dictionary) ||
+            restored != batches[i]) {
+            std::fprintf(stderr, "%s: batch %zu does not round-trip\n", label, i);
+            return false;
+        }
+    }
+
+    // Repeat until ~50 ms of CPU for a stable figure
+    size_t rounds = 0;
+    int64_t start = bench::process_cpu_ns();
+    int64_t cpu_ns = 0;
+    size_t sink = 0;
+    do {
+        for (size_t i = 1; i < batches.size(); i += 2) {
+            sink += compressor.compress(batches[i], out).size();
+        }
+        ++rounds;
+        cpu_ns = bench::process_cpu_ns() - start;
+    } while (cpu_ns < 50000000);
+    if (sink == 0) {
+        std::fprintf(stderr, "nothing compressed\n");
+    }
+
+    double mib = static_cast<double>(raw * rounds) / 1048576.0;
+    std::printf("  %-22s level %2d  ratio %5.2fx  %7.2f ms CPU/MiB  (%zu -> %zu B)\n", label,
+                level, static_cast<double>(raw) / static_cast<double>(compressed),
+                static_cast<double>(cpu_ns) / 1e6 / mib, raw, compressed);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t signals = 20000;
+    if (argc > 1) signals = std::strtoul(argv[1], nullptr, 10);
+    if (signals < 1000) {
+        std::fprintf(stderr, "need at least 1000 signals\n");
+        return 1;
+    }
+
+    bool ok = true;
+    for (bool msgpack : {false, true}) {
+        std::vector<std::string> payloads = make_payloads(signals, msgpack);
+        for (size_t batch_size : {10, 100}) {
+            std::vector<std::string> batches = make_batches(payloads, batch_size);
+            std::string dictionary = train(batches);
+            std::printf("%s, %zu signals per batch (dictionary %zu B):\n",
+                        msgpack ? "msgpack" : "json", batch_size, dictionary.size());
+            for (Compression algorithm : {Compression::Zstd, Compression::Lz4}) {
+                if (!vdr::sinks::compression_available(algorithm)) {
+                    continue;
+                }
+                CompressionConfig config;
+                config.algorithm = algorithm;
+                std::string name = vdr::sinks::to_string(algorithm);
+                for (int level : {1, 3, 9}) {
+                    config.dictionary.clear();
+                    ok = measure(name.c_str(), batches, config, level) && ok;
+                    config.dictionary = dictionary;
+                    ok = measure((name + " + dictionary").c_str(), batches, config, level) && ok;
+                }
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
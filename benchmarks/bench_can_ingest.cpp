@@ -0,0 +1,265 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_can_ingest.cpp
+/// @brief AVTP CAN batch ingestion against a loaded CAN-FD bus budget
+///
+/// Reference load: `buses` CAN-FD buses at `fps` frames/s each, every
+/// frame carrying the full 64-byte payload. The default of 10000 frames/s
+/// is above what a bus can carry with 64-byte frames even at an 8 Mbit/s
+/// data phase (roughly 7500/s), so it bounds both the frame and the byte
+/// rate of a fully loaded bus.
+///
+/// Two measurements:
+///   decode: serialized batches collected once from DDS are ingested into
+///           a CanFrameRing and consumed again in a tight loop on one
+///           thread; reports the frame rate one core sustains.
+///   live:   the reference load is published for `seconds` while a
+///           SubscriptionManager ingests rt/avtp/can/batches on its receive
+///           thread and this thread drains the ring; reports frames lost
+///           and process CPU (which includes the publisher).
+///
+/// Usage: bench_can_ingest [buses] [fps] [frames_per_batch] [seconds]
+
+#include "bench_utils.hpp"
+#include "common/dds_wrapper.hpp"
+#include "common/qos_profiles.hpp"
+#include "vdr/can_ingest.hpp"
+#include "vdr/subscriber.hpp"
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct Options {
+    size_t buses = 4;
+    size_t fps = 10000;
+    size_t frames_per_batch = 10;
+    size_t seconds = 5;
+};
+
+/// Reusable AcfCanBatch for one bus, 64-byte CAN-FD frames.
+class BatchBuilder {
+public:
+    BatchBuilder(uint8_t bus, size_t frames)
+        : frames_(frames), payloads_(frames * vdr::CanFrame::kMaxPayload) {
+        batch_.header.source_id = const_cast<char*>("bench_can");
+        batch_.header.correlation_id = const_cast<char*>("");
+        batch_.stream_id = 0xAC00 + bus;
+        batch_.frames._buffer = frames_.data();
+        batch_.frames._length = static_cast<uint32_t>(frames);
+        batch_.frames._maximum = static_cast<uint32_t>(frames);
+
+        for (size_t i = 0; i < frames; ++i) {
+            auto& frame = frames_[i];
+            frame.header.source_id = const_cast<char*>("bench_can");
+            frame.header.correlation_id = const_cast<char*>("");
+            frame.stream_id = batch_.stream_id;
+            frame.bus_id = bus;
+            frame.flags.is_fd = true;
+            frame.flags.is_brs = true;
+            frame.payload._buffer = &payloads_[i * vdr::CanFrame::kMaxPayload];
+            frame.payload._length = vdr::CanFrame::kMaxPayload;
+            frame.payload._maximum = vdr::CanFrame::kMaxPayload;
+        }
+    }
+
+    const telemetry_avtp_AcfCanBatch& next(int64_t now_ns) {
+        batch_.header.timestamp_ns = now_ns;
+        batch_.header.seq_num = seq_;
+        for (auto& frame : frames_) {
+            frame.header.timestamp_ns = now_ns;
+            frame.header.seq_num = seq_;
+            frame.can_id = 0x100 + (seq_ % 0x80);
+            frame.sequence_num = seq_;
+            frame.avtp_timestamp = static_cast<uint64_t>(now_ns);
+            frame.payload._buffer[0] = static_cast<uint8_t>(seq_);
+            ++seq_;
+        }
+        return batch_;
+    }
+
+private:
+    uint32_t seq_ = 0;
+    std::vector<telemetry_avtp_AcfCanFrame> frames_;
+    std::vector<uint8_t> payloads_;
+    telemetry_avtp_AcfCanBatch batch_ = {};
+};
+
+/// Sum of payload bytes, so the consumer touches every frame.
+uint64_t consume(vdr::CanFrameRing& ring) {
+    uint64_t bytes = 0;
+    ring.consume([&bytes](const vdr::CanFrame* frames, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            bytes += frames[i].length + frames[i].data[0];
+        }
+    });
+    return bytes;
+}
+
+void run_decode(dds::Participant& participant, const Options& opts) {
+    size_t batches = opts.buses * 64;
+    auto qos = dds::qos_profiles::reliable_standard(static_cast<int32_t>(batches));
+    dds::Topic topic(participant, &telemetry_avtp_AcfCanBatch_desc, "bench/can/decode",
+                     qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+    std::this_thread::sleep_for(200ms);  // discovery
+
+    std::vector<BatchBuilder> builders;
+    for (size_t bus = 0; bus < opts.buses; ++bus) {
+        builders.emplace_back(static_cast<uint8_t>(bus), opts.frames_per_batch);
+    }
+    for (size_t i = 0; i < batches; ++i) {
+        writer.write(builders[i % opts.buses].next(bench::mono_ns()));
+    }
+    std::this_thread::sleep_for(200ms);
+
+    std::vector<std::vector<uint8_t>> corpus;
+    reader.take_serialized([&corpus](const dds::SerializedSample& sample) {
+        corpus.emplace_back(sample.data, sample.data + sample.size);
+    }, batches);
+    if (corpus.empty()) {
+        std::printf("decode  no batches received\n");
+        return;
+    }
+
+    // Every batch must decode completely before anything is timed
+    vdr::CanFrameRing ring(opts.frames_per_batch * 4);
+    vdr::CanIngest ingest(ring);
+    for (const auto& batch : corpus) {
+        if (ingest.ingest(batch.data(), batch.size()) != opts.frames_per_batch) {
+            std::printf("decode  batch did not decode to %zu frames - layout drift?\n",
+                        opts.frames_per_batch);
+            return;
+        }
+        consume(ring);
+    }
+
+    size_t rounds = 200;
+    uint64_t checksum = 0;
+    size_t n = corpus.size();
+    double ns_per_batch = bench::ns_per_op(n * rounds, [&](size_t i) {
+        const auto& batch = corpus[i % n];
+        ingest.ingest(batch.data(), batch.size());
+        checksum += consume(ring);
+    });
+
+    double ns_per_frame = ns_per_batch / static_cast<double>(opts.frames_per_batch);
+    double sustained = 1e9 / ns_per_frame;
+    double load = static_cast<double>(opts.buses * opts.fps);
+    std::printf("decode  %zu B/batch  %.1f ns/frame  %.2f M frames/s on one core  "
+                "(%zu x %zu fps = %.1f%% of a core)  [%llu]\n",
+                corpus[0].size(), ns_per_frame, sustained / 1e6, opts.buses, opts.fps,
+                100.0 * load / sustained, static_cast<unsigned long long>(checksum % 10));
+}
+
+void run_live(dds::Participant& participant, const Options& opts) {
+    vdr::SubscriptionConfig config;
+    config.can_batches.enabled = true;
+
+    // Room for 100 ms of the reference load
+    vdr::CanFrameRing ring(opts.buses * opts.fps / 10);
+    vdr::CanIngest ingest(ring);
+    vdr::SubscriptionManager subs(participant, config);
+    subs.ingest_can(ingest);
+    subs.start();
+
+    auto qos = vdr::make_qos(config.can_batches.qos);
+    dds::Topic topic(participant, &telemetry_avtp_AcfCanBatch_desc, "rt/avtp/can/batches",
+                     qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    std::this_thread::sleep_for(300ms);  // discovery
+
+    std::vector<BatchBuilder> builders;
+    for (size_t bus = 0; bus < opts.buses; ++bus) {
+        builders.emplace_back(static_cast<uint8_t>(bus), opts.frames_per_batch);
+    }
+
+    // Each bus publishes one batch per period
+    int64_t period_ns = static_cast<int64_t>(1e9 * static_cast<double>(opts.frames_per_batch) /
+                                             static_cast<double>(opts.fps));
+    size_t periods = static_cast<size_t>(static_cast<int64_t>(opts.seconds) * 1000000000LL /
+                                         period_ns);
+    std::atomic<bool> publishing{true};
+    std::thread publisher([&] {
+        int64_t next = bench::mono_ns();
+        for (size_t p = 0; p < periods; ++p) {
+            for (auto& builder : builders) {
+                writer.write(builder.next(next));
+            }
+            next += period_ns;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(next - bench::mono_ns()));
+        }
+        publishing = false;
+    });
+
+    int64_t cpu_start = bench::process_cpu_ns();
+    int64_t wall_start = bench::mono_ns();
+    uint64_t checksum = 0;
+    while (publishing) {
+        std::this_thread::sleep_for(10ms);
+        checksum += consume(ring);
+    }
+    publisher.join();
+    std::this_thread::sleep_for(200ms);
+    checksum += consume(ring);
+    double wall_s = static_cast<double>(bench::mono_ns() - wall_start) / 1e9;
+    double cpu_s = static_cast<double>(bench::process_cpu_ns() - cpu_start) / 1e9;
+    subs.stop();
+
+    auto stats = ingest.stats();
+    size_t expected = periods * opts.buses * opts.frames_per_batch;
+    std::printf("live    %zu frames published, %llu ingested, %llu dropped, %llu malformed  "
+                "process CPU %.1f%% of a core  [%llu]\n",
+                expected, static_cast<unsigned long long>(stats.frames),
+                static_cast<unsigned long long>(stats.dropped),
+                static_cast<unsigned long long>(stats.malformed), 100.0 * cpu_s / wall_s,
+                static_cast<unsigned long long>(checksum % 10));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::InitGoogleLogging(argv[0]);
+    google::SetStderrLogging(google::WARNING);
+
+    Options opts;
+    if (argc > 1) opts.buses = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2) opts.fps = std::strtoul(argv[2], nullptr, 10);
+    if (argc > 3) opts.frames_per_batch = std::strtoul(argv[3], nullptr, 10);
+    if (argc > 4) opts.seconds = std::strtoul(argv[4], nullptr, 10);
+    if (opts.buses == 0 || opts.fps == 0 || opts.frames_per_batch == 0) {
+        std::fprintf(stderr, "buses, fps and frames_per_batch must be positive\n");
+        return 1;
+    }
+
+    std::printf("CAN ingest: %zu buses x %zu frames/s, 64-byte CAN-FD frames, "
+                "%zu frames per batch\n", opts.buses, opts.fps, opts.frames_per_batch);
+
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+    run_decode(participant, opts);
+    run_live(participant, opts);
+
+    google::ShutdownGoogleLogging();
+    return 0;
+}
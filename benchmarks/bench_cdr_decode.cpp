@@ -0,0 +1,233 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_cdr_decode.cpp
+/// @brief CDR view decoders vs the idlc-generated deserializer
+///
+/// Serialized samples are collected once through take_serialized() and
+/// held as serdata, as the reader cache would hold them. The timed loops
+/// then compare what a take costs per sample:
+///   idlc:  ddsi_serdata_to_sample() into the C struct (mallocs every
+///          string and sequence) plus freeing it again
+///   view:  ddsi_serdata_to_ser_ref() and vdr::decode() into a view
+/// Before timing, every sample is decoded both ways and compared.
+///
+/// Usage: bench_cdr_decode [samples] [rounds]
+
+#include "bench_utils.hpp"
+#include "common/dds_wrapper.hpp"
+#include "common/qos_profiles.hpp"
+#include "vdr/cdr_views.hpp"
+
+#include <dds/ddsi/ddsi_serdata.h>
+#include <glog/logging.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+bool same(std::string_view view, const char* str) {
+    return view == (str ? std::string_view(str) : std::string_view());
+}
+
+bool same(const vdr::HeaderView& view, const vss_types_Header& header) {
+    return same(view.source_id, header.source_id) &&
+           view.timestamp_ns == header.timestamp_ns &&
+           view.seq_num == header.seq_num &&
+           same(view.correlation_id, header.correlation_id);
+}
+
+bool same(const vdr::SignalView& view, const vss_Signal& msg) {
+    return same(view.path, msg.path) && same(view.header, msg.header) &&
+           view.quality == msg.quality && view.value.type == msg.value.type &&
+           view.value.double_value == msg.value.double_value &&
+           same(view.value.string_value, msg.value.string_value);
+}
+
+bool same(const vdr::MetricView& view, const telemetry_metrics_Gauge& msg) {
+    if (!same(view.name, msg.name) || !same(view.header, msg.header) ||
+        view.value != msg.value || view.labels.size() != msg.labels._length) {
+        return false;
+    }
+    uint32_t i = 0;
+    for (const auto& label : view.labels) {
+        const auto& kv = msg.labels._buffer[i++];
+        if (!same(label.key, kv.key) || !same(label.value, kv.value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Serialized samples of one topic, held as serdata.
+struct Corpus {
+    const ddsi_sertype* sertype = nullptr;
+    std::vector<ddsi_serdata*> serdata;
+    size_t bytes = 0;
+
+    ~Corpus() {
+        for (auto* sd : serdata) {
+            ddsi_serdata_unref(sd);
+        }
+    }
+};
+
+template<typename T, typename Make>
+void collect(dds::Participant& participant, const dds_topic_descriptor_t* desc,
+             const char* name, size_t samples, Make&& make, Corpus& corpus) {
+    auto qos = dds::qos_profiles::reliable_standard(static_cast<int32_t>(samples));
+    dds::Topic topic(participant, desc, name, qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+    std::this_thread::sleep_for(200ms);  // discovery
+
+    for (size_t i = 0; i < samples; ++i) {
+        make(i, [&writer](const T& msg) { writer.write(msg); });
+    }
+    std::this_thread::sleep_for(200ms);
+
+    dds_return_t rc = dds_get_entity_sertype(topic.get(), &corpus.sertype);
+    if (rc != DDS_RETCODE_OK) {
+        throw dds::Error(rc, "dds_get_entity_sertype");
+    }
+
+    // Rebuild serdata from the received bytes: the reader would hold these
+    reader.take_serialized([&](const dds::SerializedSample& sample) {
+        ddsrt_iovec_t iov;
+        iov.iov_base = const_cast<uint8_t*>(sample.data);
+        iov.iov_len = static_cast<decltype(iov.iov_len)>(sample.size);
+        corpus.serdata.push_back(
+            ddsi_serdata_from_ser_iov(corpus.sertype, SDK_DATA, 1, &iov, sample.size));
+        corpus.bytes += sample.size;
+    }, samples);
+}
+
+template<typename T, typename View>
+void run(const char* label, const Corpus& corpus, size_t rounds) {
+    size_t n = corpus.serdata.size();
+    if (n == 0) {
+        std::printf("%-10s no samples received\n", label);
+        return;
+    }
+
+    auto with_view = [](ddsi_serdata* sd, View& view) {
+        ddsrt_iovec_t ref;
+        ddsi_serdata* held = ddsi_serdata_to_ser_ref(sd, 0, ddsi_serdata_size(sd), &ref);
+        bool ok = vdr::decode(static_cast<const uint8_t*>(ref.iov_base), ref.iov_len, view);
+        ddsi_serdata_to_ser_unref(held, &ref);
+        return ok;
+    };
+
+    // Cross-check both paths before timing anything
+    size_t mismatches = 0;
+    for (auto* sd : corpus.serdata) {
+        T sample{};
+        ddsi_serdata_to_sample(sd, &sample, nullptr, nullptr);
+        View view;
+        if (!with_view(sd, view) || !same(view, sample)) {
+            ++mismatches;
+        }
+        ddsi_sertype_free_sample(corpus.sertype, &sample, DDS_FREE_CONTENTS);
+    }
+    if (mismatches > 0) {
+        std::printf("%-10s %zu/%zu samples decode differently - layout drift?\n",
+                    label, mismatches, n);
+        return;
+    }
+
+    double checksum = 0.0;
+    double idlc_ns = bench::ns_per_op(n * rounds, [&](size_t i) {
+        T sample{};
+        ddsi_serdata_to_sample(corpus.serdata[i % n], &sample, nullptr, nullptr);
+        checksum += static_cast<double>(sample.header.seq_num);
+        ddsi_sertype_free_sample(corpus.sertype, &sample, DDS_FREE_CONTENTS);
+    });
+
+    double view_ns = bench::ns_per_op(n * rounds, [&](size_t i) {
+        View view;
+        with_view(corpus.serdata[i % n], view);
+        checksum += static_cast<double>(view.header.seq_num);
+    });
+
+    std::printf("%-10s %6zu B/sample  idlc %8.1f ns  view %8.1f ns  (x%.1f)  [%.0f]\n",
+                label, corpus.bytes / n, idlc_ns, view_ns, idlc_ns / view_ns,
+                std::fmod(checksum, 10.0));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::InitGoogleLogging(argv[0]);
+    google::SetStderrLogging(google::WARNING);
+
+    size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+
+    std::printf("CDR decode: %zu distinct samples x %zu rounds\n", samples, rounds);
+
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < samples; ++i) {
+        paths.push_back("Vehicle.Powertrain.TractionBattery.Cell" + std::to_string(i) + ".Voltage");
+    }
+
+    Corpus signals;
+    collect<vss_Signal>(participant, &vss_Signal_desc, "bench/cdr/signals", samples,
+        [&](size_t i, auto&& write) {
+            vss_Signal msg = {};
+            msg.path = const_cast<char*>(paths[i].c_str());
+            msg.header.source_id = const_cast<char*>("bench_probe");
+            msg.header.timestamp_ns = static_cast<int64_t>(i) * 1000;
+            msg.header.seq_num = static_cast<uint32_t>(i);
+            msg.header.correlation_id = const_cast<char*>("");
+            msg.quality = vss_types_QUALITY_VALID;
+            msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+            msg.value.double_value = 3.7 + static_cast<double>(i % 100) / 1000.0;
+            write(msg);
+        }, signals);
+    run<vss_Signal, vdr::SignalView>("signal", signals, rounds);
+
+    Corpus gauges;
+    collect<telemetry_metrics_Gauge>(participant, &telemetry_metrics_Gauge_desc,
+        "bench/cdr/gauges", samples,
+        [&](size_t i, auto&& write) {
+            vss_types_KeyValue labels[] = {
+                {const_cast<char*>("ecu"), const_cast<char*>("central")},
+                {const_cast<char*>("core"), const_cast<char*>("0")},
+                {const_cast<char*>("unit"), const_cast<char*>("percent")},
+            };
+            telemetry_metrics_Gauge msg = {};
+            msg.name = const_cast<char*>(paths[i].c_str());
+            msg.header.source_id = const_cast<char*>("bench_probe");
+            msg.header.seq_num = static_cast<uint32_t>(i);
+            msg.header.correlation_id = const_cast<char*>("");
+            msg.labels._buffer = labels;
+            msg.labels._length = 3;
+            msg.labels._maximum = 3;
+            msg.value = static_cast<double>(i);
+            write(msg);
+        }, gauges);
+    run<telemetry_metrics_Gauge, vdr::MetricView>("gauge", gauges, rounds);
+
+    google::ShutdownGoogleLogging();
+    return 0;
+}
@@ -0,0 +1,147 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_dispatch_latency.cpp
+/// @brief Probe-to-callback latency of the VDR receive path
+///
+/// Compares the legacy "drain every reader, sleep 10 ms" loop with the
+/// SubscriptionManager in waitset and listener dispatch modes. Reports end-to-end latency
+/// (header timestamp to callback) and the CPU burnt while the bus is idle.
+///
+/// Usage: bench_dispatch_latency [samples] [interval_us]
+
+#include "bench_utils.hpp"
+#include "common/qos_profiles.hpp"
+#include "common/time_utils.hpp"
+#include "testing/test_probe.hpp"
+#include "vdr/subscriber.hpp"
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct Options {
+    size_t samples = 2000;
+    std::chrono::microseconds interval{1000};
+};
+
+/// Receiver under test: started, fed by the probe, then stopped.
+struct Receiver {
+    std::function<void()> start;
+    std::function<void()> stop;
+};
+
+void run(const std::string& label, const Options& opts,
+         const std::function<Receiver(bench::LatencyRecorder&)>& make) {
+    bench::LatencyRecorder latency;
+    Receiver receiver = make(latency);
+    receiver.start();
+
+    vdr::testing::TestProbe probe("bench_probe");
+    probe.start();
+    std::this_thread::sleep_for(300ms);  // discovery
+
+    // Idle CPU: receiver running, nothing published
+    int64_t cpu_start = bench::process_cpu_ns();
+    std::this_thread::sleep_for(1s);
+    double idle_cpu_pct = static_cast<double>(bench::process_cpu_ns() - cpu_start) / 1e7;
+
+    for (size_t i = 0; i < opts.samples; ++i) {
+        probe.send_signal("Vehicle.Speed", static_cast<double>(i));
+        std::this_thread::sleep_for(opts.interval);
+    }
+    std::this_thread::sleep_for(200ms);
+
+    probe.stop();
+    receiver.stop();
+
+    latency.print(label);
+    std::printf("%-24s idle CPU %.2f%%\n", "", idle_cpu_pct);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::InitGoogleLogging(argv[0]);
+    google::SetStderrLogging(google::WARNING);
+
+    Options opts;
+    if (argc > 1) opts.samples = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2) opts.interval = std::chrono::microseconds(std::strtoul(argv[2], nullptr, 10));
+
+    std::printf("Dispatch latency: %zu samples, %lld us apart\n",
+                opts.samples, static_cast<long long>(opts.interval.count()));
+
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    // Legacy loop: drain the reader, then sleep 10 ms
+    run("poll+sleep(10ms)", opts, [&](bench::LatencyRecorder& latency) {
+        auto qos = dds::qos_profiles::reliable_standard(100);
+        auto topic = std::make_shared<dds::Topic>(participant, &vss_Signal_desc,
+                                                  "rt/vss/signals", qos.get());
+        auto reader = std::make_shared<dds::Reader>(participant, *topic, qos.get());
+        auto running = std::make_shared<std::atomic<bool>>(false);
+        auto thread = std::make_shared<std::thread>();
+
+        Receiver r;
+        r.start = [=, &latency] {
+            *running = true;
+            *thread = std::thread([=, &latency] {
+                while (*running) {
+                    reader->take_each<vss_Signal>([&](const vss_Signal& msg) {
+                        latency.record(utils::now_ns() - msg.header.timestamp_ns);
+                    });
+                    std::this_thread::sleep_for(10ms);
+                }
+            });
+        };
+        r.stop = [=] {
+            *running = false;
+            thread->join();
+            (void)topic;
+        };
+        return r;
+    });
+
+    // Event-driven SubscriptionManager, one run per dispatch mode
+    auto subscription = [&](vdr::Dispatch dispatch) {
+        return [&participant, dispatch](bench::LatencyRecorder& latency) {
+            vdr::SubscriptionConfig config;
+            config.vss_signals.dispatch = dispatch;
+            auto subs = std::make_shared<vdr::SubscriptionManager>(participant, config);
+            subs->subscribe(vdr::bind<vss_Signal>(config.vss_signals,
+                [&latency](const vss_Signal& msg) {
+                    latency.record(utils::now_ns() - msg.header.timestamp_ns);
+                }));
+
+            Receiver r;
+            r.start = [subs] { subs->start(); };
+            r.stop = [subs] { subs->stop(); };
+            return r;
+        };
+    };
+    run("waitset", opts, subscription(vdr::Dispatch::Waitset));
+    run("listener", opts, subscription(vdr::Dispatch::Listener));
+
+    google::ShutdownGoogleLogging();
+    return 0;
+}
@@ -0,0 +1,223 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_mpsc_ring.cpp
+/// @brief MqttSink publish queue: mutex + std::queue vs utils::MpscRing
+///
+/// `producers` threads each enqueue `messages` JSON-sized payloads in
+/// batches of `batch` (one send_batch() of a take), while one consumer
+/// drains them, as publish_loop does. Compared:
+///   mutex: the previous queue - a std::queue of two std::strings under a
+///          mutex, a condition variable notified per message
+///   ring:  utils::MpscRing with preallocated payload slots, one notify()
+///          per batch
+/// Producers retry on a full queue, so both move every message; reported
+/// are throughput, producer-side ns per message and full-queue retries.
+///
+/// Usage: bench_mpsc_ring [producers] [messages] [batch] [payload_bytes]
+
+#include "bench_utils.hpp"
+#include "common/mpsc_ring.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr size_t kCapacity = 16384;
+
+struct Options {
+    size_t producers = 2;
+    size_t messages = 500000;
+    size_t batch = 64;
+    size_t payload_bytes = 200;
+};
+
+struct Result {
+    double seconds = 0.0;
+    double producer_ns = 0.0;  // per message, averaged over producers
+    uint64_t retries = 0;
+    uint64_t consumed = 0;
+};
+
+/// The queue MqttSink used before: heap strings, a lock and a wake-up per message.
+class MutexQueue {
+public:
+    struct Message {
+        std::string topic;
+        std::string payload;
+    };
+
+    bool push(const char* topic, const std::string& payload) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.size() >= kCapacity) {
+                return false;
+            }
+            queue_.push({std::string("vdr/v1/") + topic, payload});
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    void notify() {}
+
+    template<typename Fn>
+    size_t consume(Fn&& fn) {
+        Message msg;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!cv_.wait_for(lock, 100ms, [this] { return !queue_.empty(); })) {
+                return 0;
+            }
+            msg = std::move(queue_.front());
+            queue_.pop();
+        }
+        fn(msg.payload.size());
+        return 1;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::queue<Message> queue_;
+};
+
+class RingQueue {
+public:
+    struct Slot {
+        const char* topic = nullptr;
+        std::string payload;
+    };
+
+    explicit RingQueue(size_t reserve)
+        : ring_(kCapacity, [reserve](Slot& slot) { slot.payload.reserve(reserve); }) {}
+
+    bool push(const char* topic, const std::string& payload) {
+        return ring_.try_push([&](Slot& slot) {
+            slot.topic = topic;
+            slot.payload.assign(payload);
+        });
+    }
+
+    void notify() { ring_.notify(); }
+
+    template<typename Fn>
+    size_t consume(Fn&& fn) {
+        size_t count = ring_.consume([&](Slot& slot) { fn(slot.payload.size()); }, 256);
+        if (count == 0) {
+            ring_.wait_for(100ms);
+        }
+        return count;
+    }
+
+private:
+    utils::MpscRing<Slot> ring_;
+};
+
+template<typename Queue>
+Result run(Queue& queue, const Options& options) {
+    const std::string payload(options.payload_bytes, 'x');
+    const uint64_t total = options.producers * options.messages;
+
+    std::atomic<uint64_t> consumed{0};
+    std::atomic<uint64_t> retries{0};
+    std::atomic<int64_t> producer_ns{0};
+    uint64_t bytes = 0;
+
+    int64_t start = bench::mono_ns();
+    std::thread consumer([&] {
+        uint64_t count = 0;
+        while (count < total) {
+            count += queue.consume([&](size_t size) { bytes += size; });
+        }
+        consumed = count;
+    });
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < options.producers; ++p) {
+        producers.emplace_back([&] {
+            uint64_t local_retries = 0;
+            int64_t begin = bench::mono_ns();
+            for (size_t sent = 0; sent < options.messages;) {
+                size_t end = std::min(sent + options.batch, options.messages);
+                for (; sent < end; ++sent) {
+                    while (!queue.push("vss/signals", payload)) {
+                        ++local_retries;
+                        queue.notify();
+                        std::this_thread::yield();
+                    }
+                }
+                queue.notify();
+            }
+            producer_ns += bench::mono_ns() - begin;
+            retries += local_retries;
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    Result result;
+    result.seconds = static_cast<double>(bench::mono_ns() - start) / 1e9;
+    result.producer_ns = static_cast<double>(producer_ns.load()) / static_cast<double>(total);
+    result.retries = retries;
+    result.consumed = consumed;
+    if (bytes != total * options.payload_bytes) {
+        std::fprintf(stderr, "payload bytes mismatch\n");
+    }
+    return result;
+}
+
+void print(const char* label, const Result& result) {
+    std::printf("%-6s %8.2f Mmsg/s  producer %7.1f ns/msg  full-queue retries %llu\n", label,
+                static_cast<double>(result.consumed) / result.seconds / 1e6, result.producer_ns,
+                static_cast<unsigned long long>(result.retries));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (argc > 1) options.producers = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2) options.messages = std::strtoul(argv[2], nullptr, 10);
+    if (argc > 3) options.batch = std::strtoul(argv[3], nullptr, 10);
+    if (argc > 4) options.payload_bytes = std::strtoul(argv[4], nullptr, 10);
+    if (options.producers == 0 || options.batch == 0) {
+        std::fprintf(stderr, "producers and batch must be positive\n");
+        return 1;
+    }
+
+    std::printf("%zu producers x %zu messages, batches of %zu, %zu-byte payloads, "
+                "capacity %zu\n", options.producers, options.messages, options.batch,
+                options.payload_bytes, kCapacity);
+
+    MutexQueue mutex_queue;
+    print("mutex", run(mutex_queue, options));
+
+    RingQueue ring_queue(options.payload_bytes);
+    print("ring", run(ring_queue, options));
+    return 0;
+}
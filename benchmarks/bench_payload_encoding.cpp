@@ -0,0 +1,248 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_payload_encoding.cpp
+/// @brief JSON vs MessagePack vs Protobuf payloads: bytes and CPU per message
+///
+/// Encodes a fixed mix of representative messages - VSS signals of the
+/// common scalar types, gauges and counters with labels, log entries with
+/// fields, events with attributes and a context snapshot, security
+/// incidents with raw evidence - the way MqttSink does for each format:
+///   json:     encode_json() builds the document, dump() serializes it
+///   msgpack:  encode_msgpack() appends to a cleared, reused buffer
+///   protobuf: encode_protobuf() builds the message on the thread arena
+///             (events and incidents only)
+/// Reported per message type and format are bytes per message, bytes per
+/// 10 messages (the unit of SPECIFICATION.md's size table), ns per message
+/// and size and speed relative to JSON. Note that JSON reduces an event's
+/// context to a count while the binary formats carry every signal.
+///
+/// Usage: bench_payload_encoding [iterations]
+
+#include "bench_utils.hpp"
+#include "vdr/sinks/json_encoder.hpp"
+#include "vdr/sinks/msgpack_encoder.hpp"
+#include "vdr/sinks/protobuf_encoder.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+char* str(const char* s) {
+    return const_cast<char*>(s);
+}
+
+vss_types_Header header(uint32_t seq) {
+    vss_types_Header h{};
+    h.source_id = str("can_probe");
+    h.timestamp_ns = 1700000000000000000LL + seq * 10000000LL;
+    h.seq_num = seq;
+    h.correlation_id = str("");
+    return h;
+}
+
+std::vector<vss_Signal> make_signals() {
+    const char* paths[] = {"Vehicle.Speed",
+                           "Vehicle.Powertrain.TractionBattery.StateOfCharge.Current",
+                           "Vehicle.Chassis.SteeringWheel.Angle",
+                           "Vehicle.Body.Lights.Brake.IsActive",
+                           "Vehicle.Powertrain.ElectricMotor.Temperature"};
+    std::vector<vss_Signal> signals;
+    for (uint32_t i = 0; i < 10; ++i) {
+        vss_Signal s{};
+        s.path = str(paths[i % 5]);
+        s.header = header(i);
+        s.quality = vss_types_QUALITY_VALID;
+        switch (i % 5) {
+            case 0: s.value.type = vss_types_VALUE_TYPE_FLOAT; s.value.float_value = 87.5f; break;
+            case 1: s.value.type = vss_types_VALUE_TYPE_DOUBLE; s.value.double_value = 71.25; break;
+            case 2: s.value.type = vss_types_VALUE_TYPE_INT16; s.value.int16_value = -120; break;
+            case 3: s.value.type = vss_types_VALUE_TYPE_BOOL; s.value.bool_value = true; break;
+            default: s.value.type = vss_types_VALUE_TYPE_INT32; s.value.int32_value = 64; break;
+        }
+        signals.push_back(s);
+    }
+    return signals;
+}
+
+vss_types_KeyValue kLabels[] = {{str("ecu"), str("bms")}, {str("bus"), str("can0")}};
+
+std::vector<telemetry_metrics_Gauge> make_gauges() {
+    std::vector<telemetry_metrics_Gauge> gauges;
+    for (uint32_t i = 0; i < 10; ++i) {
+        telemetry_metrics_Gauge g{};
+        g.name = str(i % 2 ? "pack_voltage" : "cell_temperature_max");
+        g.header = header(i);
+        g.labels._buffer = kLabels;
+        g.labels._length = 2;
+        g.value = 398.25 + i;
+        gauges.push_back(g);
+    }
+    return gauges;
+}
+
+std::vector<telemetry_metrics_Counter> make_counters() {
+    std::vector<telemetry_metrics_Counter> counters;
+    for (uint32_t i = 0; i < 10; ++i) {
+        telemetry_metrics_Counter c{};
+        c.name = str("can_frames_total");
+        c.header = header(i);
+        c.labels._buffer = kLabels;
+        c.labels._length = 2;
+        c.value = 1.0e6 + i;
+        counters.push_back(c);
+    }
+    return counters;
+}
+
+vss_types_KeyValue kFields[] = {{str("dtc"), str("P0A80")}, {str("retry"), str("3")}};
+
+std::vector<telemetry_logs_LogEntry> make_logs() {
+    std::vector<telemetry_logs_LogEntry> logs;
+    for (uint32_t i = 0; i < 10; ++i) {
+        telemetry_logs_LogEntry l{};
+        l.header = header(i);
+        l.level = telemetry_logs_LEVEL_WARN;
+        l.component = str("battery_monitor");
+        l.message = str("Cell voltage deviation above threshold");
+        l.fields._buffer = kFields;
+        l.fields._length = 2;
+        logs.push_back(l);
+    }
+    return logs;
+}
+
+std::vector<telemetry_events_Event> make_events(std::vector<vss_Signal>& context) {
+    static vss_types_KeyValue attributes[] = {{str("decel_g"), str("0.92")},
+                                              {str("abs_active"), str("true")},
+                                              {str("trigger"), str("brake_pressure")}};
+    std::vector<telemetry_events_Event> events;
+    for (uint32_t i = 0; i < 10; ++i) {
+        telemetry_events_Event e{};
+        e.event_id = str("9f1c2d3e-5b6a-4c7d-8e9f-0a1b2c3d4e5f");
+        e.header = header(i);
+        e.category = str("ADAS");
+        e.event_type = str("harsh_brake");
+        e.severity = telemetry_events_SEVERITY_WARNING;
+        e.attributes._buffer = attributes;
+        e.attributes._length = 3;
+        e.context._buffer = context.data();
+        e.context._length = static_cast<uint32_t>(context.size());
+        events.push_back(e);
+    }
+    return events;
+}
+
+std::vector<telemetry_security_Incident> make_incidents() {
+    static vss_types_KeyValue indicators[] = {{str("can_id"), str("0x7df")},
+                                              {str("bus"), str("can1")},
+                                              {str("rate_hz"), str("950")}};
+    static uint8_t evidence[64] = {};
+    for (size_t i = 0; i < sizeof(evidence); ++i) {
+        evidence[i] = static_cast<uint8_t>(i * 37);
+    }
+    std::vector<telemetry_security_Incident> incidents;
+    for (uint32_t i = 0; i < 10; ++i) {
+        telemetry_security_Incident inc{};
+        inc.incident_id = str("inc-000042");
+        inc.header = header(i);
+        inc.threat_level = telemetry_security_THREAT_LEVEL_HIGH;
+        inc.incident_type = str("can_flood");
+        inc.description = str("Diagnostic request rate above policy on can1");
+        inc.indicators._buffer = indicators;
+        inc.indicators._length = 3;
+        inc.raw_evidence._buffer = evidence;
+        inc.raw_evidence._length = sizeof(evidence);
+        incidents.push_back(inc);
+    }
+    return incidents;
+}
+
+struct Measurement {
+    double bytes = 0.0;  // per message
+    double ns = 0.0;     // per message
+};
+
+template<typename T, typename Encode>
+Measurement measure(const std::vector<T>& msgs, size_t iterations, Encode&& encode) {
+    std::string buffer;
+    size_t bytes = 0;
+    for (const T& msg : msgs) {
+        buffer.clear();
+        encode(msg, buffer);
+        bytes += buffer.size();
+    }
+
+    size_t sink = 0;
+    size_t n = msgs.size();
+    Measurement m;
+    m.ns = bench::ns_per_op(iterations * n, [&](size_t i) {
+        buffer.clear();
+        encode(msgs[i % n], buffer);
+        sink += buffer.size();
+    });
+    m.bytes = static_cast<double>(bytes) / static_cast<double>(n);
+    if (sink == 0) {
+        std::fprintf(stderr, "nothing encoded\n");
+    }
+    return m;
+}
+
+void print(const char* label, const char* format, const Measurement& m, const Measurement& json) {
+    std::printf("%-10s %-8s %7.1f B/msg %6.0f B/10 %8.1f ns/msg  %4.1fx smaller %5.1fx faster\n",
+                label, format, m.bytes, m.bytes * 10.0, m.ns, json.bytes / m.bytes,
+                json.ns / m.ns);
+}
+
+auto json = [](const auto& msg, std::string& out) { out = vdr::sinks::encode_json(msg).dump(); };
+auto msgpack = [](const auto& msg, std::string& out) { vdr::sinks::encode_msgpack(msg, out); };
+auto protobuf = [](const auto& msg, std::string& out) { vdr::sinks::encode_protobuf(msg, out); };
+
+template<typename T>
+void compare(const char* label, const std::vector<T>& msgs, size_t iterations) {
+    Measurement j = measure(msgs, iterations, json);
+    print(label, "json", j, j);
+    print(label, "msgpack", measure(msgs, iterations, msgpack), j);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = 20000;
+    if (argc > 1) iterations = std::strtoul(argv[1], nullptr, 10);
+    if (iterations == 0) {
+        std::fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    compare("signals", make_signals(), iterations);
+    compare("gauges", make_gauges(), iterations);
+    compare("counters", make_counters(), iterations);
+    compare("logs", make_logs(), iterations);
+
+    std::vector<vss_Signal> context = make_signals();
+    auto events = make_events(context);
+    compare("events", events, iterations);
+    print("events", "protobuf", measure(events, iterations, protobuf),
+          measure(events, iterations, json));
+
+    auto incidents = make_incidents();
+    Measurement j = measure(incidents, iterations, json);
+    print("incidents", "json", j, j);
+    print("incidents", "protobuf", measure(incidents, iterations, protobuf), j);
+    return 0;
+}
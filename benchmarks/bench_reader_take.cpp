@@ -0,0 +1,179 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_reader_take.cpp
+/// @brief Heap allocations and time per take on the reader hot path
+///
+/// Compares the original take_each (fresh loan arrays per call) with the
+/// reader-owned loan arrays behind take_loan/take_each. Allocations are
+/// counted by replacing global operator new, so only C++ heap traffic in
+/// the wrapper and the caller is visible; Cyclone's own malloc use is not.
+///
+/// Usage: bench_reader_take [iterations] [batch]
+
+#include "bench_utils.hpp"
+#include "common/dds_wrapper.hpp"
+#include "common/qos_profiles.hpp"
+#include "common/time_utils.hpp"
+
+#include "vss_signal.h"
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+namespace {
+
+std::atomic<size_t> g_allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// take_each as it was before the reader kept its loan arrays.
+template<typename T, typename Callback>
+size_t legacy_take_each(dds::Reader& reader, Callback&& callback, size_t max_samples) {
+    std::vector<void*> samples(max_samples, nullptr);
+    std::vector<dds_sample_info_t> infos(max_samples);
+
+    dds_return_t count = dds_take(reader.get(), samples.data(), infos.data(),
+                                  max_samples, static_cast<uint32_t>(max_samples));
+    if (count < 0) {
+        throw dds::Error(count, "dds_take");
+    }
+
+    size_t valid_count = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        if (infos[i].valid_data && samples[i] != nullptr) {
+            callback(*static_cast<T*>(samples[i]));
+            ++valid_count;
+        }
+    }
+    dds_return_loan(reader.get(), samples.data(), count);
+    return valid_count;
+}
+
+struct Result {
+    double ns_per_take = 0.0;
+    double allocs_per_take = 0.0;
+    size_t samples = 0;
+};
+
+/// Publish `batch` samples, then time a single take; repeat `iterations` times.
+template<typename TakeFn>
+Result measure(dds::Writer& writer, dds::Reader& reader, size_t iterations,
+               size_t batch, TakeFn&& take) {
+    vss_Signal msg = {};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("bench");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+
+    // Warm-up grows the reader-owned arrays to their steady-state size
+    writer.write(msg);
+    std::this_thread::sleep_for(10ms);
+    take(reader, batch);
+
+    Result result;
+    int64_t total_ns = 0;
+    size_t total_allocs = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        for (size_t j = 0; j < batch; ++j) {
+            msg.header.seq_num = static_cast<uint32_t>(j);
+            msg.value.double_value = static_cast<double>(j);
+            writer.write(msg);
+        }
+
+        size_t allocs_before = g_allocations.load(std::memory_order_relaxed);
+        int64_t start = bench::mono_ns();
+        result.samples += take(reader, batch);
+        total_ns += bench::mono_ns() - start;
+        total_allocs += g_allocations.load(std::memory_order_relaxed) - allocs_before;
+    }
+
+    result.ns_per_take = static_cast<double>(total_ns) / static_cast<double>(iterations);
+    result.allocs_per_take = static_cast<double>(total_allocs) / static_cast<double>(iterations);
+    return result;
+}
+
+void print(const char* label, const Result& r) {
+    std::printf("%-24s %10.1f ns/take %8.2f allocs/take  (%zu samples)\n",
+                label, r.ns_per_take, r.allocs_per_take, r.samples);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::InitGoogleLogging(argv[0]);
+    google::SetStderrLogging(google::WARNING);
+
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    size_t batch = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    std::printf("Reader take: %zu iterations, %zu samples per take\n", iterations, batch);
+
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+    auto qos = dds::qos_profiles::reliable_standard(static_cast<int32_t>(batch));
+    dds::Topic topic(participant, &vss_Signal_desc, "bench/reader_take", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+    std::this_thread::sleep_for(200ms);  // discovery
+
+    double sink = 0.0;
+    auto consume = [&sink](const vss_Signal& s) { sink += s.value.double_value; };
+
+    print("legacy take_each", measure(writer, reader, iterations, batch,
+        [&](dds::Reader& r, size_t max) {
+            return legacy_take_each<vss_Signal>(r, consume, max);
+        }));
+
+    print("take_each", measure(writer, reader, iterations, batch,
+        [&](dds::Reader& r, size_t max) {
+            return r.take_each<vss_Signal>(consume, max);
+        }));
+
+    print("take_loan", measure(writer, reader, iterations, batch,
+        [&](dds::Reader& r, size_t max) {
+            size_t n = 0;
+            for (auto sample : r.take_loan<vss_Signal>(max)) {
+                if (sample.valid()) {
+                    consume(sample.data);
+                    ++n;
+                }
+            }
+            return n;
+        }));
+
+    std::printf("(checksum %.0f)\n", sink);
+
+    google::ShutdownGoogleLogging();
+    return 0;
+}
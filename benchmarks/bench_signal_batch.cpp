@@ -0,0 +1,186 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_signal_batch.cpp
+/// @brief EncodedSignalBatch round trip: bytes per 10 signals, encode and decode CPU
+///
+/// Encodes batches of VSS signals (ten distinct paths of the common scalar
+/// types from two sources, 10 ms apart) with SignalBatchEncoder and
+/// decodes them with the standalone SignalBatchDecoder. Every decoded
+/// signal is first checked against its input; a mismatch fails the run.
+/// The session's dictionary frame is sent once and reported separately;
+/// the timed loop is the steady state, where batches reuse known ids.
+/// For reference the same signals are encoded as per-message MessagePack
+/// and JSON, the way MqttSink publishes them without batch coding.
+///
+/// Usage: bench_signal_batch [iterations]
+
+#include "bench_utils.hpp"
+#include "codec/signal_batch_decoder.hpp"
+#include "vdr/sinks/json_encoder.hpp"
+#include "vdr/sinks/msgpack_encoder.hpp"
+#include "vdr/sinks/signal_batch_encoder.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using vdr::codec::DecodedSignal;
+using vdr::codec::DecodeStatus;
+
+char* str(const char* s) {
+    return const_cast<char*>(s);
+}
+
+std::vector<vss_Signal> make_signals(size_t count) {
+    const char* paths[] = {"Vehicle.Speed",
+                           "Vehicle.Powertrain.TractionBattery.StateOfCharge.Current",
+                           "Vehicle.Chassis.SteeringWheel.Angle",
+                           "Vehicle.Body.Lights.Brake.IsActive",
+                           "Vehicle.Powertrain.ElectricMotor.Temperature",
+                           "Vehicle.Acceleration.Longitudinal",
+                           "Vehicle.Powertrain.TractionBattery.CurrentVoltage",
+                           "Vehicle.Chassis.Accelerator.PedalPosition",
+                           "Vehicle.ADAS.ABS.IsEngaged",
+                           "Vehicle.Powertrain.Transmission.CurrentGear"};
+    std::vector<vss_Signal> signals;
+    for (uint32_t i = 0; i < count; ++i) {
+        vss_Signal s{};
+        s.path = str(paths[i % 10]);
+        s.header.source_id = str(i % 10 < 7 ? "can_probe" : "adas_probe");
+        s.header.timestamp_ns = 1700000000000000000LL + i * 10000000LL + (i * 7919) % 1000;
+        s.header.seq_num = i;
+        s.header.correlation_id = str("");
+        s.quality = vss_types_QUALITY_VALID;
+        switch (i % 5) {
+            case 0: s.value.type = vss_types_VALUE_TYPE_FLOAT; s.value.float_value = 87.5f; break;
+            case 1: s.value.type = vss_types_VALUE_TYPE_DOUBLE; s.value.double_value = 71.25; break;
+            case 2: s.value.type = vss_types_VALUE_TYPE_INT16; s.value.int16_value = -120; break;
+            case 3: s.value.type = vss_types_VALUE_TYPE_BOOL; s.value.bool_value = true; break;
+            default: s.value.type = vss_types_VALUE_TYPE_INT32; s.value.int32_value = 64; break;
+        }
+        signals.push_back(s);
+    }
+    return signals;
+}
+
+double scalar(const vss_types_Value& v) {
+    switch (v.type) {
+        case vss_types_VALUE_TYPE_FLOAT: return v.float_value;
+        case vss_types_VALUE_TYPE_DOUBLE: return v.double_value;
+        case vss_types_VALUE_TYPE_INT16: return v.int16_value;
+        case vss_types_VALUE_TYPE_BOOL: return v.bool_value;
+        case vss_types_VALUE_TYPE_INT32: return v.int32_value;
+        default: return NAN;
+    }
+}
+
+double scalar(const vdr::codec::DecodedValue& v) {
+    switch (v.type) {
+        case vdr::codec::ValueType::Float:
+        case vdr::codec::ValueType::Double: return v.double_value;
+        case vdr::codec::ValueType::Int16:
+        case vdr::codec::ValueType::Int32: return static_cast<double>(v.int_value);
+        case vdr::codec::ValueType::Bool: return v.bool_value;
+        default: return NAN;
+    }
+}
+
+bool same(const vss_Signal& in, const DecodedSignal& out) {
+    return out.path == in.path && out.source_id == in.header.source_id &&
+           out.timestamp_ns == in.header.timestamp_ns &&
+           out.quality == static_cast<uint8_t>(in.quality) &&
+           static_cast<int>(out.value.type) == in.value.type &&
+           scalar(out.value) == scalar(in.value);
+}
+
+DecodeStatus decode(vdr::codec::SignalBatchDecoder& decoder, const std::string& frame,
+                    const vdr::codec::SignalBatchDecoder::SignalFn& fn) {
+    return decoder.decode(reinterpret_cast<const uint8_t*>(frame.data()), frame.size(), fn);
+}
+
+// Round trip of one batch size; false if a signal did not survive it
+bool run(size_t batch_size, size_t iterations) {
+    std::vector<vss_Signal> signals = make_signals(batch_size);
+    utils::Span<const vss_Signal> batch_span(signals);
+    vdr::sinks::SignalBatchEncoder encoder;
+    vdr::codec::SignalBatchDecoder decoder;
+    std::string dictionary, batch;
+
+    // First batch of the session carries the dictionary
+    encoder.encode(batch_span, dictionary, batch);
+    size_t decoded = 0;
+    bool intact = decode(decoder, dictionary, nullptr) == DecodeStatus::Ok;
+    intact = intact && decode(decoder, batch, [&](const DecodedSignal& s) {
+        intact = intact && decoded < signals.size() && same(signals[decoded], s);
+        ++decoded;
+    }) == DecodeStatus::Ok;
+    if (!intact || decoded != signals.size()) {
+        std::fprintf(stderr, "batch of %zu: round trip mismatch at signal %zu\n", batch_size,
+                     decoded);
+        return false;
+    }
+    size_t dictionary_bytes = dictionary.size();
+
+    // Steady state: no new ids
+    encoder.encode(batch_span, dictionary, batch);
+    double batch_bytes = static_cast<double>(batch.size());
+    double encode_ns = bench::ns_per_op(iterations, [&](size_t) {
+        encoder.encode(batch_span, dictionary, batch);
+    });
+    size_t sink = 0;
+    auto count = [&sink](const DecodedSignal& s) { sink += static_cast<size_t>(s.timestamp_ns); };
+    double decode_ns = bench::ns_per_op(iterations, [&](size_t) {
+        decode(decoder, batch, count);
+    });
+    if (sink == 0) {
+        std::fprintf(stderr, "nothing decoded\n");
+    }
+
+    std::string msgpack;
+    size_t json_bytes = 0;
+    for (const auto& s : signals) {
+        vdr::sinks::encode_msgpack(s, msgpack);
+        json_bytes += vdr::sinks::encode_json(s).dump().size();
+    }
+
+    double n = static_cast<double>(batch_size);
+    std::printf("batch %4zu: %6.1f B/10 signals (msgpack %6.1f, json %7.1f)  "
+                "dictionary %5zu B once  encode %5.1f ns/signal  decode %5.1f ns/signal\n",
+                batch_size, batch_bytes * 10.0 / n, static_cast<double>(msgpack.size()) * 10.0 / n,
+                static_cast<double>(json_bytes) * 10.0 / n, dictionary_bytes, encode_ns / n,
+                decode_ns / n);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = 100000;
+    if (argc > 1) iterations = std::strtoul(argv[1], nullptr, 10);
+    if (iterations == 0) {
+        std::fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    bool ok = true;
+    for (size_t batch_size : {10, 100, 1000}) {
+        ok = run(batch_size, batch_size >= 1000 ? iterations / 100 + 1 : iterations) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_signal_transforms.cpp
+/// @brief Native vssdag transforms vs the Lua interpreter, per sample
+///
+/// Runs every transform of the DBC-sourced signals in a vssdag probe
+/// config (default: config/vssdag_probe_config.yaml) over a synthetic
+/// 100 Hz input and reports the time per sample of the native
+/// SignalTransform. When built with Lua (VDR_HAS_LUA_TRANSFORMS) the same
+/// snippet also runs through the Lua fallback, and both outputs are
+/// compared before timing; value_map is expressed as a Lua table lookup.
+///
+/// Usage: bench_signal_transforms [config] [samples]
+
+#include "bench_utils.hpp"
+#include "vdr/signal_transforms.hpp"
+
+#include <yaml-cpp/yaml.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Case {
+    std::string signal;
+    std::string code;  // original snippet, or a Lua table lookup for value_map
+    vdr::TransformSpec spec;
+};
+
+std::vector<Case> load_cases(const std::string& path) {
+    std::vector<Case> cases;
+    YAML::Node yaml = YAML::LoadFile(path);
+    for (const auto& signal : yaml["signals"]) {
+        const YAML::Node source = signal["source"];
+        const YAML::Node transform = signal["transform"];
+        if (!source || source["type"].as<std::string>("") != "dbc" || !transform) {
+            continue;
+        }
+
+        Case c;
+        c.signal = signal["signal"].as<std::string>("");
+        if (transform["value_map"]) {
+            c.spec.kind = vdr::TransformKind::ValueMap;
+            c.code = "local m = {";
+            for (const auto& entry : transform["value_map"]) {
+                double from = entry.first.as<double>();
+                double to = entry.second.as<double>();
+                c.spec.value_map.emplace_back(from, to);
+                c.code += "[" + std::to_string(from) + "]=" + std::to_string(to) + ",";
+            }
+            c.code += "} return m[x]";
+        } else {
+            c.code = transform["code"].as<std::string>("x");
+            c.spec = vdr::parse_transform_code(c.code);
+        }
+        cases.push_back(std::move(c));
+    }
+    return cases;
+}
+
+/// Time one transform over `samples` inputs; returns ns per sample.
+double time_transform(vdr::SignalTransform& transform, size_t samples, double& checksum) {
+    return bench::ns_per_op(samples, [&](size_t i) {
+        double x = std::floor(4.0 + 3.0 * std::sin(static_cast<double>(i) * 0.01));
+        double out;
+        if (transform.apply(x, static_cast<int64_t>(i) * 10000000, out)) {
+            checksum += out;
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "config/vssdag_probe_config.yaml";
+    size_t samples = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+    std::vector<Case> cases;
+    try {
+        cases = load_cases(path);
+    } catch (const YAML::Exception& e) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), e.what());
+        return 1;
+    }
+
+    bool lua = vdr::SignalTransform::lua_available();
+    std::printf("Signal transforms: %s, %zu samples per transform%s\n", path.c_str(), samples,
+                lua ? "" : " (no Lua in this build: native only)");
+
+    double checksum = 0.0;
+    double native_total = 0.0;
+    double lua_total = 0.0;
+    for (const auto& c : cases) {
+        if (c.spec.kind == vdr::TransformKind::Lua) {
+            std::printf("%-56s custom code, Lua only\n", c.signal.c_str());
+            continue;
+        }
+
+        vdr::SignalTransform native(c.spec);
+        double native_ns = time_transform(native, samples, checksum);
+        native_total += native_ns;
+
+        if (!lua) {
+            std::printf("%-56s %-20s native %7.1f ns\n", c.signal.c_str(),
+                        vdr::to_string(c.spec.kind), native_ns);
+            continue;
+        }
+
+        vdr::TransformSpec lua_spec;
+        lua_spec.kind = vdr::TransformKind::Lua;
+        lua_spec.code = c.code;
+
+        // Both must agree before their timings mean anything
+        vdr::SignalTransform check_native(c.spec);
+        vdr::SignalTransform check_lua(lua_spec);
+        size_t mismatches = 0;
+        for (size_t i = 0; i < 1000; ++i) {
+            double x = std::floor(4.0 + 3.0 * std::sin(static_cast<double>(i) * 0.01));
+            int64_t ts = static_cast<int64_t>(i) * 10000000;
+            double a = 0.0;
+            double b = 0.0;
+            bool has_a = check_native.apply(x, ts, a);
+            bool has_b = check_lua.apply(x, ts, b);
+            if (has_a != has_b || (has_a && std::fabs(a - b) > 1e-9 * (1.0 + std::fabs(a)))) {
+                ++mismatches;
+            }
+        }
+
+        vdr::SignalTransform interpreted(lua_spec);
+        double lua_ns = time_transform(interpreted, samples, checksum);
+        lua_total += lua_ns;
+        std::printf("%-56s %-20s native %7.1f ns  lua %7.1f ns  (x%.0f)%s\n", c.signal.c_str(),
+                    vdr::to_string(c.spec.kind), native_ns, lua_ns, lua_ns / native_ns,
+                    mismatches > 0 ? "  OUTPUTS DIFFER" : "");
+    }
+
+    if (lua && native_total > 0.0) {
+        std::printf("sample config total: native %.1f ns, lua %.1f ns per sample set (x%.0f)\n",
+                    native_total, lua_total, lua_total / native_total);
+    }
+    std::printf("[%.0f]\n", std::fmod(checksum, 10.0));
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file bench_utils.hpp
+/// @brief Small helpers shared by the benchmark executables
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Monotonic wall clock in nanoseconds.
+inline int64_t mono_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// CPU time consumed by the whole process, in nanoseconds.
+inline int64_t process_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+/// Thread-safe latency recorder with percentile summary.
+class LatencyRecorder {
+public:
+    void record(int64_t ns) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_.push_back(ns);
+    }
+
+    size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return samples_.size();
+    }
+
+    /// Percentile in microseconds (p in [0, 100]).
+    double percentile_us(double p) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (samples_.empty()) {
+            return 0.0;
+        }
+        std::vector<int64_t> sorted = samples_;
+        std::sort(sorted.begin(), sorted.end());
+        size_t idx = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1));
+        return static_cast<double>(sorted[idx]) / 1000.0;
+    }
+
+    void print(const std::string& label) const {
+        std::printf("%-24s n=%-7zu p50=%9.1fus p99=%9.1fus max=%9.1fus\n",
+                    label.c_str(), count(),
+                    percentile_us(50), percentile_us(99), percentile_us(100));
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<int64_t> samples_;
+};
+
+/// Time `iterations` calls of `fn` and return nanoseconds per call.
+template<typename Fn>
+double ns_per_op(size_t iterations, Fn&& fn) {
+    int64_t start = mono_ns();
+    for (size_t i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    return static_cast<double>(mono_ns() - start) / static_cast<double>(iterations);
+}
+
+}  // namespace bench
@@ -0,0 +1,176 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file bench_write_batch.cpp
+/// @brief Publish throughput across WriteBatch flush sizes
+///
+/// A forked subscriber process receives the stream over the real transport
+/// (in-process readers would take Cyclone's local fast path and hide the
+/// packet savings). The publisher sends the same gauge stream unbatched
+/// and with a flush every N samples, and reports send rate plus how many
+/// samples reached the subscriber (best effort: losses show up here).
+///
+/// Usage: bench_write_batch [messages_per_round]
+
+#include "bench_utils.hpp"
+#include "common/dds_wrapper.hpp"
+#include "common/qos_profiles.hpp"
+#include "common/time_utils.hpp"
+
+#include "telemetry.h"
+
+#include <glog/logging.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdlib>
+#include <optional>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// 0 = unbatched
+constexpr std::array<size_t, 6> kBatchSizes = {0, 1, 4, 16, 64, 256};
+constexpr uint32_t kRoundStride = 1000000;
+constexpr const char* kTopic = "bench/write_batch";
+
+/// Subscriber process: count samples per round until the stream goes quiet.
+void subscribe(int out_fd) {
+    std::array<uint64_t, kBatchSizes.size()> received{};
+    {
+        dds::Participant participant(DDS_DOMAIN_DEFAULT);
+        auto qos = dds::qos_profiles::best_effort(1000);
+        dds::Topic topic(participant, &telemetry_metrics_Gauge_desc, kTopic, qos.get());
+        dds::Reader reader(participant, topic, qos.get());
+
+        bool seen_any = false;
+        int64_t last_data = bench::mono_ns();
+        while (!seen_any || bench::mono_ns() - last_data < 2000000000LL) {
+            if (!reader.wait(100)) {
+                if (!seen_any && bench::mono_ns() - last_data > 30000000000LL) {
+                    break;  // publisher never showed up
+                }
+                continue;
+            }
+            reader.take_each<telemetry_metrics_Gauge>([&](const telemetry_metrics_Gauge& msg) {
+                size_t round = msg.header.seq_num / kRoundStride;
+                if (round < received.size()) {
+                    ++received[round];
+                }
+            }, 1000);
+            seen_any = true;
+            last_data = bench::mono_ns();
+        }
+    }
+    ssize_t n = ::write(out_fd, received.data(), sizeof(received));
+    (void)n;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+
+    // Fork before any DDS entity exists
+    pid_t child = ::fork();
+    if (child == 0) {
+        ::close(fds[0]);
+        google::InitGoogleLogging("bench_write_batch_sub");
+        subscribe(fds[1]);
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+
+    google::InitGoogleLogging(argv[0]);
+    google::SetStderrLogging(google::WARNING);
+
+    std::array<double, kBatchSizes.size()> ns_per_msg{};
+    {
+        dds::Participant participant(DDS_DOMAIN_DEFAULT);
+        auto qos = dds::qos_profiles::best_effort(1000);
+        dds::Topic topic(participant, &telemetry_metrics_Gauge_desc, kTopic, qos.get());
+        dds::Writer writer(participant, topic, qos.get());
+        std::this_thread::sleep_for(1s);  // discovery across processes
+
+        vss_types_KeyValue labels[] = {
+            {const_cast<char*>("component"), const_cast<char*>("vdr")},
+            {const_cast<char*>("instance"), const_cast<char*>("0")},
+        };
+
+        for (size_t round = 0; round < kBatchSizes.size(); ++round) {
+            size_t flush_every = kBatchSizes[round];
+
+            std::optional<dds::WriteBatch> batch;
+            if (flush_every > 0) {
+                batch.emplace();
+                batch->track(writer);
+            }
+
+            ns_per_msg[round] = bench::ns_per_op(messages, [&](size_t i) {
+                telemetry_metrics_Gauge msg = {};
+                msg.name = const_cast<char*>("process_cpu_percent");
+                msg.header.source_id = const_cast<char*>("bench_probe");
+                msg.header.timestamp_ns = utils::now_ns();
+                msg.header.seq_num = static_cast<uint32_t>(round * kRoundStride + i);
+                msg.header.correlation_id = const_cast<char*>("");
+                msg.labels._buffer = labels;
+                msg.labels._length = 2;
+                msg.labels._maximum = 2;
+                msg.value = static_cast<double>(i);
+                writer.write(msg);
+
+                if (batch && (i + 1) % flush_every == 0) {
+                    batch->flush();
+                }
+            });
+
+            batch.reset();
+            std::this_thread::sleep_for(200ms);  // let the subscriber catch up
+        }
+    }
+
+    std::array<uint64_t, kBatchSizes.size()> received{};
+    ssize_t n = ::read(fds[0], received.data(), sizeof(received));
+    ::waitpid(child, nullptr, 0);
+    if (n != static_cast<ssize_t>(sizeof(received))) {
+        received.fill(0);
+    }
+
+    std::printf("WriteBatch: %zu messages per round, best effort\n", messages);
+    for (size_t round = 0; round < kBatchSizes.size(); ++round) {
+        char label[32];
+        if (kBatchSizes[round] == 0) {
+            std::snprintf(label, sizeof(label), "unbatched");
+        } else {
+            std::snprintf(label, sizeof(label), "flush every %zu", kBatchSizes[round]);
+        }
+        std::printf("%-16s %10.0f msg/s  %7.1f ns/msg  delivered %5.1f%%\n",
+                    label, 1e9 / ns_per_msg[round], ns_per_msg[round],
+                    100.0 * static_cast<double>(received[round]) / static_cast<double>(messages));
+    }
+
+    google::ShutdownGoogleLogging();
+    return 0;
+}
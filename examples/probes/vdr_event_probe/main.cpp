@@ -117,8 +117,10 @@ int main(int argc, char* argv[]) {
         // Create DDS participant
         dds::Participant participant(DDS_DOMAIN_DEFAULT);
 
-        // Create topic with reliable critical QoS (events must not be lost)
+        // Create topic with reliable critical QoS (events must not be lost),
+        // but never stall the probe for long behind a slow reader
         auto qos = dds::qos_profiles::reliable_critical();
+        qos.max_blocking_time(DDS_MSECS(50));
         dds::Topic topic(participant, &telemetry_events_Event_desc,
                          "rt/events/vehicle", qos.get());
 
@@ -183,7 +185,12 @@ int main(int argc, char* argv[]) {
             msg.context._length = 0;
             msg.context._maximum = 0;
 
-            writer.write(msg);
+            dds_return_t rc = writer.try_write(msg);
+            if (rc != DDS_RETCODE_OK) {
+                LOG(WARNING) << "Event " << evt.category << "/" << evt.event_type
+                             << " not published: " << dds_strretcode(rc);
+                continue;
+            }
             event_count++;
 
             const char* severity_str = "INFO";
@@ -198,7 +205,9 @@ int main(int argc, char* argv[]) {
                       << " [" << severity_str << "] id=" << event_id;
         }
 
-        LOG(INFO) << "Event Probe shutdown. Total events published: " << event_count;
+        auto stats = writer.stats();
+        LOG(INFO) << "Event Probe shutdown. Total events published: " << event_count
+                  << ", timed out: " << stats.timeouts << ", dropped: " << stats.dropped;
 
     } catch (const dds::Error& e) {
         LOG(FATAL) << "DDS error: " << e.what();
@@ -17,6 +17,8 @@
 
 #include <glog/logging.h>
 
+#include <optional>
+
 namespace vdr {
 namespace testing {
 
@@ -189,8 +191,29 @@ void TestProbe::send_event(const std::string& category,
 }
 
 void TestProbe::send_signal_burst(size_t count, std::chrono::milliseconds interval) {
+    if (!running_) return;
+
+    // Back-to-back samples share packets; spaced ones go out one by one
+    std::optional<dds::WriteBatch> batch;
+    if (interval.count() == 0) {
+        batch.emplace();
+        batch->track(*writer_signal_);
+    }
+
     for (size_t i = 0; i < count && running_; ++i) {
-        send_signal("Vehicle.Test.Burst", static_cast<double>(i));
+        // Fill the writer's loaned sample in place rather than a stack copy
+        auto loan = writer_signal_->loan<vss_Signal>();
+        loan->path = const_cast<char*>("Vehicle.Test.Burst");
+        loan->header.source_id = const_cast<char*>(source_id_.c_str());
+        loan->header.timestamp_ns = utils::now_ns();
+        loan->header.seq_num = seq_++;
+        loan->header.correlation_id = const_cast<char*>("");
+        loan->quality = vss_types_QUALITY_VALID;
+        loan->value.type = vss_types_VALUE_TYPE_DOUBLE;
+        loan->value.double_value = static_cast<double>(i);
+        loan.commit();
+        ++signals_sent_;
+
         if (interval.count() > 0) {
             std::this_thread::sleep_for(interval);
         }
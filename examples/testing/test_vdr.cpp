@@ -47,38 +47,16 @@ bool TestVdr::start(std::unique_ptr<OutputSink> sink,
         participant_ = std::make_unique<dds::Participant>(domain_id_);
         subscriptions_ = std::make_unique<SubscriptionManager>(*participant_, config_);
 
-        // Wire callbacks to sink
-        subscriptions_->on_vss_signal([this](const vss_Signal& msg) {
-            sink_->send(msg);
+        // Wire every typed topic to the sink, one call per take
+        subscribe_all_batches(*subscriptions_, config_, [this](auto batch) {
+            sink_->send_batch(batch);
         });
 
-        subscriptions_->on_event([this](const telemetry_events_Event& msg) {
-            sink_->send(msg);
-        });
-
-        subscriptions_->on_gauge([this](const telemetry_metrics_Gauge& msg) {
-            sink_->send(msg);
-        });
-
-        subscriptions_->on_counter([this](const telemetry_metrics_Counter& msg) {
-            sink_->send(msg);
-        });
-
-        subscriptions_->on_histogram([this](const telemetry_metrics_Histogram& msg) {
-            sink_->send(msg);
-        });
-
-        subscriptions_->on_log_entry([this](const telemetry_logs_LogEntry& msg) {
-            sink_->send(msg);
-        });
-
-        subscriptions_->on_scalar_measurement([this](const telemetry_diagnostics_ScalarMeasurement& msg) {
-            sink_->send(msg);
-        });
-
-        subscriptions_->on_vector_measurement([this](const telemetry_diagnostics_VectorMeasurement& msg) {
-            sink_->send(msg);
-        });
+        if (sink_->accepts_serialized()) {
+            subscriptions_->on_serialized([this](const SerializedMessage& msg) {
+                sink_->send_serialized(msg);
+            });
+        }
 
         subscriptions_->start();
         running_ = true;
@@ -0,0 +1,224 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file tools/vdr_train_dictionary/main.cpp
+/// @brief Trains a compression dictionary for the MQTT sink offline
+///
+/// Input is captured offboard traffic, e.g. recorded with
+///     mosquitto_sub -t 'vdr/v1/#' -N > capture.bin
+/// while the VDR publishes uncompressed batches. Framed batches written
+/// back to back are split into their messages, which become the training
+/// samples; a file that is not a batch stream is one sample, or one per
+/// line with --lines (JSON payloads published unbatched). The dictionary
+/// is trained with zstd and is used by zstd and LZ4 alike.
+///
+/// The captured batches are then compressed with and without the new
+/// dictionary at the configured default levels, to show what it saves.
+///
+/// Usage: vdr_train_dictionary [-o out.dict] [--size bytes] [--lines]
+///                             [--algorithm zstd|lz4] capture...
+
+#include "vdr/sinks/batch_compressor.hpp"
+#include "vdr/sinks/topic_batcher.hpp"
+
+#include <zdict.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct Samples {
+    std::string data;  // concatenated, as ZDICT_trainFromBuffer wants them
+    std::vector<size_t> sizes;
+    std::vector<std::string> batches;
+
+    void add(std::string_view sample) {
+        if (!sample.empty()) {
+            data.append(sample);
+            sizes.push_back(sample.size());
+        }
+    }
+};
+
+// Size of the framed batch at the start of `stream`, 0 if there is none
+size_t batch_extent(std::string_view stream) {
+    const auto* p = reinterpret_cast<const uint8_t*>(stream.data());
+    auto read_u32 = [p](size_t at) {
+        return (uint32_t(p[at]) << 24) | (uint32_t(p[at + 1]) << 16) |
+               (uint32_t(p[at + 2]) << 8) | uint32_t(p[at + 3]);
+    };
+    if (stream.size() < vdr::sinks::kBatchHeaderSize || p[0] != 'V' || p[1] != 'B' ||
+        p[2] != vdr::sinks::kBatchVersion || p[3] != 0) {
+        return 0;
+    }
+    uint32_t count = read_u32(4);
+    size_t pos = vdr::sinks::kBatchHeaderSize;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (stream.size() - pos < vdr::sinks::kBatchLengthSize) {
+            return 0;
+        }
+        size_t length = read_u32(pos);
+        pos += vdr::sinks::kBatchLengthSize;
+        if (stream.size() - pos < length) {
+            return 0;
+        }
+        pos += length;
+    }
+    return pos;
+}
+
+void add_capture(const std::string& contents, bool lines, Samples& samples) {
+    std::string_view rest(contents);
+    size_t extent = batch_extent(rest);
+    if (extent == 0) {
+        if (!lines) {
+            samples.add(rest);
+            return;
+        }
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            samples.add(rest.substr(0, end));
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+        }
+        return;
+    }
+
+    while (extent > 0) {
+        std::string_view batch = rest.substr(0, extent);
+        samples.batches.emplace_back(batch);
+        vdr::sinks::for_each_batch_message(reinterpret_cast<const uint8_t*>(batch.data()),
+                                           batch.size(),
+                                           [&samples](std::string_view m) { samples.add(m); });
+        rest.remove_prefix(extent);
+        extent = batch_extent(rest);
+    }
+    if (!rest.empty()) {
+        std::fprintf(stderr, "ignoring %zu bytes after the last complete batch\n", rest.size());
+    }
+}
+
+// Total compressed size of the captured batches
+size_t compressed_size(const std::vector<std::string>& batches,
+                       vdr::sinks::CompressionConfig config) {
+    config.min_bytes = 0;
+    vdr::sinks::BatchCompressor compressor(std::move(config));
+    std::string out;
+    size_t total = 0;
+    for (const auto& batch : batches) {
+        total += compressor.compress(batch, out).size();
+    }
+    return total;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: vdr_train_dictionary [-o out.dict] [--size bytes] [--lines]\n"
+                 "                            [--algorithm zstd|lz4] capture...\n");
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output = "offboard.dict";
+    size_t dictionary_capacity = 16 * 1024;
+    bool lines = false;
+    auto algorithm = vdr::sinks::Compression::Zstd;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-o" && has_value) {
+            output = argv[++i];
+        } else if (arg == "--size" && has_value) {
+            dictionary_capacity = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--lines") {
+            lines = true;
+        } else if (arg == "--algorithm" && has_value) {
+            auto parsed = vdr::sinks::parse_compression(argv[++i]);
+            if (!parsed || !vdr::sinks::compression_available(*parsed)) {
+                std::fprintf(stderr, "unsupported algorithm %s\n", argv[i]);
+                return 2;
+            }
+            algorithm = *parsed;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return usage();
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty() || dictionary_capacity == 0) {
+        return usage();
+    }
+
+    Samples samples;
+    for (const auto& path : inputs) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", path.c_str());
+            return 1;
+        }
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        add_capture(contents, lines, samples);
+    }
+
+    std::string dictionary(dictionary_capacity, '\0');
+    size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data.data(),
+                                        samples.sizes.data(),
+                                        static_cast<unsigned>(samples.sizes.size()));
+    if (ZDICT_isError(size)) {
+        std::fprintf(stderr, "training on %zu samples (%zu bytes) failed: %s\n",
+                     samples.sizes.size(), samples.data.size(), ZDICT_getErrorName(size));
+        return 1;
+    }
+    dictionary.resize(size);
+
+    std::ofstream out(output, std::ios::binary);
+    out.write(dictionary.data(), static_cast<std::streamsize>(dictionary.size()));
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", output.c_str());
+        return 1;
+    }
+    std::printf("%s: %zu bytes, id %u, from %zu samples (%zu bytes)\n", output.c_str(),
+                dictionary.size(), vdr::sinks::compression_dictionary_id(dictionary),
+                samples.sizes.size(), samples.data.size());
+
+    if (!samples.batches.empty()) {
+        size_t raw = 0;
+        for (const auto& batch : samples.batches) {
+            raw += batch.size();
+        }
+        vdr::sinks::CompressionConfig config;
+        config.algorithm = algorithm;
+        size_t plain = compressed_size(samples.batches, config);
+        config.dictionary = dictionary;
+        size_t trained = compressed_size(samples.batches, config);
+        std::printf("%zu captured batches, %zu bytes: %s %zu bytes (%.2fx), "
+                    "with dictionary %zu bytes (%.2fx)\n",
+                    samples.batches.size(), raw, vdr::sinks::to_string(algorithm), plain,
+                    static_cast<double>(raw) / static_cast<double>(plain), trained,
+                    static_cast<double>(raw) / static_cast<double>(trained));
+    }
+    return 0;
+}
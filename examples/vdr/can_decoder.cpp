@@ -0,0 +1,296 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/can_decoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace vdr {
+
+namespace {
+
+constexpr uint32_t kExtendedKey = 0x80000000u;
+
+// Frames are gathered into this many words before the arithmetic pass
+constexpr size_t kKernelChunk = 64;
+
+constexpr bool kHostLittle = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+template<bool BigEndian>
+uint64_t load_window(const uint8_t* data) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    if constexpr (BigEndian == kHostLittle) {
+        word = __builtin_bswap64(word);
+    }
+    return word;
+}
+
+template<bool BigEndian, bool Signed>
+void extract(const BitExtractor& x, const CanFrame* const* frames, size_t count, double* out) {
+    uint64_t words[kKernelChunk];
+    for (size_t base = 0; base < count; base += kKernelChunk) {
+        size_t n = std::min(kKernelChunk, count - base);
+
+        // Gather: one unaligned load per frame
+        for (size_t i = 0; i < n; ++i) {
+            words[i] = load_window<BigEndian>(frames[base + i]->data + x.byte);
+        }
+
+        // Isolate, sign-extend and scale; no loads, no branches
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t bits = (words[i] >> x.shift) << x.width_shift;
+            double raw = Signed ? static_cast<double>(static_cast<int64_t>(bits) >> x.width_shift)
+                                : static_cast<double>(bits >> x.width_shift);
+            out[base + i] = raw * x.scale + x.offset;
+        }
+    }
+}
+
+BitExtractor::Kernel select_kernel(bool big_endian, bool is_signed) {
+    if (big_endian) {
+        return is_signed ? &extract<true, true> : &extract<true, false>;
+    }
+    return is_signed ? &extract<false, true> : &extract<false, false>;
+}
+
+}  // namespace
+
+std::optional<vss_types_ValueType> parse_value_type(std::string_view name) {
+    if (name == "bool" || name == "boolean") return vss_types_VALUE_TYPE_BOOL;
+    if (name == "int8") return vss_types_VALUE_TYPE_INT8;
+    if (name == "int16") return vss_types_VALUE_TYPE_INT16;
+    if (name == "int32") return vss_types_VALUE_TYPE_INT32;
+    if (name == "int64") return vss_types_VALUE_TYPE_INT64;
+    if (name == "uint8") return vss_types_VALUE_TYPE_UINT8;
+    if (name == "uint16") return vss_types_VALUE_TYPE_UINT16;
+    if (name == "uint32") return vss_types_VALUE_TYPE_UINT32;
+    if (name == "uint64") return vss_types_VALUE_TYPE_UINT64;
+    if (name == "float") return vss_types_VALUE_TYPE_FLOAT;
+    if (name == "double") return vss_types_VALUE_TYPE_DOUBLE;
+    return std::nullopt;
+}
+
+std::optional<BitExtractor> compile(const DbcSignal& signal) {
+    if (signal.multiplexed || signal.length == 0 || signal.length > 64) {
+        return std::nullopt;
+    }
+
+    // Bit positions within the payload, counted from the first byte: Intel
+    // counts from the LSB of each byte, Motorola from the MSB
+    uint32_t lsb;
+    uint32_t last;  // furthest bit from the window start
+    if (signal.big_endian) {
+        uint32_t msb = (signal.start_bit / 8) * 8 + (7 - signal.start_bit % 8);
+        lsb = msb + signal.length - 1;
+        last = lsb;
+    } else {
+        lsb = signal.start_bit;
+        last = lsb + signal.length - 1;
+    }
+    if (last >= CanFrame::kMaxPayload * 8) {
+        return std::nullopt;
+    }
+
+    // 8-byte window, moved back if it would run past the payload
+    uint32_t first_bit = signal.big_endian ? lsb + 1 - signal.length : lsb;
+    BitExtractor x;
+    x.byte = std::min<uint32_t>(first_bit / 8, CanFrame::kMaxPayload - 8);
+    if (last - x.byte * 8 >= 64) {
+        return std::nullopt;
+    }
+    // Big-endian windows are loaded MSB first, so bit 63 is the window's first bit
+    x.shift = signal.big_endian ? 63 - (lsb - x.byte * 8) : lsb - x.byte * 8;
+    x.width_shift = 64 - signal.length;
+    x.min_length = last / 8 + 1;
+    x.scale = signal.scale;
+    x.offset = signal.offset;
+    x.kernel = select_kernel(signal.big_endian, signal.is_signed);
+    return x;
+}
+
+CanDecoder::CanDecoder(const std::vector<DbcMessage>& messages,
+                       const std::vector<CanSignalMapping>& mappings) {
+    std::vector<bool> found(mappings.size(), false);
+
+    for (const auto& dbc : messages) {
+        Message message;
+        for (const auto& signal : dbc.signals) {
+            for (size_t i = 0; i < mappings.size(); ++i) {
+                if (mappings[i].dbc_signal != signal.name) {
+                    continue;
+                }
+                auto extractor = compile(signal);
+                if (!extractor) {
+                    continue;
+                }
+                found[i] = true;
+                message.min_length = std::max(message.min_length, extractor->min_length);
+                message.extractors.push_back(*extractor);
+                message.outputs.push_back({mappings[i].vss_path, mappings[i].type,
+                                           SignalTransform(mappings[i].transform)});
+            }
+        }
+        if (message.extractors.empty()) {
+            continue;
+        }
+
+        signal_count_ += message.extractors.size();
+        uint32_t key = dbc.id | (dbc.extended ? kExtendedKey : 0);
+        index_[key] = messages_.size();
+        messages_.push_back(std::move(message));
+    }
+
+    // Derived signals, in an order where each one's dependencies come
+    // first; anything left over depends on a path nothing produces
+    std::unordered_set<std::string> produced;
+    for (const auto& message : messages_) {
+        for (const auto& output : message.outputs) {
+            produced.insert(output.path);
+        }
+    }
+    std::vector<size_t> order;
+    for (bool progress = true; progress;) {
+        progress = false;
+        for (size_t i = 0; i < mappings.size(); ++i) {
+            const CanSignalMapping& mapping = mappings[i];
+            if (found[i] || !mapping.dbc_signal.empty() || mapping.depends_on.empty()) {
+                continue;
+            }
+            bool ready = std::all_of(mapping.depends_on.begin(), mapping.depends_on.end(),
+                                     [&](const std::string& path) { return produced.count(path); });
+            if (ready) {
+                found[i] = true;
+                produced.insert(mapping.vss_path);
+                order.push_back(i);
+                progress = true;
+            }
+        }
+    }
+
+    // Wire each dependency to the derived signals it triggers
+    std::unordered_map<std::string, std::vector<Output*>> producers;
+    derived_.reserve(order.size());
+    for (size_t i : order) {
+        derived_.push_back({{mappings[i].vss_path, mappings[i].type,
+                             SignalTransform(mappings[i].transform)},
+                            {},
+                            0});
+    }
+    for (auto& message : messages_) {
+        for (auto& output : message.outputs) {
+            producers[output.path].push_back(&output);
+        }
+    }
+    for (auto& derived : derived_) {
+        producers[derived.output.path].push_back(&derived.output);
+    }
+    for (size_t d = 0; d < order.size(); ++d) {
+        std::unordered_set<std::string> distinct;
+        for (const auto& path : mappings[order[d]].depends_on) {
+            if (!distinct.insert(path).second) {
+                continue;
+            }
+            for (Output* producer : producers[path]) {
+                producer->dependents.push_back({d, derived_[d].seen.size()});
+            }
+            derived_[d].seen.push_back(false);
+        }
+        derived_[d].missing = derived_[d].seen.size();
+    }
+    for (auto& message : messages_) {
+        for (const auto& output : message.outputs) {
+            message.feeds_derived |= !output.dependents.empty();
+        }
+    }
+    signal_count_ += derived_.size();
+
+    for (size_t i = 0; i < mappings.size(); ++i) {
+        if (!found[i]) {
+            unmapped_.push_back(mappings[i].dbc_signal.empty() ? mappings[i].vss_path
+                                                               : mappings[i].dbc_signal);
+        }
+    }
+}
+
+bool CanDecoder::update_dependents(const Output& output, double value) {
+    for (const Dependent& edge : output.dependents) {
+        Derived& derived = derived_[edge.derived];
+        derived.output.transform.set_dependency(output.path, value);
+        if (!derived.seen[edge.slot]) {
+            derived.seen[edge.slot] = true;
+            --derived.missing;
+        }
+        if (!derived.pending || edge.slot < derived.trigger_slot) {
+            derived.pending = true;
+            derived.trigger_slot = edge.slot;
+            derived.x = value;
+        }
+    }
+    return !output.dependents.empty();
+}
+
+size_t CanDecoder::decode_columns(const CanFrame* frames, size_t count) {
+    for (size_t m : active_) {
+        messages_[m].frames.clear();
+    }
+    active_.clear();
+    frame_order_.clear();
+
+    size_t decoded = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const CanFrame& frame = frames[i];
+        uint32_t key = frame.can_id | ((frame.flags & CanFrame::kExtendedId) ? kExtendedKey : 0);
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            ++stats_.unknown;
+            continue;
+        }
+        Message& message = messages_[it->second];
+        if (frame.length < message.min_length) {
+            ++stats_.short_frames;
+            continue;
+        }
+        if (message.frames.empty()) {
+            active_.push_back(it->second);
+        }
+        if (message.feeds_derived) {
+            frame_order_.push_back({it->second, message.frames.size()});
+        }
+        message.frames.push_back(&frame);
+        ++decoded;
+    }
+
+    for (size_t m : active_) {
+        Message& message = messages_[m];
+        size_t n = message.frames.size();
+        message.values.resize(message.extractors.size() * n);
+        for (size_t s = 0; s < message.extractors.size(); ++s) {
+            const BitExtractor& x = message.extractors[s];
+            x.kernel(x, message.frames.data(), n, &message.values[s * n]);
+        }
+        if (message.feeds_derived) {
+            message.published.resize(message.values.size());
+            message.has_value.assign(message.values.size(), 0);
+        }
+    }
+
+    stats_.frames += decoded;
+    return decoded;
+}
+
+}  // namespace vdr
@@ -0,0 +1,346 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file can_decoder.hpp
+/// @brief DBC-driven decoding of CAN frames into vss_Signal
+///
+/// Each DBC signal that maps to a VSS path is compiled once into a
+/// BitExtractor: the byte window to load, the shifts that isolate and
+/// sign-extend the raw value, scale/offset, and an extraction kernel
+/// specialized for the signal's byte order and signedness. Decoding then
+/// runs without per-signal branching.
+///
+/// CanDecoder groups a span of frames (e.g. from CanFrameRing::consume) by
+/// CAN ID and runs each signal's kernel over all frames of its message at
+/// once, writing one column of values per signal (structure of arrays).
+/// The kernels keep loads and arithmetic in separate passes so the
+/// compiler can vectorize the arithmetic; there are no intrinsics.
+
+#include "vdr/can_ingest.hpp"
+#include "vdr/dbc.hpp"
+#include "vdr/signal_transforms.hpp"
+#include "vss_signal.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vdr {
+
+/// Where a DBC signal is published, e.g. from vssdag_probe_config.yaml:
+/// `source.name` -> `signal`, typed as `datatype`, after `transform`.
+///
+/// A derived signal names no DBC signal; it is computed by `transform`
+/// from the VSS paths in `depends_on` (vssdag `update_trigger:
+/// on_dependency`).
+struct CanSignalMapping {
+    std::string dbc_signal;  ///< Empty for a derived signal
+    std::string vss_path;
+    vss_types_ValueType type = vss_types_VALUE_TYPE_DOUBLE;
+    TransformSpec transform{};
+    std::vector<std::string> depends_on{};  ///< Derived signals only
+};
+
+/// Parse a scalar vssdag datatype ("bool", "int8" ... "uint64", "float",
+/// "double").
+std::optional<vss_types_ValueType> parse_value_type(std::string_view name);
+
+/// Precompiled extraction of one signal from a CAN payload.
+///
+/// The signal is read from an 8-byte window starting at `byte`, loaded in
+/// the signal's byte order; its LSB sits at bit `shift` of that word.
+struct BitExtractor {
+    /// Decode the signal from `count` frames into `out[0..count)`.
+    using Kernel = void (*)(const BitExtractor& extractor, const CanFrame* const* frames,
+                            size_t count, double* out);
+
+    uint32_t byte = 0;
+    uint32_t shift = 0;
+    uint32_t width_shift = 0;  ///< 64 - length
+    uint32_t min_length = 0;   ///< Payload bytes that must be present
+    double scale = 1.0;
+    double offset = 0.0;
+    Kernel kernel = nullptr;
+};
+
+/// Compile a signal, or std::nullopt if it cannot be extracted: multiplexed
+/// signals, signals beyond 64 payload bytes, and signals of more than 57
+/// bits that do not start on a byte boundary.
+std::optional<BitExtractor> compile(const DbcSignal& signal);
+
+struct CanDecoderStats {
+    uint64_t frames = 0;        ///< Frames decoded
+    uint64_t signals = 0;       ///< vss_Signal samples produced
+    uint64_t filtered = 0;      ///< Samples dropped by a transform
+    uint64_t unknown = 0;       ///< Frames whose CAN ID has no mapped signal
+    uint64_t short_frames = 0;  ///< Frames too short for their mapped signals
+};
+
+/// Decodes CAN frames into vss_Signal samples.
+///
+/// Not thread-safe: use one decoder per consuming thread.
+class CanDecoder {
+public:
+    /// Source ID of produced samples.
+    static constexpr const char* kSourceId = "vdr_can_decoder";
+
+    /// Compiles every signal of `messages` named in `mappings`; messages
+    /// without mapped signals are ignored. Derived mappings are resolved
+    /// against the VSS paths the other mappings produce. Mappings that name
+    /// no DBC signal, one that does not compile, or a dependency nothing
+    /// produces (including cycles), are listed by unmapped(). Throws
+    /// std::invalid_argument if a mapped transform is invalid (see
+    /// SignalTransform).
+    CanDecoder(const std::vector<DbcMessage>& messages,
+               const std::vector<CanSignalMapping>& mappings);
+
+    /// Decode `frames` and call `handler(const vss_Signal&)` for every
+    /// mapped signal of every known frame, after the signal's transform
+    /// (which may drop samples). Samples are produced per signal, in frame
+    /// order within a signal, so stateful transforms see them in order; the
+    /// vss_Signal and its strings are only valid during the call.
+    ///
+    /// Derived signals follow, in frame order: for each frame, every
+    /// dependency value it carries is set first, then each derived signal
+    /// depending on one of them is evaluated once (in dependency order, so
+    /// chains see the same frame), with the frame's timestamp and `x` set
+    /// to the frame's value of its first listed dependency that the frame
+    /// carries. A derived signal starts once every dependency has a value.
+    /// Returns the number of frames decoded.
+    template<typename Handler>
+    size_t decode(const CanFrame* frames, size_t count, Handler&& handler);
+
+    /// Signals that will be decoded.
+    size_t signal_count() const noexcept { return signal_count_; }
+
+    /// DBC signal names (VSS paths for derived signals) of mappings that
+    /// will not be decoded.
+    const std::vector<std::string>& unmapped() const noexcept { return unmapped_; }
+
+    const CanDecoderStats& stats() const noexcept { return stats_; }
+
+private:
+    // An edge from a produced signal to a derived one
+    struct Dependent {
+        size_t derived;  // derived_ index
+        size_t slot;     // index into Derived::seen
+    };
+
+    struct Output {
+        std::string path;
+        vss_types_ValueType type;
+        SignalTransform transform;
+        std::vector<Dependent> dependents{};
+    };
+
+    // A signal computed from other outputs
+    struct Derived {
+        Output output;
+        std::vector<bool> seen;  // per distinct dependency
+        size_t missing = 0;      // dependencies without a value yet
+
+        // Set by the frame being evaluated
+        bool pending = false;
+        size_t trigger_slot = 0;
+        double x = 0.0;
+    };
+
+    // A message with at least one mapped signal, plus the frames and
+    // value columns of the span being decoded
+    struct Message {
+        uint32_t min_length = 0;
+        std::vector<BitExtractor> extractors;
+        std::vector<Output> outputs;
+        std::vector<const CanFrame*> frames;
+        std::vector<double> values;  // extractors.size() columns of frames.size()
+
+        // For derived signals: transformed values, same layout as values
+        bool feeds_derived = false;
+        std::vector<double> published;
+        std::vector<uint8_t> has_value;
+    };
+
+    // A frame of a message that feeds derived signals
+    struct FrameRef {
+        size_t message;
+        size_t index;  // into Message::frames
+    };
+
+    // Group frames by message and fill the value columns
+    size_t decode_columns(const CanFrame* frames, size_t count);
+
+    static void publish(const Output& output, double value, vss_Signal& msg);
+
+    // Evaluate derived signals over frame_order_
+    template<typename Handler>
+    void decode_derived(vss_Signal& msg, Handler& handler, size_t& produced, size_t& filtered);
+
+    // Pass `value` of `output` to its dependents; true if it has any
+    bool update_dependents(const Output& output, double value);
+
+    static void set_value(vss_types_Value& value, vss_types_ValueType type, double decoded);
+
+    std::vector<Message> messages_;
+    std::unordered_map<uint32_t, size_t> index_;  // CAN ID (bit 31 = extended) -> messages_
+    std::vector<size_t> active_;                  // messages with frames in this span
+    std::vector<Derived> derived_;                // in dependency order
+    std::vector<FrameRef> frame_order_;           // span order, feeding messages only
+    size_t signal_count_ = 0;
+    std::vector<std::string> unmapped_;
+    CanDecoderStats stats_;
+};
+
+// Template implementations
+
+template<typename Handler>
+size_t CanDecoder::decode(const CanFrame* frames, size_t count, Handler&& handler) {
+    size_t decoded = decode_columns(frames, count);
+
+    vss_Signal msg = {};
+    msg.header.source_id = const_cast<char*>(kSourceId);
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.quality = vss_types_QUALITY_VALID;
+
+    size_t produced = 0;
+    size_t filtered = 0;
+    for (size_t m : active_) {
+        Message& message = messages_[m];
+        size_t n = message.frames.size();
+        for (size_t s = 0; s < message.outputs.size(); ++s) {
+            Output& output = message.outputs[s];
+            const double* column = &message.values[s * n];
+            bool record = !output.dependents.empty();
+            for (size_t i = 0; i < n; ++i) {
+                const CanFrame* frame = message.frames[i];
+                double value;
+                if (!output.transform.apply(column[i], frame->timestamp_ns, value)) {
+                    ++filtered;
+                    continue;
+                }
+                msg.header.timestamp_ns = frame->timestamp_ns;
+                msg.header.seq_num = frame->sequence_num;
+                publish(output, value, msg);
+                handler(static_cast<const vss_Signal&>(msg));
+                ++produced;
+                if (record) {
+                    message.published[s * n + i] = value;
+                    message.has_value[s * n + i] = 1;
+                }
+            }
+        }
+    }
+    if (!frame_order_.empty()) {
+        decode_derived(msg, handler, produced, filtered);
+    }
+    stats_.signals += produced;
+    stats_.filtered += filtered;
+    return decoded;
+}
+
+template<typename Handler>
+void CanDecoder::decode_derived(vss_Signal& msg, Handler& handler, size_t& produced,
+                                size_t& filtered) {
+    for (const FrameRef& ref : frame_order_) {
+        Message& message = messages_[ref.message];
+        size_t n = message.frames.size();
+        bool triggered = false;
+        for (size_t s = 0; s < message.outputs.size(); ++s) {
+            if (message.has_value[s * n + ref.index]) {
+                triggered |= update_dependents(message.outputs[s],
+                                               message.published[s * n + ref.index]);
+            }
+        }
+        if (!triggered) {
+            continue;
+        }
+
+        const CanFrame* frame = message.frames[ref.index];
+        msg.header.timestamp_ns = frame->timestamp_ns;
+        msg.header.seq_num = frame->sequence_num;
+        for (Derived& derived : derived_) {
+            if (!derived.pending) {
+                continue;
+            }
+            derived.pending = false;
+            if (derived.missing > 0) {
+                continue;
+            }
+            double value;
+            if (!derived.output.transform.apply(derived.x, frame->timestamp_ns, value)) {
+                ++filtered;
+                continue;
+            }
+            publish(derived.output, value, msg);
+            handler(static_cast<const vss_Signal&>(msg));
+            ++produced;
+            update_dependents(derived.output, value);
+        }
+    }
+}
+
+inline void CanDecoder::publish(const Output& output, double value, vss_Signal& msg) {
+    msg.path = const_cast<char*>(output.path.c_str());
+    msg.value = {};
+    msg.value.type = output.type;
+    set_value(msg.value, output.type, value);
+}
+
+inline void CanDecoder::set_value(vss_types_Value& value, vss_types_ValueType type,
+                                  double decoded) {
+    switch (type) {
+        case vss_types_VALUE_TYPE_BOOL:
+            value.bool_value = decoded != 0.0;
+            break;
+        case vss_types_VALUE_TYPE_INT8:
+            value.int8_value = static_cast<int8_t>(std::lround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_INT16:
+            value.int16_value = static_cast<int16_t>(std::lround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_INT32:
+            value.int32_value = static_cast<int32_t>(std::lround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_INT64:
+            value.int64_value = std::llround(decoded);
+            break;
+        case vss_types_VALUE_TYPE_UINT8:
+            value.uint8_value = static_cast<uint8_t>(std::lround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_UINT16:
+            value.uint16_value = static_cast<uint16_t>(std::lround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_UINT32:
+            value.uint32_value = static_cast<uint32_t>(std::llround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_UINT64:
+            value.uint64_value = static_cast<uint64_t>(std::llround(decoded));
+            break;
+        case vss_types_VALUE_TYPE_FLOAT:
+            value.float_value = static_cast<float>(decoded);
+            break;
+        default:
+            value.double_value = decoded;
+            break;
+    }
+}
+
+}  // namespace vdr
@@ -0,0 +1,123 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/can_ingest.hpp"
+
+#include "common/cdr_reader.hpp"
+
+#include <cstring>
+
+namespace vdr {
+
+namespace {
+
+size_t round_up_pow2(size_t n) {
+    size_t capacity = 1;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// vss::types::Header; only the timestamp is kept
+int64_t read_header_timestamp(dds::CdrReader& reader) {
+    reader.skip_string();  // source_id
+    int64_t timestamp_ns = reader.read<int64_t>();
+    reader.read<uint32_t>();  // seq_num
+    reader.skip_string();  // correlation_id
+    return timestamp_ns;
+}
+
+bool read_frame(dds::CdrReader& reader, CanFrame& out) {
+    out.timestamp_ns = read_header_timestamp(reader);
+    out.stream_id = reader.read<uint64_t>();
+    out.can_id = reader.read<uint32_t>();
+    out.bus_id = reader.read<uint8_t>();
+
+    uint8_t flags = 0;
+    if (reader.read<uint8_t>()) flags |= CanFrame::kExtendedId;
+    if (reader.read<uint8_t>()) flags |= CanFrame::kFd;
+    if (reader.read<uint8_t>()) flags |= CanFrame::kBitRateSwitch;
+    if (reader.read<uint8_t>()) flags |= CanFrame::kErrorState;
+    if (reader.read<uint8_t>()) flags |= CanFrame::kRemoteRequest;
+    out.flags = flags;
+
+    auto payload = reader.read_array<uint8_t>();
+    if (payload.size() > CanFrame::kMaxPayload) {
+        return false;
+    }
+    out.length = static_cast<uint8_t>(payload.size());
+    if (!payload.empty()) {
+        std::memcpy(out.data, payload.raw(), payload.size());
+    }
+
+    out.avtp_timestamp = reader.read<uint64_t>();
+    out.sequence_num = reader.read<uint32_t>();
+    return reader.ok();
+}
+
+}  // namespace
+
+CanFrameRing::CanFrameRing(size_t capacity)
+    : slots_(round_up_pow2(capacity > 0 ? capacity : 1)), mask_(slots_.size() - 1) {}
+
+size_t CanIngest::ingest(const uint8_t* data, size_t size) {
+    dds::CdrReader reader(data, size);
+    read_header_timestamp(reader);
+    reader.read<uint64_t>();  // stream_id, repeated in every frame
+    uint32_t count = reader.read_length();
+
+    // Frames are decoded straight into ring slots; once the ring is full
+    // the rest are still decoded (into `overflow`) to validate the batch
+    size_t committed = 0;
+    size_t dropped = 0;
+    CanFrame overflow;
+    bool ok = reader.ok();
+    for (uint32_t i = 0; i < count && ok; ++i) {
+        CanFrame* slot = ring_.claim();
+        if (slot) {
+            ++committed;
+        } else {
+            slot = &overflow;
+            ++dropped;
+        }
+        ok = read_frame(reader, *slot);
+    }
+
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) {
+        ring_.rollback();
+        malformed_.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    ring_.commit();
+    frames_.fetch_add(committed, std::memory_order_relaxed);
+    if (dropped > 0) {
+        dropped_.fetch_add(dropped, std::memory_order_relaxed);
+    }
+    return committed;
+}
+
+CanIngestStats CanIngest::stats() const {
+    CanIngestStats stats;
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.frames = frames_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.malformed = malformed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace vdr
@@ -0,0 +1,187 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file can_ingest.hpp
+/// @brief AVTP CAN frame ingestion for rt/avtp/can/batches
+///
+/// CAN is the highest-rate source in the vehicle: a loaded CAN-FD bus
+/// carries several thousand frames per second. Instead of deserializing
+/// each telemetry_avtp_AcfCanBatch and calling a handler per frame,
+/// CanIngest decodes the serialized batch (Reader::take_serialized)
+/// directly into a preallocated CanFrameRing, and consumers drain the ring
+/// in contiguous spans.
+///
+/// The layout is hand-written like the cdr_views.hpp decoders and must
+/// track the IDL:
+///   AcfCanBatch: header, stream_id, frames
+///   AcfCanFrame: header, stream_id, can_id, bus_id, flags (5 booleans),
+///                payload (sequence<octet, 64>), avtp_timestamp,
+///                sequence_num
+/// bench_can_ingest cross-checks decoded frames against the typed take.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vdr {
+
+/// One CAN or CAN-FD frame, flattened for the ring.
+struct CanFrame {
+    static constexpr size_t kMaxPayload = 64;
+
+    /// @name Bits of `flags`
+    /// @{
+    static constexpr uint8_t kExtendedId = 1 << 0;
+    static constexpr uint8_t kFd = 1 << 1;
+    static constexpr uint8_t kBitRateSwitch = 1 << 2;
+    static constexpr uint8_t kErrorState = 1 << 3;
+    static constexpr uint8_t kRemoteRequest = 1 << 4;
+    /// @}
+
+    int64_t timestamp_ns;     ///< Frame header timestamp
+    uint64_t avtp_timestamp;  ///< AVTP presentation timestamp
+    uint64_t stream_id;
+    uint32_t can_id;
+    uint32_t sequence_num;
+    uint8_t bus_id;
+    uint8_t flags;
+    uint8_t length;           ///< Valid bytes in `data`
+    uint8_t data[kMaxPayload];
+};
+
+/// Fixed-capacity single-producer/single-consumer frame ring.
+///
+/// All slots are allocated up front. The producer fills slots in place
+/// (claim(), then commit() once per batch) and the consumer drains them
+/// in at most two contiguous spans per consume(); neither side locks or
+/// allocates. When the ring is full new frames are refused rather than
+/// overwriting frames the consumer may be reading.
+class CanFrameRing {
+public:
+    /// Capacity is rounded up to a power of two.
+    explicit CanFrameRing(size_t capacity);
+
+    CanFrameRing(const CanFrameRing&) = delete;
+    CanFrameRing& operator=(const CanFrameRing&) = delete;
+
+    size_t capacity() const noexcept { return slots_.size(); }
+
+    /// Frames committed and not yet consumed.
+    size_t size() const noexcept {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /// @name Producer side
+    /// @{
+
+    /// Next free slot, or nullptr if the ring is full. The slot is not
+    /// visible to the consumer until commit().
+    CanFrame* claim() noexcept {
+        if (pending_ - cached_tail_ == slots_.size()) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (pending_ - cached_tail_ == slots_.size()) {
+                return nullptr;
+            }
+        }
+        return &slots_[pending_++ & mask_];
+    }
+
+    /// Publish every slot claimed since the last commit().
+    void commit() noexcept { head_.store(pending_, std::memory_order_release); }
+
+    /// Give back every slot claimed since the last commit().
+    void rollback() noexcept { pending_ = head_.load(std::memory_order_relaxed); }
+    /// @}
+
+    /// @name Consumer side
+    /// @{
+
+    /// Pass up to `max_frames` committed frames to `fn(const CanFrame*, size_t)`,
+    /// oldest first, in contiguous spans; returns the number consumed.
+    /// The spans are only valid inside `fn`.
+    template<typename Fn>
+    size_t consume(Fn&& fn, size_t max_frames = SIZE_MAX) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t available = head_.load(std::memory_order_acquire) - tail;
+        size_t count = available < max_frames ? available : max_frames;
+        if (count == 0) {
+            return 0;
+        }
+
+        size_t first = tail & mask_;
+        size_t first_span = slots_.size() - first;
+        if (first_span > count) {
+            first_span = count;
+        }
+        fn(&slots_[first], first_span);
+        if (count > first_span) {
+            fn(&slots_[0], count - first_span);
+        }
+
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+    /// @}
+
+private:
+    std::vector<CanFrame> slots_;
+    size_t mask_;
+
+    // Producer/consumer indices on separate cache lines; they only grow
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t pending_ = 0;      // producer: next slot to claim
+    size_t cached_tail_ = 0;  // producer: last tail_ seen
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+/// Counters of a CanIngest; each is updated once per batch.
+struct CanIngestStats {
+    uint64_t batches = 0;
+    uint64_t frames = 0;     ///< Frames committed to the ring
+    uint64_t dropped = 0;    ///< Frames refused by a full ring
+    uint64_t malformed = 0;  ///< Batches that failed to decode, none of their frames kept
+};
+
+/// Decodes serialized AcfCanBatch samples into a CanFrameRing.
+///
+/// ingest() is the ring's producer and must not be called from more than
+/// one thread at a time; stats() may be read from anywhere.
+class CanIngest {
+public:
+    explicit CanIngest(CanFrameRing& ring) : ring_(ring) {}
+
+    /// Decode one batch (CDR including the encapsulation header) and commit
+    /// its frames; returns the number of frames committed. A batch that
+    /// does not decode is discarded as a whole. Frames that do not fit
+    /// into the ring are dropped, the rest of the batch is kept.
+    size_t ingest(const uint8_t* data, size_t size);
+
+    CanIngestStats stats() const;
+
+    CanFrameRing& ring() noexcept { return ring_; }
+
+private:
+    CanFrameRing& ring_;
+
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> malformed_{0};
+};
+
+}  // namespace vdr
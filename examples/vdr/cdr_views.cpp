@@ -0,0 +1,113 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/cdr_views.hpp"
+
+namespace vdr {
+
+namespace {
+
+void read_header(dds::CdrReader& reader, HeaderView& out) {
+    out.source_id = reader.read_string();
+    out.timestamp_ns = reader.read<int64_t>();
+    out.seq_num = reader.read<uint32_t>();
+    out.correlation_id = reader.read_string();
+}
+
+bool read_value(dds::CdrReader& reader, ValueView& out) {
+    // Every scalar member is on the wire regardless of `type`
+    out.type = reader.read_enum<vss_types_ValueType>();
+    out.bool_value = reader.read<uint8_t>() != 0;
+    out.int8_value = reader.read<int8_t>();
+    out.int16_value = reader.read<int16_t>();
+    out.int32_value = reader.read<int32_t>();
+    out.int64_value = reader.read<int64_t>();
+    out.uint8_value = reader.read<uint8_t>();
+    out.uint16_value = reader.read<uint16_t>();
+    out.uint32_value = reader.read<uint32_t>();
+    out.uint64_value = reader.read<uint64_t>();
+    out.float_value = reader.read<float>();
+    out.double_value = reader.read<double>();
+    out.string_value = reader.read_string();
+
+    // Array members follow in declaration order; stop at the active one
+    switch (out.type) {
+        case vss_types_VALUE_TYPE_STRING_ARRAY:
+        case vss_types_VALUE_TYPE_STRUCT:
+        case vss_types_VALUE_TYPE_STRUCT_ARRAY:
+            return false;
+        case vss_types_VALUE_TYPE_BOOL_ARRAY:
+        case vss_types_VALUE_TYPE_INT32_ARRAY:
+        case vss_types_VALUE_TYPE_INT64_ARRAY:
+        case vss_types_VALUE_TYPE_FLOAT_ARRAY:
+        case vss_types_VALUE_TYPE_DOUBLE_ARRAY:
+            break;
+        default:
+            return true;
+    }
+
+    out.bool_array = reader.read_array<bool>();
+    if (out.type == vss_types_VALUE_TYPE_BOOL_ARRAY) return true;
+    out.int32_array = reader.read_array<int32_t>();
+    if (out.type == vss_types_VALUE_TYPE_INT32_ARRAY) return true;
+    out.int64_array = reader.read_array<int64_t>();
+    if (out.type == vss_types_VALUE_TYPE_INT64_ARRAY) return true;
+    out.float_array = reader.read_array<float>();
+    if (out.type == vss_types_VALUE_TYPE_FLOAT_ARRAY) return true;
+    out.double_array = reader.read_array<double>();
+    return true;
+}
+
+LabelRange read_labels(dds::CdrReader& reader) {
+    uint32_t count = reader.read_length();
+    dds::CdrReader first = reader;
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        reader.skip_string();
+        reader.skip_string();
+    }
+    return LabelRange(first, count);
+}
+
+}  // namespace
+
+bool decode(const uint8_t* data, size_t size, SignalView& out) {
+    dds::CdrReader reader(data, size);
+    out.path = reader.read_string();
+    read_header(reader, out.header);
+    out.quality = reader.read_enum<vss_types_Quality>();
+    bool supported = read_value(reader, out.value);
+    return supported && reader.ok();
+}
+
+bool decode(const uint8_t* data, size_t size, MetricView& out) {
+    dds::CdrReader reader(data, size);
+    out.name = reader.read_string();
+    read_header(reader, out.header);
+    out.labels = read_labels(reader);
+    out.value = reader.read<double>();
+    return reader.ok();
+}
+
+bool decode(const uint8_t* data, size_t size, ScalarMeasurementView& out) {
+    dds::CdrReader reader(data, size);
+    out.variable_id = reader.read_string();
+    read_header(reader, out.header);
+    out.unit = reader.read_string();
+    out.measurement_type = reader.read_enum<telemetry_diagnostics_MeasurementType>();
+    out.value = reader.read<double>();
+    return reader.ok();
+}
+
+}  // namespace vdr
@@ -0,0 +1,162 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file cdr_views.hpp
+/// @brief Zero-allocation views over serialized hot-path samples
+///
+/// Decodes raw CDR (from Reader::take_serialized) for vss_Signal, Gauge,
+/// Counter and ScalarMeasurement into views whose strings and arrays point
+/// into the receive buffer. Unlike the idlc-generated path, nothing is
+/// malloc'd per string; a view is valid only as long as the buffer is.
+///
+/// The layouts are hand-written and must track the IDL. Field order
+/// assumed for the libvss-types structs (final extensibility):
+///   Header:  source_id, timestamp_ns, seq_num, correlation_id
+///   Value:   type, bool_value, int8_value, int16_value, int32_value,
+///            int64_value, uint8_value, uint16_value, uint32_value,
+///            uint64_value, float_value, double_value, string_value,
+///            bool_array, int32_array, int64_array, float_array,
+///            double_array, string_array, struct_value, struct_array
+///   Signal:  path, header, quality, value
+/// bench_cdr_decode cross-checks every decoded field against
+/// ddsi_serdata_to_sample before timing, so drift shows up there.
+///
+/// decode() returns false for malformed input, for encodings other than
+/// plain XCDR1/XCDR2, and for values of string-array or struct type;
+/// callers fall back to the typed path in those cases.
+
+#include "common/cdr_reader.hpp"
+#include "telemetry.h"
+#include "vss_signal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace vdr {
+
+struct HeaderView {
+    std::string_view source_id;
+    int64_t timestamp_ns = 0;
+    uint32_t seq_num = 0;
+    std::string_view correlation_id;
+};
+
+/// Only the member selected by `type` is meaningful.
+struct ValueView {
+    vss_types_ValueType type = vss_types_VALUE_TYPE_EMPTY;
+    bool bool_value = false;
+    int8_t int8_value = 0;
+    int16_t int16_value = 0;
+    int32_t int32_value = 0;
+    int64_t int64_value = 0;
+    uint8_t uint8_value = 0;
+    uint16_t uint16_value = 0;
+    uint32_t uint32_value = 0;
+    uint64_t uint64_value = 0;
+    float float_value = 0.0f;
+    double double_value = 0.0;
+    std::string_view string_value;
+    dds::CdrArray<bool> bool_array;
+    dds::CdrArray<int32_t> int32_array;
+    dds::CdrArray<int64_t> int64_array;
+    dds::CdrArray<float> float_array;
+    dds::CdrArray<double> double_array;
+};
+
+struct SignalView {
+    std::string_view path;
+    HeaderView header;
+    vss_types_Quality quality = vss_types_QUALITY_UNKNOWN;
+    ValueView value;
+};
+
+/// Key/value labels, parsed lazily while iterating.
+class LabelRange {
+public:
+    struct Label {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    class iterator {
+    public:
+        iterator(const dds::CdrReader& reader, uint32_t remaining)
+            : reader_(reader), remaining_(remaining) { load(); }
+
+        const Label& operator*() const { return current_; }
+        const Label* operator->() const { return &current_; }
+        iterator& operator++() {
+            --remaining_;
+            load();
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return remaining_ != other.remaining_; }
+
+    private:
+        void load() {
+            if (remaining_ > 0) {
+                current_.key = reader_.read_string();
+                current_.value = reader_.read_string();
+            }
+        }
+
+        dds::CdrReader reader_;
+        uint32_t remaining_;
+        Label current_;
+    };
+
+    LabelRange() = default;
+    LabelRange(const dds::CdrReader& first, uint32_t count) : first_(first), count_(count) {}
+
+    iterator begin() const { return {first_, count_}; }
+    iterator end() const { return {first_, 0}; }
+    size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+private:
+    dds::CdrReader first_{nullptr, 0};
+    uint32_t count_ = 0;
+};
+
+/// telemetry_metrics_Gauge and telemetry_metrics_Counter share this layout.
+struct MetricView {
+    std::string_view name;
+    HeaderView header;
+    LabelRange labels;
+    double value = 0.0;
+};
+
+struct ScalarMeasurementView {
+    std::string_view variable_id;
+    HeaderView header;
+    std::string_view unit;
+    telemetry_diagnostics_MeasurementType measurement_type =
+        telemetry_diagnostics_MEASUREMENT_TYPE_ACCUMULATED;
+    double value = 0.0;
+};
+
+/// @name Decoders
+/// @param data CDR stream including the encapsulation header
+/// @return false if the sample could not be decoded as a view
+/// @{
+bool decode(const uint8_t* data, size_t size, SignalView& out);
+bool decode(const uint8_t* data, size_t size, MetricView& out);
+bool decode(const uint8_t* data, size_t size, ScalarMeasurementView& out);
+/// @}
+
+}  // namespace vdr
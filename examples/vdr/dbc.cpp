@@ -0,0 +1,143 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/dbc.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace vdr {
+
+namespace {
+
+constexpr uint32_t kExtendedIdFlag = 0x80000000u;
+
+[[noreturn]] void fail(const std::string& source, size_t line_no, const std::string& what) {
+    throw std::runtime_error(source + ":" + std::to_string(line_no) + ": " + what);
+}
+
+// "BO_ 256 DI_speed: 8 VCU"
+bool parse_message(const std::string& line, DbcMessage& out) {
+    std::istringstream in(line);
+    std::string keyword;
+    uint32_t raw_id = 0;
+    std::string name;
+    if (!(in >> keyword >> raw_id >> name)) {
+        return false;
+    }
+    if (name.back() == ':') {
+        name.pop_back();
+    } else {
+        std::string colon;
+        if (!(in >> colon) || colon != ":") {
+            return false;
+        }
+    }
+    if (name.empty() || !(in >> out.length)) {
+        return false;
+    }
+
+    out.id = raw_id & ~kExtendedIdFlag;
+    out.extended = (raw_id & kExtendedIdFlag) != 0;
+    out.name = std::move(name);
+    return true;
+}
+
+// " SG_ DI_vehicleSpeed : 0|16@1+ (0.1,0) [0|655.35] "km/h" Vector__XXX"
+bool parse_signal(const std::string& line, DbcSignal& out) {
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+
+    std::istringstream head(line.substr(0, colon));
+    std::string keyword;
+    std::string mux;
+    if (!(head >> keyword >> out.name)) {
+        return false;
+    }
+    out.multiplexed = static_cast<bool>(head >> mux);
+
+    const std::string body = line.substr(colon + 1);
+    char order = 0;
+    char sign = 0;
+    int consumed = 0;
+    if (std::sscanf(body.c_str(), " %u|%u@%c%c (%lf,%lf) [%lf|%lf]%n",
+                    &out.start_bit, &out.length, &order, &sign, &out.scale, &out.offset,
+                    &out.minimum, &out.maximum, &consumed) != 8) {
+        return false;
+    }
+    if ((order != '0' && order != '1') || (sign != '+' && sign != '-')) {
+        return false;
+    }
+    out.big_endian = order == '0';
+    out.is_signed = sign == '-';
+
+    size_t open = body.find('"', static_cast<size_t>(consumed));
+    size_t close = open == std::string::npos ? open : body.find('"', open + 1);
+    if (close != std::string::npos) {
+        out.unit = body.substr(open + 1, close - open - 1);
+    }
+    return true;
+}
+
+}  // namespace
+
+std::vector<DbcMessage> parse_dbc(std::istream& in, const std::string& source) {
+    std::vector<DbcMessage> messages;
+    std::string line;
+    size_t line_no = 0;
+
+    while (std::getline(in, line)) {
+        ++line_no;
+        size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos) {
+            continue;
+        }
+
+        if (line.compare(first, 4, "BO_ ") == 0) {
+            DbcMessage message;
+            if (!parse_message(line.substr(first), message)) {
+                fail(source, line_no, "malformed BO_ definition");
+            }
+            messages.push_back(std::move(message));
+        } else if (line.compare(first, 4, "SG_ ") == 0) {
+            if (messages.empty()) {
+                fail(source, line_no, "SG_ outside of a BO_ block");
+            }
+            DbcSignal signal;
+            if (!parse_signal(line.substr(first), signal)) {
+                fail(source, line_no, "malformed SG_ definition");
+            }
+            if (signal.length == 0 || signal.length > 64) {
+                fail(source, line_no, "signal " + signal.name + " must be 1..64 bits");
+            }
+            messages.back().signals.push_back(std::move(signal));
+        }
+    }
+    return messages;
+}
+
+std::vector<DbcMessage> load_dbc(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    return parse_dbc(in, path);
+}
+
+}  // namespace vdr
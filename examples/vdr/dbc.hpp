@@ -0,0 +1,63 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file dbc.hpp
+/// @brief Minimal reader for CAN database (DBC) files
+///
+/// Reads the message (BO_) and signal (SG_) definitions needed to decode
+/// CAN payloads, e.g. config/sample_vehicle.dbc. Everything else
+/// (comments, attributes, value tables, ...) is skipped.
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace vdr {
+
+/// One SG_ line.
+struct DbcSignal {
+    std::string name;
+    uint32_t start_bit = 0;   ///< As written: LSB (Intel) or MSB (Motorola, sawtooth numbering)
+    uint32_t length = 0;      ///< Bits, 1..64
+    bool big_endian = false;  ///< @0 (Motorola) rather than @1 (Intel)
+    bool is_signed = false;
+    double scale = 1.0;
+    double offset = 0.0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    std::string unit;
+    bool multiplexed = false; ///< Multiplexor or multiplexed signal (M / mN)
+};
+
+/// One BO_ block.
+struct DbcMessage {
+    uint32_t id = 0;          ///< CAN ID without the extended-frame flag
+    bool extended = false;    ///< 29-bit ID (bit 31 set in the DBC)
+    std::string name;
+    uint32_t length = 0;      ///< Payload bytes (DLC)
+    std::vector<DbcSignal> signals;
+};
+
+/// Parse DBC text. Throws std::runtime_error naming `source` and the line
+/// for malformed BO_ or SG_ definitions.
+std::vector<DbcMessage> parse_dbc(std::istream& in, const std::string& source = "dbc");
+
+/// Parse a DBC file; throws std::runtime_error if it cannot be read.
+std::vector<DbcMessage> load_dbc(const std::string& path);
+
+}  // namespace vdr
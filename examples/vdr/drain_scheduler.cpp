@@ -0,0 +1,138 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/drain_scheduler.hpp"
+
+#include <algorithm>
+
+namespace vdr {
+
+std::optional<Priority> parse_priority(std::string_view name) {
+    if (name == "critical") return Priority::Critical;
+    if (name == "high") return Priority::High;
+    if (name == "medium") return Priority::Medium;
+    if (name == "low") return Priority::Low;
+    return std::nullopt;
+}
+
+const char* to_string(Priority priority) {
+    switch (priority) {
+        case Priority::Critical: return "critical";
+        case Priority::High: return "high";
+        case Priority::Medium: return "medium";
+        case Priority::Low: return "low";
+    }
+    return "unknown";
+}
+
+size_t default_drain_budget(Priority priority) {
+    switch (priority) {
+        case Priority::Critical: return 0;
+        case Priority::High: return 512;
+        case Priority::Medium: return 128;
+        case Priority::Low: return 32;
+    }
+    return 32;
+}
+
+void AdaptiveBatch::update(size_t requested, size_t taken) {
+    if (taken >= requested) {
+        size_ = std::min(size_ * 2, kMax);
+    } else if (taken < requested / 4) {
+        size_ = std::max(size_ / 2, kMin);
+    }
+}
+
+dds_attach_t DrainScheduler::add(Priority priority, size_t budget,
+                                 DrainFn drain, ReadyFn ready) {
+    size_t index = entries_.size();
+    entries_.push_back(Entry{priority,
+                             budget > 0 ? budget : default_drain_budget(priority),
+                             std::move(drain), std::move(ready), {}, false});
+
+    order_.push_back(index);
+    std::stable_sort(order_.begin(), order_.end(), [this](size_t a, size_t b) {
+        return entries_[a].priority < entries_[b].priority;
+    });
+    if (priority == Priority::Critical) {
+        critical_.push_back(index);
+    }
+    return static_cast<dds_attach_t>(index);
+}
+
+void DrainScheduler::clear() {
+    entries_.clear();
+    order_.clear();
+    critical_.clear();
+}
+
+void DrainScheduler::run(const dds_attach_t* triggered, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (triggered[i] >= 0 && static_cast<size_t>(triggered[i]) < entries_.size()) {
+            entries_[static_cast<size_t>(triggered[i])].pending = true;
+        }
+    }
+
+    for (size_t index : order_) {
+        Entry& entry = entries_[index];
+        if (!entry.pending) {
+            continue;
+        }
+        entry.pending = false;
+
+        if (entry.priority == Priority::Critical) {
+            drain_all(entry);
+        } else {
+            drain_budgeted(entry);
+        }
+    }
+}
+
+void DrainScheduler::drain_all(Entry& entry) {
+    for (;;) {
+        size_t requested = entry.batch.size();
+        size_t taken = entry.drain(requested);
+        entry.batch.update(requested, taken);
+        if (taken < requested) {
+            return;
+        }
+    }
+}
+
+void DrainScheduler::drain_budgeted(Entry& entry) {
+    size_t remaining = entry.budget;
+    while (remaining > 0) {
+        preempt_critical();
+
+        size_t requested = std::min(entry.batch.size(), remaining);
+        size_t taken = entry.drain(requested);
+        entry.batch.update(requested, taken);
+        if (taken < requested) {
+            return;
+        }
+        remaining -= taken;
+    }
+}
+
+void DrainScheduler::preempt_critical() {
+    for (size_t index : critical_) {
+        Entry& entry = entries_[index];
+        if (entry.ready && entry.ready()) {
+            drain_all(entry);
+        }
+    }
+}
+
+}  // namespace vdr
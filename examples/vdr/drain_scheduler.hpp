@@ -0,0 +1,116 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file drain_scheduler.hpp
+/// @brief Priority-ordered, budgeted draining of DDS readers
+///
+/// Decides in which order and how much the receive thread takes from each
+/// triggered reader, so a flood on a low-priority topic cannot delay
+/// critical events.
+
+#include <dds/dds.h>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace vdr {
+
+/// Topic priority, as configured per subscription in vdr_config.yaml.
+enum class Priority {
+    Critical,  ///< Drained completely, before anything else
+    High,
+    Medium,
+    Low
+};
+
+/// Parse "critical" / "high" / "medium" / "low".
+std::optional<Priority> parse_priority(std::string_view name);
+
+const char* to_string(Priority priority);
+
+/// Default per-round sample budget for a priority (0 = unlimited).
+size_t default_drain_budget(Priority priority);
+
+/// Take batch size that follows the reader backlog.
+///
+/// Grows while takes come back full (a backlog is building up) and shrinks
+/// when they come back mostly empty, so idle topics take small batches and
+/// flooded topics amortize the take overhead.
+class AdaptiveBatch {
+public:
+    static constexpr size_t kMin = 8;
+    static constexpr size_t kMax = 256;
+
+    size_t size() const { return size_; }
+
+    /// Feed back the outcome of a take of `requested` samples.
+    void update(size_t requested, size_t taken);
+
+private:
+    size_t size_ = kMin;
+};
+
+/// Drains triggered readers in priority order within per-round budgets.
+///
+/// Each topic registers a drain function taking up to N samples. On every
+/// waitset wake-up, run() visits the triggered topics from critical to low:
+/// critical topics are drained until empty, every other topic takes at most
+/// its budget, and critical topics are re-checked before each lower-priority
+/// batch. Samples left over stay in the reader; its read condition keeps
+/// the waitset triggered so they are picked up next round.
+///
+/// Not thread-safe; owned by the receive thread.
+class DrainScheduler {
+public:
+    /// Take up to `max_samples`, return how many were taken.
+    using DrainFn = std::function<size_t(size_t max_samples)>;
+    /// Whether the topic has samples waiting (used to pre-empt for critical).
+    using ReadyFn = std::function<bool()>;
+
+    /// Register a topic; the returned token is what run() expects.
+    /// @param budget Samples per round, 0 for the priority default
+    dds_attach_t add(Priority priority, size_t budget, DrainFn drain, ReadyFn ready);
+
+    /// Run one scheduling round over the triggered tokens.
+    void run(const dds_attach_t* triggered, size_t count);
+
+    size_t size() const { return entries_.size(); }
+    void clear();
+
+private:
+    struct Entry {
+        Priority priority;
+        size_t budget;
+        DrainFn drain;
+        ReadyFn ready;
+        AdaptiveBatch batch;
+        bool pending = false;
+    };
+
+    void drain_all(Entry& entry);
+    void drain_budgeted(Entry& entry);
+    void preempt_critical();
+
+    std::vector<Entry> entries_;
+    std::vector<size_t> order_;     // entry indices, by priority
+    std::vector<size_t> critical_;  // entry indices of critical topics
+};
+
+}  // namespace vdr
@@ -0,0 +1,287 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/envelope.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace vdr {
+
+namespace {
+
+// Copy a sequence's buffer into the arena. Elements are first copied
+// bitwise, then `fixup` deep-copies any pointers they contain.
+template<typename Seq, typename Fixup>
+void copy_sequence(Seq& dst, const Seq& src, utils::Arena& arena, Fixup&& fixup) {
+    using Elem = std::remove_pointer_t<decltype(src._buffer)>;
+
+    dst._length = src._length;
+    dst._maximum = src._length;
+    dst._release = false;
+    dst._buffer = arena.allocate_array<Elem>(src._length);
+    if (src._length == 0) {
+        return;
+    }
+
+    std::memcpy(dst._buffer, src._buffer, sizeof(Elem) * src._length);
+    for (uint32_t i = 0; i < src._length; ++i) {
+        fixup(dst._buffer[i], src._buffer[i]);
+    }
+}
+
+// Sequence of plain values (numbers, octets, POD structs)
+template<typename Seq>
+void copy_sequence(Seq& dst, const Seq& src, utils::Arena& arena) {
+    copy_sequence(dst, src, arena, [](auto&, const auto&) {});
+}
+
+template<typename Seq>
+void clear_sequence(Seq& seq) {
+    seq._length = 0;
+    seq._maximum = 0;
+    seq._buffer = nullptr;
+    seq._release = false;
+}
+
+void copy_header(vss_types_Header& dst, const vss_types_Header& src, utils::Arena& arena) {
+    dst.source_id = arena.copy_string(src.source_id);
+    dst.correlation_id = arena.copy_string(src.correlation_id);
+}
+
+void copy_key_values(dds_sequence_vss_types_KeyValue& dst,
+                     const dds_sequence_vss_types_KeyValue& src, utils::Arena& arena) {
+    copy_sequence(dst, src, arena, [&arena](vss_types_KeyValue& d, const vss_types_KeyValue& s) {
+        d.key = arena.copy_string(s.key);
+        d.value = arena.copy_string(s.value);
+    });
+}
+
+void copy_strings(dds_sequence_string& dst, const dds_sequence_string& src, utils::Arena& arena) {
+    copy_sequence(dst, src, arena, [&arena](char*& d, char* const& s) {
+        d = arena.copy_string(s);
+    });
+}
+
+// Shared by Value and StructField, which carry the same scalar/array members.
+// Expects dst to be a bitwise copy of src; replaces every pointer member
+// with either an arena copy (active member) or null.
+template<typename V>
+void copy_value_members(V& dst, const V& src, utils::Arena& arena) {
+    dst.string_value = nullptr;
+    clear_sequence(dst.bool_array);
+    clear_sequence(dst.int32_array);
+    clear_sequence(dst.int64_array);
+    clear_sequence(dst.float_array);
+    clear_sequence(dst.double_array);
+    clear_sequence(dst.string_array);
+
+    switch (src.type) {
+        case vss_types_VALUE_TYPE_STRING:
+            dst.string_value = arena.copy_string(src.string_value);
+            break;
+        case vss_types_VALUE_TYPE_BOOL_ARRAY:
+            copy_sequence(dst.bool_array, src.bool_array, arena);
+            break;
+        case vss_types_VALUE_TYPE_INT32_ARRAY:
+            copy_sequence(dst.int32_array, src.int32_array, arena);
+            break;
+        case vss_types_VALUE_TYPE_INT64_ARRAY:
+            copy_sequence(dst.int64_array, src.int64_array, arena);
+            break;
+        case vss_types_VALUE_TYPE_FLOAT_ARRAY:
+            copy_sequence(dst.float_array, src.float_array, arena);
+            break;
+        case vss_types_VALUE_TYPE_DOUBLE_ARRAY:
+            copy_sequence(dst.double_array, src.double_array, arena);
+            break;
+        case vss_types_VALUE_TYPE_STRING_ARRAY:
+            copy_strings(dst.string_array, src.string_array, arena);
+            break;
+        default:
+            break;
+    }
+}
+
+void copy_struct_value(vss_types_StructValue& dst, const vss_types_StructValue& src,
+                       utils::Arena& arena) {
+    dst.type_name = arena.copy_string(src.type_name);
+    copy_sequence(dst.fields, src.fields, arena,
+                  [&arena](vss_types_StructField& d, const vss_types_StructField& s) {
+        d.name = arena.copy_string(s.name);
+        copy_value_members(d, s, arena);
+    });
+}
+
+void copy_value(vss_types_Value& dst, const vss_types_Value& src, utils::Arena& arena) {
+    copy_value_members(dst, src, arena);
+
+    dst.struct_value.type_name = nullptr;
+    clear_sequence(dst.struct_value.fields);
+    clear_sequence(dst.struct_array);
+
+    if (src.type == vss_types_VALUE_TYPE_STRUCT) {
+        copy_struct_value(dst.struct_value, src.struct_value, arena);
+    } else if (src.type == vss_types_VALUE_TYPE_STRUCT_ARRAY) {
+        copy_sequence(dst.struct_array, src.struct_array, arena,
+                      [&arena](vss_types_StructValue& d, const vss_types_StructValue& s) {
+            copy_struct_value(d, s, arena);
+        });
+    }
+}
+
+}  // namespace
+
+void deep_copy(vss_Signal& dst, const vss_Signal& src, utils::Arena& arena) {
+    dst = src;
+    dst.path = arena.copy_string(src.path);
+    copy_header(dst.header, src.header, arena);
+    copy_value(dst.value, src.value, arena);
+}
+
+void deep_copy(telemetry_events_Event& dst, const telemetry_events_Event& src, utils::Arena& arena) {
+    dst = src;
+    dst.event_id = arena.copy_string(src.event_id);
+    copy_header(dst.header, src.header, arena);
+    dst.category = arena.copy_string(src.category);
+    dst.event_type = arena.copy_string(src.event_type);
+    copy_key_values(dst.attributes, src.attributes, arena);
+    copy_sequence(dst.context, src.context, arena,
+                  [&arena](vss_Signal& d, const vss_Signal& s) { deep_copy(d, s, arena); });
+}
+
+void deep_copy(telemetry_diagnostics_ScalarMeasurement& dst,
+               const telemetry_diagnostics_ScalarMeasurement& src, utils::Arena& arena) {
+    dst = src;
+    dst.variable_id = arena.copy_string(src.variable_id);
+    copy_header(dst.header, src.header, arena);
+    dst.unit = arena.copy_string(src.unit);
+}
+
+void deep_copy(telemetry_diagnostics_VectorMeasurement& dst,
+               const telemetry_diagnostics_VectorMeasurement& src, utils::Arena& arena) {
+    dst = src;
+    dst.variable_id = arena.copy_string(src.variable_id);
+    copy_header(dst.header, src.header, arena);
+    dst.unit = arena.copy_string(src.unit);
+    copy_sequence(dst.values, src.values, arena);
+    copy_sequence(dst.bin_boundaries, src.bin_boundaries, arena);
+}
+
+void deep_copy(telemetry_diagnostics_MatrixMeasurement& dst,
+               const telemetry_diagnostics_MatrixMeasurement& src, utils::Arena& arena) {
+    dst = src;
+    dst.variable_id = arena.copy_string(src.variable_id);
+    copy_header(dst.header, src.header, arena);
+    dst.unit = arena.copy_string(src.unit);
+    copy_sequence(dst.values, src.values, arena);
+}
+
+void deep_copy(telemetry_metrics_Counter& dst, const telemetry_metrics_Counter& src, utils::Arena& arena) {
+    dst = src;
+    dst.name = arena.copy_string(src.name);
+    copy_header(dst.header, src.header, arena);
+    copy_key_values(dst.labels, src.labels, arena);
+}
+
+void deep_copy(telemetry_metrics_Gauge& dst, const telemetry_metrics_Gauge& src, utils::Arena& arena) {
+    dst = src;
+    dst.name = arena.copy_string(src.name);
+    copy_header(dst.header, src.header, arena);
+    copy_key_values(dst.labels, src.labels, arena);
+}
+
+void deep_copy(telemetry_metrics_Histogram& dst, const telemetry_metrics_Histogram& src, utils::Arena& arena) {
+    dst = src;
+    dst.name = arena.copy_string(src.name);
+    copy_header(dst.header, src.header, arena);
+    copy_key_values(dst.labels, src.labels, arena);
+    copy_sequence(dst.buckets, src.buckets, arena);
+}
+
+void deep_copy(telemetry_metrics_Summary& dst, const telemetry_metrics_Summary& src, utils::Arena& arena) {
+    dst = src;
+    dst.name = arena.copy_string(src.name);
+    copy_header(dst.header, src.header, arena);
+    copy_key_values(dst.labels, src.labels, arena);
+    copy_sequence(dst.quantiles, src.quantiles, arena);
+}
+
+void deep_copy(telemetry_avtp_AcfCanFrame& dst, const telemetry_avtp_AcfCanFrame& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+    copy_sequence(dst.payload, src.payload, arena);
+}
+
+void deep_copy(telemetry_avtp_AcfCanBatch& dst, const telemetry_avtp_AcfCanBatch& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+    copy_sequence(dst.frames, src.frames, arena,
+                  [&arena](telemetry_avtp_AcfCanFrame& d, const telemetry_avtp_AcfCanFrame& s) {
+        deep_copy(d, s, arena);
+    });
+}
+
+void deep_copy(telemetry_avtp_CanTrace& dst, const telemetry_avtp_CanTrace& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+    dst.trigger_event_id = arena.copy_string(src.trigger_event_id);
+    copy_sequence(dst.frames, src.frames, arena,
+                  [&arena](telemetry_avtp_AcfCanFrame& d, const telemetry_avtp_AcfCanFrame& s) {
+        deep_copy(d, s, arena);
+    });
+}
+
+void deep_copy(telemetry_avtp_StreamStats& dst, const telemetry_avtp_StreamStats& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+}
+
+void deep_copy(telemetry_logs_LogEntry& dst, const telemetry_logs_LogEntry& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+    dst.component = arena.copy_string(src.component);
+    dst.message = arena.copy_string(src.message);
+    copy_key_values(dst.fields, src.fields, arena);
+}
+
+void deep_copy(telemetry_opaque_FreezeFrame& dst, const telemetry_opaque_FreezeFrame& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+    dst.frame_type = arena.copy_string(src.frame_type);
+    dst.trigger_event_id = arena.copy_string(src.trigger_event_id);
+    copy_sequence(dst.payload, src.payload, arena);
+    copy_key_values(dst.metadata, src.metadata, arena);
+}
+
+void deep_copy(telemetry_opaque_StateSnapshot& dst, const telemetry_opaque_StateSnapshot& src, utils::Arena& arena) {
+    dst = src;
+    copy_header(dst.header, src.header, arena);
+    dst.component_id = arena.copy_string(src.component_id);
+    dst.state_type = arena.copy_string(src.state_type);
+    copy_sequence(dst.payload, src.payload, arena);
+}
+
+void deep_copy(telemetry_security_Incident& dst, const telemetry_security_Incident& src, utils::Arena& arena) {
+    dst = src;
+    dst.incident_id = arena.copy_string(src.incident_id);
+    copy_header(dst.header, src.header, arena);
+    dst.incident_type = arena.copy_string(src.incident_type);
+    dst.description = arena.copy_string(src.description);
+    copy_key_values(dst.indicators, src.indicators, arena);
+    copy_sequence(dst.raw_evidence, src.raw_evidence, arena);
+}
+
+}  // namespace vdr
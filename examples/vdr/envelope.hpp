@@ -0,0 +1,112 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file envelope.hpp
+/// @brief Owning, arena-backed copies of DDS samples
+///
+/// A sample obtained from take_each() or a loan points into DDS-managed
+/// memory and is only valid inside the callback. deep_copy() clones a
+/// sample - strings, sequences and nested structs - into an Arena so it can
+/// outlive the loan and cross threads. EnvelopeBatch<T> bundles the arena
+/// with the copied messages; clearing or destroying the batch releases all
+/// of them at once.
+///
+/// Copies are plain IDL structs and can be passed to any OutputSink::send().
+/// Their sequences have _release == false: never hand them to
+/// dds_sample_free().
+
+#include "common/arena.hpp"
+#include "telemetry.h"
+#include "vss_signal.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace vdr {
+
+/// @name Deep copy into an arena
+/// Only the active member of a vss_types_Value (selected by its type) is
+/// copied; inactive pointer members are left null.
+/// @{
+void deep_copy(vss_Signal& dst, const vss_Signal& src, utils::Arena& arena);
+void deep_copy(telemetry_events_Event& dst, const telemetry_events_Event& src, utils::Arena& arena);
+void deep_copy(telemetry_diagnostics_ScalarMeasurement& dst,
+               const telemetry_diagnostics_ScalarMeasurement& src, utils::Arena& arena);
+void deep_copy(telemetry_diagnostics_VectorMeasurement& dst,
+               const telemetry_diagnostics_VectorMeasurement& src, utils::Arena& arena);
+void deep_copy(telemetry_diagnostics_MatrixMeasurement& dst,
+               const telemetry_diagnostics_MatrixMeasurement& src, utils::Arena& arena);
+void deep_copy(telemetry_metrics_Counter& dst, const telemetry_metrics_Counter& src, utils::Arena& arena);
+void deep_copy(telemetry_metrics_Gauge& dst, const telemetry_metrics_Gauge& src, utils::Arena& arena);
+void deep_copy(telemetry_metrics_Histogram& dst, const telemetry_metrics_Histogram& src, utils::Arena& arena);
+void deep_copy(telemetry_metrics_Summary& dst, const telemetry_metrics_Summary& src, utils::Arena& arena);
+void deep_copy(telemetry_avtp_AcfCanFrame& dst, const telemetry_avtp_AcfCanFrame& src, utils::Arena& arena);
+void deep_copy(telemetry_avtp_AcfCanBatch& dst, const telemetry_avtp_AcfCanBatch& src, utils::Arena& arena);
+void deep_copy(telemetry_avtp_CanTrace& dst, const telemetry_avtp_CanTrace& src, utils::Arena& arena);
+void deep_copy(telemetry_avtp_StreamStats& dst, const telemetry_avtp_StreamStats& src, utils::Arena& arena);
+void deep_copy(telemetry_logs_LogEntry& dst, const telemetry_logs_LogEntry& src, utils::Arena& arena);
+void deep_copy(telemetry_opaque_FreezeFrame& dst, const telemetry_opaque_FreezeFrame& src, utils::Arena& arena);
+void deep_copy(telemetry_opaque_StateSnapshot& dst, const telemetry_opaque_StateSnapshot& src, utils::Arena& arena);
+void deep_copy(telemetry_security_Incident& dst, const telemetry_security_Incident& src, utils::Arena& arena);
+/// @}
+
+/// Batch of deep-copied messages sharing one arena.
+///
+/// Typical use: fill from a take_each() callback, move to a worker thread,
+/// process, then clear() and reuse. Not thread-safe; hand the whole batch
+/// over rather than sharing it.
+template<typename T>
+class EnvelopeBatch {
+public:
+    explicit EnvelopeBatch(size_t arena_block_size = utils::Arena::kDefaultBlockSize)
+        : arena_(arena_block_size) {}
+
+    EnvelopeBatch(EnvelopeBatch&&) noexcept = default;
+    EnvelopeBatch& operator=(EnvelopeBatch&&) noexcept = default;
+
+    EnvelopeBatch(const EnvelopeBatch&) = delete;
+    EnvelopeBatch& operator=(const EnvelopeBatch&) = delete;
+
+    /// Deep-copy a sample into the batch
+    const T& add(const T& sample) {
+        messages_.emplace_back();
+        deep_copy(messages_.back(), sample, arena_);
+        return messages_.back();
+    }
+
+    const T& operator[](size_t i) const { return messages_[i]; }
+    typename std::vector<T>::const_iterator begin() const { return messages_.begin(); }
+    typename std::vector<T>::const_iterator end() const { return messages_.end(); }
+
+    size_t size() const noexcept { return messages_.size(); }
+    bool empty() const noexcept { return messages_.empty(); }
+
+    /// Bytes of string/sequence payload held in the arena
+    size_t arena_bytes() const noexcept { return arena_.bytes_used(); }
+
+    /// Drop all messages; arena blocks and vector capacity are kept
+    void clear() noexcept {
+        messages_.clear();
+        arena_.reset();
+    }
+
+private:
+    utils::Arena arena_;
+    std::vector<T> messages_;
+};
+
+}  // namespace vdr
@@ -0,0 +1,133 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/lua_transform.hpp"
+
+#include <lua.hpp>
+
+#include <stdexcept>
+
+namespace vdr {
+
+namespace {
+
+// Builtins keep their state in the per-signal `state` table
+constexpr const char* kPrelude = R"lua(
+function lowpass(v, alpha)
+  if state.__lowpass == nil then state.__lowpass = v
+  else state.__lowpass = state.__lowpass + alpha * (v - state.__lowpass) end
+  return state.__lowpass
+end
+
+function moving_average(v, n)
+  local buf = state.__moving_average
+  if buf == nil then buf = {}; state.__moving_average = buf end
+  buf[#buf + 1] = v
+  if #buf > n then table.remove(buf, 1) end
+  local sum = 0
+  for i = 1, #buf do sum = sum + buf[i] end
+  return sum / #buf
+end
+
+function derivative(v)
+  local d = 0
+  if state.__derivative_v ~= nil and now_ns > state.__derivative_t then
+    d = (v - state.__derivative_v) * 1e9 / (now_ns - state.__derivative_t)
+  end
+  state.__derivative_v = v
+  state.__derivative_t = now_ns
+  return d
+end
+
+function threshold(v, low, high)
+  if v < low then return low elseif v > high then return high end
+  return v
+end
+
+function sustained_condition(cond, ms)
+  if not cond then state.__sustained_since = nil; return false end
+  if state.__sustained_since == nil then state.__sustained_since = now_ns end
+  return now_ns - state.__sustained_since >= ms * 1e6
+end
+)lua";
+
+}  // namespace
+
+LuaTransform::LuaTransform(const std::string& code) : lua_(luaL_newstate()) {
+    if (lua_ == nullptr) {
+        throw std::runtime_error("luaL_newstate failed");
+    }
+    luaL_openlibs(lua_);
+
+    lua_newtable(lua_);
+    lua_setglobal(lua_, "state");
+    lua_newtable(lua_);
+    lua_setglobal(lua_, "deps");
+    if (luaL_dostring(lua_, kPrelude) != 0) {
+        std::string error = lua_tostring(lua_, -1);
+        lua_close(lua_);
+        throw std::runtime_error("transform prelude: " + error);
+    }
+
+    std::string chunk = code.find("return") == std::string::npos ? "return " + code : code;
+    if (luaL_loadbuffer(lua_, chunk.data(), chunk.size(), "transform") != 0) {
+        std::string error = lua_tostring(lua_, -1);
+        lua_close(lua_);
+        throw std::invalid_argument(error);
+    }
+    function_ref_ = luaL_ref(lua_, LUA_REGISTRYINDEX);
+}
+
+LuaTransform::~LuaTransform() {
+    lua_close(lua_);
+}
+
+void LuaTransform::set_dependency(const std::string& path, double value) {
+    lua_getglobal(lua_, "deps");
+    lua_pushnumber(lua_, value);
+    lua_setfield(lua_, -2, path.c_str());
+    lua_pop(lua_, 1);
+}
+
+bool LuaTransform::apply(double x, int64_t timestamp_ns, double& out) {
+    lua_pushnumber(lua_, x);
+    lua_setglobal(lua_, "x");
+    lua_pushinteger(lua_, static_cast<lua_Integer>(timestamp_ns));
+    lua_setglobal(lua_, "now_ns");
+
+    lua_rawgeti(lua_, LUA_REGISTRYINDEX, function_ref_);
+    if (lua_pcall(lua_, 0, 1, 0) != 0) {
+        ++errors_;
+        lua_pop(lua_, 1);
+        return false;
+    }
+
+    bool produced = true;
+    switch (lua_type(lua_, -1)) {
+        case LUA_TNUMBER:
+            out = lua_tonumber(lua_, -1);
+            break;
+        case LUA_TBOOLEAN:
+            out = lua_toboolean(lua_, -1) ? 1.0 : 0.0;
+            break;
+        default:
+            produced = false;
+            break;
+    }
+    lua_pop(lua_, 1);
+    return produced;
+}
+
+}  // namespace vdr
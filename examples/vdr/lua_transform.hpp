@@ -0,0 +1,63 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file lua_transform.hpp
+/// @brief Lua fallback for custom vssdag transform code
+///
+/// Only built with VDR_HAS_LUA_TRANSFORMS. Each transform owns a Lua state
+/// in which the snippet runs with the vssdag globals:
+///   x       the decoded value, or for a derived signal the value of the
+///           dependency that triggered it
+///   deps    latest value of each dependency (derived signals), by VSS path
+///   state   table kept across samples of this signal
+/// plus Lua versions of the builtins (lowpass, moving_average, derivative,
+/// threshold, sustained_condition), each assuming one call site per
+/// snippet. A snippet without `return` is treated as an expression.
+
+#include <cstdint>
+#include <string>
+
+struct lua_State;
+
+namespace vdr {
+
+class LuaTransform {
+public:
+    /// Throws std::invalid_argument if the code does not compile.
+    explicit LuaTransform(const std::string& code);
+    ~LuaTransform();
+
+    LuaTransform(const LuaTransform&) = delete;
+    LuaTransform& operator=(const LuaTransform&) = delete;
+
+    /// Run the snippet for one sample. A number or boolean result is
+    /// written to `out`; nil and runtime errors drop the sample.
+    bool apply(double x, int64_t timestamp_ns, double& out);
+
+    /// Set `deps[path]` for the following apply() calls.
+    void set_dependency(const std::string& path, double value);
+
+    /// Runtime errors so far.
+    uint64_t errors() const noexcept { return errors_; }
+
+private:
+    lua_State* lua_;
+    int function_ref_;
+    uint64_t errors_ = 0;
+};
+
+}  // namespace vdr
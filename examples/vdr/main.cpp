@@ -20,17 +20,32 @@
 /// In this PoC, "offboarding" means logging what would be sent via MQTT.
 
 #include "common/dds_wrapper.hpp"
+#include "vdr/can_decoder.hpp"
 #include "vdr/subscriber.hpp"
 #include "vdr/output_sink.hpp"
+#include "vdr/sinks/batch_compressor.hpp"
+#include "vdr/sinks/composite_sink.hpp"
 #include "vdr/sinks/log_sink.hpp"
+#include "vdr/sinks/null_sink.hpp"
+#include "vdr/sinks/payload_format.hpp"
+#include "vdr/sinks/topic_batcher.hpp"
+#include "vdr/vssdag_mapping.hpp"
+#ifdef VDR_HAS_MQTT_SINK
+#include "vdr/sinks/mqtt_sink.hpp"
+#endif
 
 #include <glog/logging.h>
 #include <yaml-cpp/yaml.h>
 
 #include <csignal>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace {
 
@@ -41,35 +56,243 @@ void signal_handler(int signum) {
     g_running = false;
 }
 
-vdr::SubscriptionConfig load_config(const std::string& config_path) {
-    vdr::SubscriptionConfig config;
+// Apply one `subscriptions:` entry to its topic settings
+void load_topic_config(const YAML::Node& node, vdr::TopicConfig& topic) {
+    topic.enabled = node["enabled"].as<bool>(topic.enabled);
+    topic.drain_budget = node["drain_budget"].as<size_t>(topic.drain_budget);
+
+    if (node["priority"]) {
+        std::string name = node["priority"].as<std::string>();
+        if (auto priority = vdr::parse_priority(name)) {
+            topic.priority = *priority;
+        } else {
+            LOG(WARNING) << "Unknown priority '" << name << "', keeping "
+                         << vdr::to_string(topic.priority);
+        }
+    }
+
+    if (node["dispatch"]) {
+        std::string name = node["dispatch"].as<std::string>();
+        if (auto dispatch = vdr::parse_dispatch(name)) {
+            topic.dispatch = *dispatch;
+        } else {
+            LOG(WARNING) << "Unknown dispatch '" << name << "', keeping "
+                         << vdr::to_string(topic.dispatch);
+        }
+    }
+
+    // Reader QoS: applied as a whole, or not at all if invalid
+    vdr::TopicQos qos = topic.qos;
+    if (node["qos"]) {
+        std::string name = node["qos"].as<std::string>();
+        if (auto profile = vdr::parse_qos_profile(name)) {
+            qos.profile = *profile;
+        } else {
+            LOG(WARNING) << "Unknown qos profile '" << name << "', keeping "
+                         << vdr::to_string(qos.profile);
+        }
+    }
+    qos.history_depth = node["buffer_size"].as<int32_t>(qos.history_depth);
+    qos.max_samples = node["max_samples"].as<int32_t>(qos.max_samples);
+    qos.max_instances = node["max_instances"].as<int32_t>(qos.max_instances);
+
+    if (auto error = vdr::validate(qos)) {
+        LOG(ERROR) << "Invalid QoS for " << node["topic"].as<std::string>("?") << ": "
+                   << *error << ". Keeping defaults.";
+    } else {
+        topic.qos = qos;
+    }
+}
+
+// One `sinks:` entry
+struct SinkEntry {
+    std::string type;
+    vdr::sinks::SinkQueueConfig queue;
+
+    // type mqtt only
+    std::string host = "localhost";
+    int port = 1883;
+    std::string topic_prefix = "vdr/v1";
+    vdr::sinks::PayloadFormat format = vdr::sinks::PayloadFormat::Json;
+    std::map<std::string, vdr::sinks::PayloadFormat, std::less<>> topic_formats{};
+};
+
+struct VdrConfig {
+    dds_domainid_t domain_id = DDS_DOMAIN_DEFAULT;
+    vdr::SubscriptionConfig subscriptions;
+    std::vector<SinkEntry> sinks = {{"log", {}}};
+    vdr::sinks::BatchConfig batch;  // offboard: section, for the mqtt sink
+    vdr::sinks::CompressionConfig compression;
+    size_t can_ring_frames = 16384;
+
+    // DBC file and vssdag probe config for decoding CAN frames to VSS
+    std::string can_dbc;
+    std::string can_mapping;
+};
+
+// Highest domain ID usable with the default RTPS port mapping
+constexpr int64_t kMaxDomainId = 232;
+
+VdrConfig load_config(const std::string& config_path) {
+    VdrConfig loaded;
+    vdr::SubscriptionConfig& config = loaded.subscriptions;
 
     try {
         YAML::Node yaml = YAML::LoadFile(config_path);
 
+        if (yaml["domain_id"]) {
+            auto domain_id = yaml["domain_id"].as<int64_t>();
+            if (domain_id >= 0 && domain_id <= kMaxDomainId) {
+                loaded.domain_id = static_cast<dds_domainid_t>(domain_id);
+            } else {
+                LOG(WARNING) << "domain_id " << domain_id << " out of range [0, "
+                             << kMaxDomainId << "], using the default domain";
+            }
+        }
+
         if (yaml["subscriptions"]) {
             for (const auto& sub : yaml["subscriptions"]) {
                 std::string topic = sub["topic"].as<std::string>("");
-                bool enabled = sub["enabled"].as<bool>(true);
 
                 if (topic == "rt/vss/signals") {
-                    config.vss_signals = enabled;
+                    load_topic_config(sub, config.vss_signals);
+                    config.signal_paths =
+                        sub["paths"].as<std::vector<std::string>>(config.signal_paths);
                 } else if (topic == "rt/events/vehicle") {
-                    config.events = enabled;
+                    load_topic_config(sub, config.events);
                 } else if (topic == "rt/telemetry/gauges") {
-                    config.gauges = enabled;
+                    load_topic_config(sub, config.gauges);
                 } else if (topic == "rt/telemetry/counters") {
-                    config.counters = enabled;
+                    load_topic_config(sub, config.counters);
                 } else if (topic == "rt/telemetry/histograms") {
-                    config.histograms = enabled;
+                    load_topic_config(sub, config.histograms);
                 } else if (topic == "rt/logs/entries") {
-                    config.logs = enabled;
+                    load_topic_config(sub, config.logs);
                 } else if (topic == "rt/diagnostics/scalar") {
-                    config.scalar_measurements = enabled;
+                    load_topic_config(sub, config.scalar_measurements);
                 } else if (topic == "rt/diagnostics/vector") {
-                    config.vector_measurements = enabled;
+                    load_topic_config(sub, config.vector_measurements);
+                } else if (topic == "rt/opaque/freeze_frames") {
+                    load_topic_config(sub, config.freeze_frames);
+                } else if (topic == "rt/avtp/can/batches") {
+                    load_topic_config(sub, config.can_batches);
+                    loaded.can_ring_frames =
+                        sub["ring_frames"].as<size_t>(loaded.can_ring_frames);
+                } else if (topic == "rt/avtp/can/traces") {
+                    load_topic_config(sub, config.can_traces);
+                }
+            }
+        }
+
+        if (yaml["signal_rules"]) {
+            for (const auto& rule : yaml["signal_rules"]) {
+                vdr::SignalRule parsed;
+                parsed.path = rule["path"].as<std::string>("");
+                parsed.max_hz = rule["offboard_max_hz"].as<double>(0.0);
+                if (parsed.path.empty() || parsed.max_hz < 0.0) {
+                    LOG(WARNING) << "Ignoring invalid signal rule '" << parsed.path << "'";
+                    continue;
+                }
+                config.signal_rules.push_back(std::move(parsed));
+            }
+        }
+
+        if (yaml["sinks"]) {
+            loaded.sinks.clear();
+            for (const auto& node : yaml["sinks"]) {
+                SinkEntry entry;
+                entry.type = node["type"].as<std::string>("");
+                entry.queue.capacity = node["queue_capacity"].as<size_t>(entry.queue.capacity);
+                entry.queue.block_timeout = std::chrono::milliseconds(
+                    node["block_timeout_ms"].as<int64_t>(entry.queue.block_timeout.count()));
+                if (node["overflow"]) {
+                    std::string name = node["overflow"].as<std::string>();
+                    if (auto policy = vdr::sinks::parse_overflow_policy(name)) {
+                        entry.queue.overflow = *policy;
+                    } else {
+                        LOG(WARNING) << "Unknown overflow policy '" << name << "', keeping "
+                                     << vdr::sinks::to_string(entry.queue.overflow);
+                    }
+                }
+                entry.host = node["host"].as<std::string>(entry.host);
+                entry.port = node["port"].as<int>(entry.port);
+                entry.topic_prefix = node["topic_prefix"].as<std::string>(entry.topic_prefix);
+                auto parse_format = [](const YAML::Node& value, vdr::sinks::PayloadFormat& out) {
+                    std::string name = value.as<std::string>();
+                    if (auto format = vdr::sinks::parse_payload_format(name)) {
+                        out = *format;
+                    } else {
+                        LOG(WARNING) << "Unknown payload format '" << name << "', keeping "
+                                     << vdr::sinks::to_string(out);
+                    }
+                };
+                if (node["format"]) {
+                    parse_format(node["format"], entry.format);
+                }
+                if (node["topic_formats"]) {
+                    for (const auto& topic : node["topic_formats"]) {
+                        vdr::sinks::PayloadFormat format = entry.format;
+                        parse_format(topic.second, format);
+                        entry.topic_formats[topic.first.as<std::string>()] = format;
+                    }
+                }
+                loaded.sinks.push_back(std::move(entry));
+            }
+        }
+
+        if (const YAML::Node offboard = yaml["offboard"]) {
+            vdr::sinks::BatchConfig& batch = loaded.batch;
+            batch.max_messages = offboard["batch_size"].as<size_t>(batch.max_messages);
+            batch.max_bytes = offboard["max_batch_bytes"].as<size_t>(batch.max_bytes);
+            batch.flush_interval = std::chrono::milliseconds(
+                offboard["flush_interval_ms"].as<int64_t>(batch.flush_interval.count()));
+            batch.critical_flush_interval = std::chrono::milliseconds(
+                offboard["critical_flush_interval_ms"].as<int64_t>(
+                    batch.critical_flush_interval.count()));
+            if (offboard["critical_topics"]) {
+                batch.critical_topics =
+                    offboard["critical_topics"].as<std::vector<std::string>>();
+            }
+
+            vdr::sinks::CompressionConfig& compression = loaded.compression;
+            if (offboard["compression"]) {
+                std::string name = offboard["compression"].as<std::string>();
+                auto algorithm = vdr::sinks::parse_compression(name);
+                if (!algorithm) {
+                    LOG(WARNING) << "Unknown compression '" << name
+                                 << "', sending batches uncompressed";
+                } else if (!vdr::sinks::compression_available(*algorithm)) {
+                    LOG(WARNING) << "VDR built without " << name
+                                 << ", sending batches uncompressed";
+                } else {
+                    compression.algorithm = *algorithm;
                 }
             }
+            compression.min_bytes =
+                offboard["compression_min_bytes"].as<size_t>(compression.min_bytes);
+            if (offboard["compression_levels"]) {
+                compression.levels.clear();
+                for (const auto& tier : offboard["compression_levels"]) {
+                    compression.levels.push_back(
+                        {tier.first.as<size_t>(), tier.second.as<int>()});
+                }
+                std::sort(compression.levels.begin(), compression.levels.end(),
+                          [](const auto& a, const auto& b) { return a.min_bytes < b.min_bytes; });
+            }
+            if (compression.algorithm != vdr::sinks::Compression::None &&
+                offboard["compression_dictionary"]) {
+                try {
+                    compression.dictionary = vdr::sinks::load_compression_dictionary(
+                        offboard["compression_dictionary"].as<std::string>());
+                } catch (const std::runtime_error& e) {
+                    LOG(ERROR) << e.what() << ", compressing without a dictionary";
+                }
+            }
+        }
+
+        if (yaml["can_decode"]) {
+            loaded.can_dbc = yaml["can_decode"]["dbc"].as<std::string>("");
+            loaded.can_mapping = yaml["can_decode"]["mapping"].as<std::string>("");
         }
 
         LOG(INFO) << "Loaded configuration from " << config_path;
@@ -78,7 +301,51 @@ vdr::SubscriptionConfig load_config(const std::string& config_path) {
                      << ": " << e.what() << ". Using defaults.";
     }
 
-    return config;
+    return loaded;
+}
+
+std::unique_ptr<vdr::OutputSink> make_sink(const SinkEntry& entry, const VdrConfig& config) {
+    if (entry.type == "log") return std::make_unique<vdr::sinks::LogSink>();
+    if (entry.type == "null") return std::make_unique<vdr::sinks::NullSink>();
+#ifdef VDR_HAS_MQTT_SINK
+    if (entry.type == "mqtt") {
+        vdr::sinks::MqttConfig mqtt;
+        mqtt.host = entry.host;
+        mqtt.port = entry.port;
+        mqtt.topic_prefix = entry.topic_prefix;
+        mqtt.batch = config.batch;
+        mqtt.compression = config.compression;
+        mqtt.format = entry.format;
+        mqtt.topic_formats = entry.topic_formats;
+        LOG(INFO) << "MQTT batches: up to " << mqtt.batch.max_messages << " messages / "
+                  << mqtt.batch.max_bytes << " bytes, flushed after "
+                  << mqtt.batch.flush_interval.count() << " ms ("
+                  << mqtt.batch.critical_flush_interval.count() << " ms for critical topics)";
+        if (mqtt.compression.algorithm != vdr::sinks::Compression::None) {
+            LOG(INFO) << "MQTT batches compressed with "
+                      << vdr::sinks::to_string(mqtt.compression.algorithm)
+                      << (mqtt.compression.dictionary.empty() ? "" : " and a trained dictionary")
+                      << " from " << mqtt.compression.min_bytes << " bytes";
+        }
+        return std::make_unique<vdr::sinks::MqttSink>(mqtt);
+    }
+#else
+    (void)config;
+#endif
+    return nullptr;
+}
+
+void log_topic_config(const char* name, const vdr::TopicConfig& topic) {
+    if (!topic.enabled) {
+        LOG(INFO) << "  " << name << ": disabled";
+        return;
+    }
+    LOG(INFO) << "  " << name << ": enabled, priority "
+              << vdr::to_string(topic.priority) << ", dispatch "
+              << vdr::to_string(topic.dispatch) << ", qos "
+              << vdr::to_string(topic.qos.profile) << " depth "
+              << topic.qos.history_depth << " max_samples "
+              << topic.qos.max_samples << " max_instances " << topic.qos.max_instances;
 }
 
 }  // namespace
@@ -101,83 +368,167 @@ int main(int argc, char* argv[]) {
         config_path = argv[1];
     }
 
-    auto config = load_config(config_path);
+    auto loaded = load_config(config_path);
+    const vdr::SubscriptionConfig& config = loaded.subscriptions;
 
     // Log configuration
     LOG(INFO) << "Subscription config:";
-    LOG(INFO) << "  vss_signals: " << (config.vss_signals ? "enabled" : "disabled");
-    LOG(INFO) << "  events: " << (config.events ? "enabled" : "disabled");
-    LOG(INFO) << "  gauges: " << (config.gauges ? "enabled" : "disabled");
-    LOG(INFO) << "  counters: " << (config.counters ? "enabled" : "disabled");
-    LOG(INFO) << "  histograms: " << (config.histograms ? "enabled" : "disabled");
-    LOG(INFO) << "  logs: " << (config.logs ? "enabled" : "disabled");
-    LOG(INFO) << "  scalar_measurements: " << (config.scalar_measurements ? "enabled" : "disabled");
-    LOG(INFO) << "  vector_measurements: " << (config.vector_measurements ? "enabled" : "disabled");
+    log_topic_config("vss_signals", config.vss_signals);
+    if (!config.signal_paths.empty()) {
+        LOG(INFO) << "    paths: " << config.signal_paths.size() << " patterns";
+    }
+    for (const auto& rule : config.signal_rules) {
+        LOG(INFO) << "    " << rule.path << ": max " << rule.max_hz << " Hz";
+    }
+    log_topic_config("events", config.events);
+    log_topic_config("gauges", config.gauges);
+    log_topic_config("counters", config.counters);
+    log_topic_config("histograms", config.histograms);
+    log_topic_config("logs", config.logs);
+    log_topic_config("scalar_measurements", config.scalar_measurements);
+    log_topic_config("vector_measurements", config.vector_measurements);
+    log_topic_config("can_batches", config.can_batches);
+    if (config.can_batches.enabled) {
+        LOG(INFO) << "    ring: " << loaded.can_ring_frames << " frames";
+        if (!loaded.can_dbc.empty()) {
+            LOG(INFO) << "    decode: " << loaded.can_dbc << " via " << loaded.can_mapping;
+        }
+    }
+    log_topic_config("freeze_frames", config.freeze_frames);
+    log_topic_config("can_traces", config.can_traces);
 
     try {
         // Create DDS participant
-        dds::Participant participant(DDS_DOMAIN_DEFAULT);
-
-        // Create output sink (default: LogSink)
-        auto sink = std::make_unique<vdr::sinks::LogSink>();
-        if (!sink->start()) {
+        dds::Participant participant(loaded.domain_id);
+
+        // Every configured sink runs behind its own queue and worker thread,
+        // so none of them can stall the receive thread
+        auto sink = std::make_unique<vdr::sinks::CompositeSink>();
+        for (const auto& entry : loaded.sinks) {
+            if (auto child = make_sink(entry, loaded)) {
+                LOG(INFO) << "Sink " << child->name() << ": queue " << entry.queue.capacity
+                          << ", overflow " << vdr::sinks::to_string(entry.queue.overflow);
+                sink->add(std::move(child), entry.queue);
+            } else {
+                LOG(WARNING) << "Unknown sink type '" << entry.type << "', ignored";
+            }
+        }
+        if (sink->size() == 0 || !sink->start()) {
             LOG(FATAL) << "Failed to start output sink";
             return 1;
         }
 
+        // CAN batches are unpacked into a preallocated frame ring; declared
+        // first so the receive thread stops before they go away
+        vdr::CanFrameRing can_ring(config.can_batches.enabled ? loaded.can_ring_frames : 1);
+        vdr::CanIngest can_ingest(can_ring);
+
+        std::unique_ptr<vdr::CanDecoder> can_decoder;
+        if (config.can_batches.enabled && !loaded.can_dbc.empty()) {
+            try {
+                can_decoder = std::make_unique<vdr::CanDecoder>(
+                    vdr::load_dbc(loaded.can_dbc), vdr::load_vssdag_mappings(loaded.can_mapping));
+                LOG(INFO) << "Decoding " << can_decoder->signal_count() << " CAN signals";
+                for (const auto& name : can_decoder->unmapped()) {
+                    LOG(WARNING) << "CAN signal " << name << " not found in " << loaded.can_dbc
+                                 << ", not decodable, or missing a dependency";
+                }
+            } catch (const std::exception& e) {
+                LOG(ERROR) << "CAN decoding disabled: " << e.what();
+            }
+        }
+
         // Create subscription manager
         vdr::SubscriptionManager subscriptions(participant, config);
 
-        // Register callbacks - each forwards to sink
-        subscriptions.on_vss_signal([&sink](const telemetry_vss_Signal& msg) {
-            sink->send(msg);
-        });
-
-        subscriptions.on_event([&sink](const telemetry_events_Event& msg) {
-            sink->send(msg);
+        // Every typed topic forwards each take to the sink's matching
+        // send_batch() overload
+        vdr::subscribe_all_batches(subscriptions, config, [&sink](auto batch) {
+            sink->send_batch(batch);
         });
 
-        subscriptions.on_gauge([&sink](const telemetry_metrics_Gauge& msg) {
-            sink->send(msg);
-        });
+        subscriptions.ingest_can(can_ingest);
 
-        subscriptions.on_counter([&sink](const telemetry_metrics_Counter& msg) {
-            sink->send(msg);
-        });
-
-        subscriptions.on_histogram([&sink](const telemetry_metrics_Histogram& msg) {
-            sink->send(msg);
-        });
-
-        subscriptions.on_log_entry([&sink](const telemetry_logs_LogEntry& msg) {
-            sink->send(msg);
-        });
-
-        subscriptions.on_scalar_measurement([&sink](const telemetry_diagnostics_ScalarMeasurement& msg) {
-            sink->send(msg);
-        });
-
-        subscriptions.on_vector_measurement([&sink](const telemetry_diagnostics_VectorMeasurement& msg) {
-            sink->send(msg);
-        });
+        // Bulk topics bypass deserialization when the sink can take raw CDR
+        if (sink->accepts_serialized()) {
+            subscriptions.on_serialized([&sink](const vdr::SerializedMessage& msg) {
+                sink->send_serialized(msg);
+            });
+        } else if (config.freeze_frames.enabled || config.can_traces.enabled) {
+            LOG(WARNING) << sink->name() << " does not accept serialized samples; "
+                         << "freeze frames and CAN traces will not be forwarded";
+        }
 
         // Start receiving
         subscriptions.start();
 
         LOG(INFO) << "VDR running. Press Ctrl+C to stop.";
 
-        // Main loop - just wait for signal
+        // Main loop - wait for signal. The CAN ring is drained here: frames
+        // are counted per bus and, with a DBC, decoded into VSS signals.
+        std::array<uint64_t, 32> can_frames_per_bus{};
+        auto drain_can = [&] {
+            can_ring.consume([&](const vdr::CanFrame* frames, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    ++can_frames_per_bus[frames[i].bus_id % can_frames_per_bus.size()];
+                }
+                if (can_decoder) {
+                    can_decoder->decode(frames, count, [&sink](const vss_Signal& msg) {
+                        sink->send(msg);
+                    });
+                }
+            });
+        };
         while (g_running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            drain_can();
         }
 
-        // Stop subscriptions and sink
+        // Stop subscriptions, decode the last CAN frames while the sink is
+        // still running, then stop the sink
         subscriptions.stop();
+        drain_can();
         sink->stop();
 
+        if (!config.signal_paths.empty() || !config.signal_rules.empty()) {
+            auto filter = subscriptions.signal_filter_stats();
+            LOG(INFO) << "Signal path filter: " << filter.accepted << " accepted, "
+                      << filter.rejected << " rejected";
+        }
+
+        if (config.can_batches.enabled) {
+            auto can = can_ingest.stats();
+            LOG(INFO) << "CAN ingest: " << can.batches << " batches, " << can.frames
+                      << " frames, " << can.dropped << " dropped, " << can.malformed
+                      << " malformed";
+            if (can_decoder) {
+                const auto& decoded = can_decoder->stats();
+                LOG(INFO) << "CAN decode: " << decoded.frames << " frames, " << decoded.signals
+                          << " signals, " << decoded.filtered << " dropped by transforms, "
+                          << decoded.unknown << " unknown IDs, " << decoded.short_frames
+                          << " short frames";
+            }
+            for (size_t bus = 0; bus < can_frames_per_bus.size(); ++bus) {
+                if (can_frames_per_bus[bus] > 0) {
+                    LOG(INFO) << "  bus " << bus << ": " << can_frames_per_bus[bus] << " frames";
+                }
+            }
+        }
+
+        for (const auto& lane : sink->lane_stats()) {
+            LOG(INFO) << "Sink " << lane.sink << ": " << lane.delivered << " delivered, "
+                      << lane.dropped << " dropped on overflow, max queue " << lane.max_depth
+                      << ", max lag " << lane.max_lag_ns / 1000 << " us";
+        }
+
         auto stats = sink->stats();
         LOG(INFO) << "VDR shutdown complete. Messages sent: " << stats.messages_sent
                   << ", failed: " << stats.messages_failed;
+        if (stats.bytes_compressed > 0) {
+            LOG(INFO) << "Compression: " << stats.bytes_uncompressed << " -> "
+                      << stats.bytes_compressed << " bytes (ratio " << stats.compression_ratio()
+                      << "), " << stats.compress_cpu_ms_per_mb() << " ms CPU per MiB";
+        }
 
     } catch (const dds::Error& e) {
         LOG(FATAL) << "DDS error: " << e.what();
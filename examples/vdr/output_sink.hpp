@@ -21,9 +21,11 @@
 /// OutputSink defines the contract for message output. Implementations
 /// can target different backends: logging, MQTT, cloud APIs, etc.
 
+#include "common/span.hpp"
 #include "telemetry.h"
 #include "vss_signal.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -36,6 +38,41 @@ struct SinkStats {
     uint64_t messages_failed = 0;
     uint64_t bytes_sent = 0;
     uint64_t last_send_timestamp_ns = 0;
+
+    /// @name Payload compression (zero unless the sink compresses)
+    /// Counted over every payload offered to the compressor, including
+    /// those too small to compress, so the ratio is the saving on the link.
+    /// @{
+    uint64_t bytes_uncompressed = 0;  ///< Payload bytes before compression
+    uint64_t bytes_compressed = 0;    ///< The same payloads as sent
+    uint64_t compress_cpu_ns = 0;     ///< Thread CPU time spent compressing
+
+    /// Uncompressed / compressed bytes; 1 when nothing was compressed.
+    double compression_ratio() const {
+        return bytes_compressed > 0
+                   ? static_cast<double>(bytes_uncompressed) / static_cast<double>(bytes_compressed)
+                   : 1.0;
+    }
+
+    /// CPU milliseconds per MiB of uncompressed input.
+    double compress_cpu_ms_per_mb() const {
+        return bytes_uncompressed > 0 ? static_cast<double>(compress_cpu_ns) / 1e6 /
+                                            (static_cast<double>(bytes_uncompressed) / 1048576.0)
+                                      : 0.0;
+    }
+    /// @}
+};
+
+/// A sample forwarded without deserialization.
+///
+/// `data` is the CDR stream as received from DDS, including its 4-byte
+/// encapsulation header, and is only valid during send_serialized().
+struct SerializedMessage {
+    const char* topic;          ///< DDS topic name
+    const char* type_name;      ///< IDL type name, e.g. "telemetry::opaque::FreezeFrame"
+    const uint8_t* data;
+    size_t size;
+    int64_t source_timestamp_ns;
 };
 
 /// Abstract interface for output destinations.
@@ -65,6 +102,42 @@ public:
     virtual void send(const telemetry_diagnostics_VectorMeasurement& msg) = 0;
     /// @}
 
+    /// @name Batch sending
+    /// The valid samples of one take, in order, valid only during the call.
+    /// The defaults call send() per message; sinks override them to take
+    /// locks, set up encoders and push to queues once per batch. A sink
+    /// overriding only some overloads needs `using OutputSink::send_batch;`
+    /// to keep the others visible.
+    /// @{
+    virtual void send_batch(utils::Span<const vss_Signal> msgs) { send_each(msgs); }
+    virtual void send_batch(utils::Span<const telemetry_events_Event> msgs) { send_each(msgs); }
+    virtual void send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) { send_each(msgs); }
+    virtual void send_batch(utils::Span<const telemetry_metrics_Counter> msgs) {
+        send_each(msgs);
+    }
+    virtual void send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) {
+        send_each(msgs);
+    }
+    virtual void send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) { send_each(msgs); }
+    virtual void send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) {
+        send_each(msgs);
+    }
+    virtual void send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) {
+        send_each(msgs);
+    }
+    /// @}
+
+    /// @name Serialized passthrough
+    /// Sinks that only store or forward bytes (recorders, spools) can take
+    /// bulk topics as raw CDR and skip the deserialize/re-encode round trip.
+    /// @{
+
+    /// @return true if send_serialized() is implemented
+    virtual bool accepts_serialized() const { return false; }
+
+    virtual void send_serialized(const SerializedMessage& /*msg*/) {}
+    /// @}
+
     /// Flush any buffered messages. Default is no-op for unbuffered sinks.
     virtual void flush() {}
 
@@ -77,6 +150,14 @@ public:
 
     /// Get sink name for logging/debugging.
     virtual std::string name() const = 0;
+
+private:
+    template<typename T>
+    void send_each(utils::Span<const T> msgs) {
+        for (const T& msg : msgs) {
+            send(msg);
+        }
+    }
 };
 
 /// Factory function type for creating sinks
@@ -0,0 +1,77 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/signal_rates.hpp"
+
+#include <algorithm>
+
+namespace vdr {
+
+SignalRates::SignalRates(const std::vector<std::string>& paths,
+                         const std::vector<SignalRule>& rules)
+    : all_paths_(paths.empty()), rates_{0.0} {
+    for (const auto& pattern : paths) {
+        paths_.add(pattern);
+    }
+
+    // Distinct limited rates, slowest first, become groups 1..N
+    for (const auto& rule : rules) {
+        if (rule.max_hz > 0.0 &&
+            std::find(rates_.begin() + 1, rates_.end(), rule.max_hz) == rates_.end()) {
+            rates_.push_back(rule.max_hz);
+        }
+    }
+    std::sort(rates_.begin() + 1, rates_.end());
+
+    for (const auto& rule : rules) {
+        int group = 0;
+        if (rule.max_hz > 0.0) {
+            group = static_cast<int>(
+                std::find(rates_.begin() + 1, rates_.end(), rule.max_hz) - rates_.begin());
+        }
+        rules_.push_back({utils::PathFilter{rule.path}, group});
+    }
+}
+
+int SignalRates::group_for(std::string_view path) const {
+    if (!all_paths_ && !paths_.matches(path)) {
+        return kNotReceived;
+    }
+    for (const auto& rule : rules_) {
+        if (rule.filter.matches(path)) {
+            return rule.group;
+        }
+    }
+    return 0;
+}
+
+bool RateLimiter::admit(std::string_view path, int64_t timestamp_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = last_ns_.find(path);
+    if (it == last_ns_.end()) {
+        last_ns_.emplace(paths_.emplace_back(path), timestamp_ns);
+        return true;
+    }
+
+    int64_t elapsed = timestamp_ns - it->second;
+    if (elapsed >= 0 && elapsed < min_separation_ns_) {
+        return false;
+    }
+    it->second = timestamp_ns;
+    return true;
+}
+
+}  // namespace vdr
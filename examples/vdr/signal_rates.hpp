@@ -0,0 +1,100 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file signal_rates.hpp
+/// @brief Per-signal offboard rates for rt/vss/signals
+///
+/// Maps VSS paths to the reader group that receives them, following the
+/// signal_rules section of vdr_config.yaml (see SPECIFICATION.md). Each
+/// distinct offboard_max_hz gets its own DDS reader, downsampled inside
+/// DDS, so the VDR never takes samples it would throw away.
+
+#include "common/path_filter.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vdr {
+
+/// One signal_rules entry.
+struct SignalRule {
+    std::string path;     ///< utils::PathFilter pattern
+    double max_hz = 0.0;  ///< Offboard rate limit, 0 = full rate
+};
+
+/// Routes VSS paths to rate groups.
+///
+/// Group 0 receives paths at full rate; groups 1..N correspond to the
+/// distinct max_hz values of the rules, slowest first. The first rule
+/// matching a path decides its group. Immutable after construction, so
+/// group_for() may be called from any DDS thread.
+class SignalRates {
+public:
+    static constexpr int kNotReceived = -1;
+
+    /// `paths` restricts what is received at all (empty = everything).
+    SignalRates(const std::vector<std::string>& paths, const std::vector<SignalRule>& rules);
+
+    /// Group receiving `path`, or kNotReceived.
+    int group_for(std::string_view path) const;
+
+    /// Number of groups, including the full-rate group 0.
+    size_t group_count() const { return rates_.size(); }
+
+    /// Rate of a group in Hz (0 for group 0).
+    double max_hz(size_t group) const { return rates_[group]; }
+
+    /// True if every received path goes to group 0 unfiltered.
+    bool trivial() const { return all_paths_ && rules_.empty(); }
+
+private:
+    struct Rule {
+        utils::PathFilter filter;
+        int group;
+    };
+
+    utils::PathFilter paths_;
+    bool all_paths_;
+    std::vector<Rule> rules_;
+    std::vector<double> rates_;
+};
+
+/// Per-path minimum separation, on sample timestamps.
+///
+/// admit() accepts a sample if at least `min_separation_ns` passed since
+/// the last accepted sample of the same path. A timestamp going backwards
+/// (publisher restart) is accepted and restarts the interval. Thread-safe.
+class RateLimiter {
+public:
+    explicit RateLimiter(int64_t min_separation_ns) : min_separation_ns_(min_separation_ns) {}
+
+    bool admit(std::string_view path, int64_t timestamp_ns);
+
+private:
+    int64_t min_separation_ns_;
+
+    std::mutex mutex_;
+    std::deque<std::string> paths_;  // Key storage, stable addresses
+    std::unordered_map<std::string_view, int64_t> last_ns_;
+};
+
+}  // namespace vdr
@@ -0,0 +1,332 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/signal_transforms.hpp"
+
+#ifdef VDR_HAS_LUA_TRANSFORMS
+#include "vdr/lua_transform.hpp"
+#endif
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+
+namespace vdr {
+
+#ifndef VDR_HAS_LUA_TRANSFORMS
+// Never instantiated; completes the type for std::unique_ptr
+class LuaTransform {};
+#endif
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+std::optional<double> parse_number(std::string_view s) {
+    std::string text(trim(s));
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (end != text.c_str() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// "x > 0", "x ~= 3"
+bool parse_comparison(std::string_view s, CompareOp& op, double& operand) {
+    s = trim(s);
+    if (s.empty() || s.front() != 'x') {
+        return false;
+    }
+    s = trim(s.substr(1));
+
+    static constexpr std::pair<std::string_view, CompareOp> kOps[] = {
+        {">=", CompareOp::GreaterEqual}, {"<=", CompareOp::LessEqual},
+        {"==", CompareOp::Equal},        {"~=", CompareOp::NotEqual},
+        {">", CompareOp::Greater},       {"<", CompareOp::Less},
+    };
+    for (const auto& [token, parsed] : kOps) {
+        if (s.substr(0, token.size()) == token) {
+            auto number = parse_number(s.substr(token.size()));
+            if (!number) {
+                return false;
+            }
+            op = parsed;
+            operand = *number;
+            return true;
+        }
+    }
+    return false;
+}
+
+// "name(arg, arg, ...)" with no nested calls
+bool parse_call(std::string_view s, std::string_view& name, std::vector<std::string_view>& args) {
+    s = trim(s);
+    size_t open = s.find('(');
+    if (open == std::string_view::npos || s.back() != ')') {
+        return false;
+    }
+    name = trim(s.substr(0, open));
+    std::string_view inner = s.substr(open + 1, s.size() - open - 2);
+    if (inner.find_first_of("()") != std::string_view::npos) {
+        return false;
+    }
+
+    args.clear();
+    size_t start = 0;
+    while (true) {
+        size_t comma = inner.find(',', start);
+        args.push_back(trim(inner.substr(start, comma - start)));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return true;
+}
+
+bool compare(CompareOp op, double x, double operand) {
+    switch (op) {
+        case CompareOp::Greater: return x > operand;
+        case CompareOp::GreaterEqual: return x >= operand;
+        case CompareOp::Less: return x < operand;
+        case CompareOp::LessEqual: return x <= operand;
+        case CompareOp::Equal: return x == operand;
+        case CompareOp::NotEqual: return x != operand;
+    }
+    return false;
+}
+
+}  // namespace
+
+TransformSpec parse_transform_code(std::string_view code) {
+    TransformSpec spec;
+    code = trim(code);
+
+    if (code == "x") {
+        return spec;
+    }
+    if (parse_comparison(code, spec.op, spec.operand)) {
+        spec.kind = TransformKind::Compare;
+        return spec;
+    }
+
+    std::string_view name;
+    std::vector<std::string_view> args;
+    if (parse_call(code, name, args) && !args.empty() && args[0] == "x") {
+        if (name == "lowpass" && args.size() == 2) {
+            if (auto alpha = parse_number(args[1])) {
+                spec.kind = TransformKind::Lowpass;
+                spec.alpha = *alpha;
+                return spec;
+            }
+        } else if (name == "moving_average" && args.size() == 2) {
+            if (auto window = parse_number(args[1])) {
+                spec.kind = TransformKind::MovingAverage;
+                // Casting a negative, NaN or out-of-range double is undefined;
+                // anything but a whole count in range stays 0 and is rejected
+                // by SignalTransform
+                if (*window >= 1 && *window <= kMaxMovingAverageWindow &&
+                    *window == std::floor(*window)) {
+                    spec.window = static_cast<size_t>(*window);
+                }
+                return spec;
+            }
+        } else if (name == "derivative" && args.size() == 1) {
+            spec.kind = TransformKind::Derivative;
+            return spec;
+        } else if (name == "threshold" && args.size() == 3) {
+            auto low = parse_number(args[1]);
+            auto high = parse_number(args[2]);
+            if (low && high) {
+                spec.kind = TransformKind::Threshold;
+                spec.low = *low;
+                spec.high = *high;
+                return spec;
+            }
+        }
+    } else if (parse_call(code, name, args) && name == "sustained_condition" &&
+               args.size() == 2 && parse_comparison(args[0], spec.op, spec.operand)) {
+        auto ms = parse_number(args[1]);
+        if (ms && *ms >= 0 && *ms <= 1e9) {  // up to ~11 days; keeps the cast defined
+            spec.kind = TransformKind::SustainedCondition;
+            spec.hold_ns = static_cast<int64_t>(*ms * 1e6);
+            return spec;
+        }
+    }
+
+    spec = {};
+    spec.kind = TransformKind::Lua;
+    spec.code = std::string(code);
+    return spec;
+}
+
+const char* to_string(TransformKind kind) {
+    switch (kind) {
+        case TransformKind::Identity: return "identity";
+        case TransformKind::Lowpass: return "lowpass";
+        case TransformKind::MovingAverage: return "moving_average";
+        case TransformKind::Derivative: return "derivative";
+        case TransformKind::Threshold: return "threshold";
+        case TransformKind::Compare: return "compare";
+        case TransformKind::SustainedCondition: return "sustained_condition";
+        case TransformKind::ValueMap: return "value_map";
+        case TransformKind::Lua: return "lua";
+    }
+    return "unknown";
+}
+
+SignalTransform::SignalTransform(const TransformSpec& spec) : spec_(spec) {
+    switch (spec_.kind) {
+        case TransformKind::Lowpass:
+            if (!(spec_.alpha > 0.0 && spec_.alpha <= 1.0)) {
+                throw std::invalid_argument("lowpass alpha must be in (0, 1]");
+            }
+            break;
+        case TransformKind::MovingAverage:
+            if (spec_.window == 0 || spec_.window > kMaxMovingAverageWindow) {
+                throw std::invalid_argument("moving_average window must be a whole number in [1, " +
+                                            std::to_string(kMaxMovingAverageWindow) + "]");
+            }
+            history_.assign(spec_.window, 0.0);
+            break;
+        case TransformKind::Threshold:
+            if (spec_.low > spec_.high) {
+                throw std::invalid_argument("threshold low exceeds high");
+            }
+            break;
+        case TransformKind::Lua:
+#ifdef VDR_HAS_LUA_TRANSFORMS
+            lua_ = std::make_unique<LuaTransform>(spec_.code);
+            break;
+#else
+            throw std::invalid_argument("custom transform code needs Lua, not built in");
+#endif
+        default:
+            break;
+    }
+}
+
+SignalTransform::~SignalTransform() = default;
+SignalTransform::SignalTransform(SignalTransform&&) noexcept = default;
+SignalTransform& SignalTransform::operator=(SignalTransform&&) noexcept = default;
+
+bool SignalTransform::lua_available() {
+#ifdef VDR_HAS_LUA_TRANSFORMS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SignalTransform::set_dependency(const std::string& path, double value) {
+#ifdef VDR_HAS_LUA_TRANSFORMS
+    if (lua_) {
+        lua_->set_dependency(path, value);
+    }
+#else
+    (void)path;
+    (void)value;
+#endif
+}
+
+bool SignalTransform::apply_stateful(double x, int64_t timestamp_ns, double& out) {
+    switch (spec_.kind) {
+        case TransformKind::Identity:
+            out = x;
+            return true;
+
+        case TransformKind::Lowpass:
+            last_ = primed_ ? last_ + spec_.alpha * (x - last_) : x;
+            primed_ = true;
+            out = last_;
+            return true;
+
+        case TransformKind::MovingAverage:
+            if (filled_ == history_.size()) {
+                sum_ -= history_[next_];
+            } else {
+                ++filled_;
+            }
+            history_[next_] = x;
+            sum_ += x;
+            next_ = next_ + 1 == history_.size() ? 0 : next_ + 1;
+            out = sum_ / static_cast<double>(filled_);
+            return true;
+
+        case TransformKind::Derivative:
+            // 0 for the first sample and for non-increasing timestamps
+            out = primed_ && timestamp_ns > last_ns_
+                      ? (x - last_) * 1e9 / static_cast<double>(timestamp_ns - last_ns_)
+                      : 0.0;
+            primed_ = true;
+            last_ = x;
+            last_ns_ = timestamp_ns;
+            return true;
+
+        case TransformKind::Threshold:
+            out = x < spec_.low ? spec_.low : (x > spec_.high ? spec_.high : x);
+            return true;
+
+        case TransformKind::Compare:
+            out = compare(spec_.op, x, spec_.operand) ? 1.0 : 0.0;
+            return true;
+
+        case TransformKind::SustainedCondition:
+            if (!compare(spec_.op, x, spec_.operand)) {
+                primed_ = false;
+                out = 0.0;
+                return true;
+            }
+            if (!primed_) {
+                primed_ = true;
+                last_ns_ = timestamp_ns;
+            }
+            out = timestamp_ns - last_ns_ >= spec_.hold_ns ? 1.0 : 0.0;
+            return true;
+
+        case TransformKind::ValueMap:
+            for (const auto& [from, to] : spec_.value_map) {
+                if (from == x) {
+                    out = to;
+                    return true;
+                }
+            }
+            return false;
+
+        case TransformKind::Lua:
+#ifdef VDR_HAS_LUA_TRANSFORMS
+            return lua_->apply(x, timestamp_ns, out);
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+}  // namespace vdr
@@ -0,0 +1,134 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file signal_transforms.hpp
+/// @brief Native versions of the common vssdag signal transforms
+///
+/// vssdag_probe_config.yaml attaches a Lua snippet or a value_map to each
+/// signal. The common single-expression forms are recognized and run as
+/// compiled, stateful filters:
+///   lowpass(x, alpha)            y += alpha * (x - y)
+///   moving_average(x, n)         mean of the last n samples
+///   derivative(x)                change per second of sample time
+///   threshold(x, low, high)      clamp to [low, high]
+///   x > k  (>=, <, <=, ==, ~=)   1 or 0
+///   sustained_condition(x > k, ms)
+///                                1 once the comparison held for ms
+///   value_map                    exact lookup; unmapped values are dropped
+/// Anything else is custom code and needs the Lua fallback, which is only
+/// built when Lua is found (VDR_HAS_LUA_TRANSFORMS). Snippets of derived
+/// signals read their dependencies from `deps`, which only Lua provides.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vdr {
+
+enum class TransformKind {
+    Identity,
+    Lowpass,
+    MovingAverage,
+    Derivative,
+    Threshold,
+    Compare,
+    SustainedCondition,
+    ValueMap,
+    Lua  ///< Custom code
+};
+
+enum class CompareOp { Greater, GreaterEqual, Less, LessEqual, Equal, NotEqual };
+
+/// Largest moving_average window; history is preallocated per signal.
+constexpr size_t kMaxMovingAverageWindow = 65536;
+
+/// A parsed transform; which members are used depends on `kind`.
+struct TransformSpec {
+    TransformKind kind = TransformKind::Identity;
+    double alpha = 0.0;       ///< Lowpass
+    size_t window = 0;        ///< MovingAverage
+    double low = 0.0;         ///< Threshold
+    double high = 0.0;        ///< Threshold
+    CompareOp op = CompareOp::Greater;  ///< Compare, SustainedCondition
+    double operand = 0.0;     ///< Compare, SustainedCondition
+    int64_t hold_ns = 0;      ///< SustainedCondition
+    std::vector<std::pair<double, double>> value_map;
+    std::string code;         ///< Lua source, for Lua
+};
+
+/// Recognize a `transform.code` snippet; unrecognized code yields kind Lua.
+TransformSpec parse_transform_code(std::string_view code);
+
+const char* to_string(TransformKind kind);
+
+class LuaTransform;
+
+/// One signal's transform and its state.
+///
+/// Native transforms allocate only in the constructor. Not thread-safe.
+class SignalTransform {
+public:
+    /// Throws std::invalid_argument for invalid parameters, or for Lua
+    /// code when the Lua fallback is not built in or the code does not
+    /// compile.
+    explicit SignalTransform(const TransformSpec& spec = {});
+    ~SignalTransform();
+
+    SignalTransform(SignalTransform&&) noexcept;
+    SignalTransform& operator=(SignalTransform&&) noexcept;
+
+    /// True if this build can run custom (Lua) transforms.
+    static bool lua_available();
+
+    TransformKind kind() const noexcept { return spec_.kind; }
+
+    /// Transform sample `x` taken at `timestamp_ns`. Returns false if the
+    /// sample produces no output.
+    bool apply(double x, int64_t timestamp_ns, double& out) {
+        if (spec_.kind == TransformKind::Identity) {
+            out = x;
+            return true;
+        }
+        return apply_stateful(x, timestamp_ns, out);
+    }
+
+    /// Latest value of dependency `path`, seen by Lua code as
+    /// `deps[path]`. Native transforms only see `x`.
+    void set_dependency(const std::string& path, double value);
+
+private:
+    bool apply_stateful(double x, int64_t timestamp_ns, double& out);
+
+    TransformSpec spec_;
+
+    // Filter state
+    bool primed_ = false;
+    double last_ = 0.0;
+    int64_t last_ns_ = 0;
+    std::vector<double> history_;  // MovingAverage ring
+    size_t filled_ = 0;
+    size_t next_ = 0;
+    double sum_ = 0.0;
+
+    std::unique_ptr<LuaTransform> lua_;
+};
+
+}  // namespace vdr
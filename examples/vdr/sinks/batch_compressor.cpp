@@ -0,0 +1,386 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/batch_compressor.hpp"
+#include "vdr/sinks/topic_batcher.hpp"
+
+#ifdef VDR_HAS_ZSTD
+#include <zstd.h>
+#endif
+#ifdef VDR_HAS_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+// Message section + compressed header fields
+constexpr size_t kCompressedHeaderSize = kBatchHeaderSize + 4;
+constexpr size_t kDictionaryIdSize = 4;
+
+// Refuse to inflate batches claiming more than this
+constexpr uint32_t kMaxUncompressedSection = 1u << 30;
+
+// Magic of dictionaries in zstd's format (ZDICT_trainFromBuffer output);
+// the dictionary id follows it, both little-endian
+constexpr uint32_t kZstdDictionaryMagic = 0xEC30A437;
+
+uint32_t read_u32_be(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) |
+           uint32_t(p[3]);
+}
+
+void write_u32_be(char* p, uint32_t value) {
+    p[0] = static_cast<char>(value >> 24);
+    p[1] = static_cast<char>(value >> 16);
+    p[2] = static_cast<char>(value >> 8);
+    p[3] = static_cast<char>(value);
+}
+
+uint32_t read_u32_le(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+           (uint32_t(p[3]) << 24);
+}
+
+#ifdef VDR_HAS_LZ4
+// LZ4 only looks back 64 KiB, so only a dictionary's tail is used
+std::string_view lz4_window(std::string_view dictionary) {
+    return dictionary.substr(dictionary.size() - std::min<size_t>(dictionary.size(), 64 * 1024));
+}
+#endif
+
+bool inflate_zstd(const uint8_t* src, size_t src_size, char* dst, size_t dst_size,
+                  std::string_view dictionary) {
+#ifdef VDR_HAS_ZSTD
+    std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    size_t n = ZSTD_decompress_usingDict(dctx.get(), dst, dst_size, src, src_size,
+                                         dictionary.data(), dictionary.size());
+    return !ZSTD_isError(n) && n == dst_size;
+#else
+    (void)src, (void)src_size, (void)dst, (void)dst_size, (void)dictionary;
+    return false;
+#endif
+}
+
+bool inflate_lz4(const uint8_t* src, size_t src_size, char* dst, size_t dst_size,
+                 std::string_view dictionary) {
+#ifdef VDR_HAS_LZ4
+    if (src_size > LZ4_MAX_INPUT_SIZE || dst_size > LZ4_MAX_INPUT_SIZE) {
+        return false;
+    }
+    std::string_view window = lz4_window(dictionary);
+    int n = LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(src), dst,
+                                          static_cast<int>(src_size), static_cast<int>(dst_size),
+                                          window.data(), static_cast<int>(window.size()));
+    return n >= 0 && static_cast<size_t>(n) == dst_size;
+#else
+    (void)src, (void)src_size, (void)dst, (void)dst_size, (void)dictionary;
+    return false;
+#endif
+}
+
+}  // namespace
+
+std::optional<Compression> parse_compression(std::string_view name) {
+    if (name == "none") return Compression::None;
+    if (name == "zstd") return Compression::Zstd;
+    if (name == "lz4") return Compression::Lz4;
+    return std::nullopt;
+}
+
+const char* to_string(Compression compression) {
+    switch (compression) {
+        case Compression::None: return "none";
+        case Compression::Zstd: return "zstd";
+        case Compression::Lz4: return "lz4";
+    }
+    return "unknown";
+}
+
+bool compression_available(Compression compression) {
+    switch (compression) {
+        case Compression::None: return true;
+#ifdef VDR_HAS_ZSTD
+        case Compression::Zstd: return true;
+#endif
+#ifdef VDR_HAS_LZ4
+        case Compression::Lz4: return true;
+#endif
+        default: return false;
+    }
+}
+
+std::string load_compression_dictionary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open compression dictionary " + path);
+    }
+    std::string dictionary((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (in.bad() || dictionary.empty()) {
+        throw std::runtime_error("cannot read compression dictionary " + path);
+    }
+    return dictionary;
+}
+
+uint32_t compression_dictionary_id(std::string_view dictionary) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(dictionary.data());
+    if (dictionary.size() >= 8 && read_u32_le(bytes) == kZstdDictionaryMagic) {
+        uint32_t id = read_u32_le(bytes + 4);
+        if (id != 0) {
+            return id;
+        }
+    }
+    // FNV-1a of raw content dictionaries
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte : dictionary) {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+BatchCompressor::BatchCompressor(CompressionConfig config) : config_(std::move(config)) {
+    if (config_.levels.empty()) {
+        config_.levels.push_back({0, 1});
+    }
+    if (!compression_available(config_.algorithm)) {
+        throw std::invalid_argument(std::string("built without ") +
+                                    to_string(config_.algorithm) + " support");
+    }
+    if (!config_.dictionary.empty()) {
+        dictionary_id_ = compression_dictionary_id(config_.dictionary);
+    }
+
+#ifdef VDR_HAS_ZSTD
+    if (config_.algorithm == Compression::Zstd) {
+        zstd_ = ZSTD_createCCtx();
+        // Size and dictionary id are in the batch header already
+        ZSTD_CCtx_setParameter(zstd_, ZSTD_c_contentSizeFlag, 0);
+        ZSTD_CCtx_setParameter(zstd_, ZSTD_c_dictIDFlag, 0);
+        if (!config_.dictionary.empty()) {
+            for (const auto& tier : config_.levels) {
+                ZSTD_CDict* cdict = ZSTD_createCDict(config_.dictionary.data(),
+                                                     config_.dictionary.size(), tier.level);
+                if (!cdict) {
+                    release();
+                    throw std::runtime_error("zstd rejected the compression dictionary");
+                }
+                zstd_dictionaries_.push_back(cdict);
+            }
+        }
+    }
+#endif
+#ifdef VDR_HAS_LZ4
+    if (config_.algorithm == Compression::Lz4) {
+        lz4_ = LZ4_createStream();
+        lz4hc_ = LZ4_createStreamHC();
+        std::string_view window = lz4_window(config_.dictionary);
+        if (!window.empty()) {
+            lz4_dictionary_ = LZ4_createStream();
+            LZ4_loadDict(lz4_dictionary_, window.data(), static_cast<int>(window.size()));
+        }
+    }
+#endif
+}
+
+BatchCompressor::~BatchCompressor() {
+    release();
+}
+
+void BatchCompressor::release() noexcept {
+#ifdef VDR_HAS_ZSTD
+    for (ZSTD_CDict* cdict : zstd_dictionaries_) {
+        ZSTD_freeCDict(cdict);
+    }
+    zstd_dictionaries_.clear();
+    ZSTD_freeCCtx(zstd_);
+    zstd_ = nullptr;
+#endif
+#ifdef VDR_HAS_LZ4
+    LZ4_freeStream(lz4_);
+    LZ4_freeStream(lz4_dictionary_);
+    LZ4_freeStreamHC(lz4hc_);
+    lz4_ = nullptr;
+    lz4_dictionary_ = nullptr;
+    lz4hc_ = nullptr;
+#endif
+}
+
+size_t BatchCompressor::tier_for(size_t size) const noexcept {
+    size_t tier = 0;
+    for (size_t i = 0; i < config_.levels.size(); ++i) {
+        if (size >= config_.levels[i].min_bytes) {
+            tier = i;
+        }
+    }
+    return tier;
+}
+
+int BatchCompressor::level_for(size_t size) const noexcept {
+    return config_.levels[tier_for(size)].level;
+}
+
+std::string_view BatchCompressor::compress(std::string_view batch, std::string& out) {
+    if (!enabled() || batch.size() < config_.min_bytes || batch.size() < kBatchHeaderSize ||
+        batch[3] != 0) {
+        return batch;
+    }
+    const char* section = batch.data() + kBatchHeaderSize;
+    size_t section_size = batch.size() - kBatchHeaderSize;
+    bool with_dictionary = !config_.dictionary.empty();
+    size_t header_size = kCompressedHeaderSize + (with_dictionary ? kDictionaryIdSize : 0);
+    size_t tier = tier_for(batch.size());
+
+    // Worth it only if header and compressed section undercut the original
+    if (batch.size() <= header_size) {
+        return batch;
+    }
+    size_t capacity = batch.size() - header_size - 1;
+    out.resize(header_size + capacity);
+    char* dst = out.data() + header_size;
+    size_t compressed = 0;
+    if (config_.algorithm == Compression::Zstd) {
+        compressed = compress_zstd(section, section_size, dst, capacity, tier);
+    } else if (config_.algorithm == Compression::Lz4) {
+        compressed = compress_lz4(section, section_size, dst, capacity,
+                                  config_.levels[tier].level);
+    }
+    if (compressed == 0) {
+        return batch;
+    }
+
+    std::memcpy(out.data(), batch.data(), kBatchHeaderSize);
+    out[3] = static_cast<char>(static_cast<uint8_t>(config_.algorithm) |
+                               (with_dictionary ? kBatchFlagDictionary : 0));
+    write_u32_be(out.data() + kBatchHeaderSize, static_cast<uint32_t>(section_size));
+    if (with_dictionary) {
+        write_u32_be(out.data() + kCompressedHeaderSize, dictionary_id_);
+    }
+    out.resize(header_size + compressed);
+    return out;
+}
+
+size_t BatchCompressor::compress_zstd(const char* src, size_t size, char* dst, size_t capacity,
+                                      size_t tier) {
+#ifdef VDR_HAS_ZSTD
+    if (zstd_dictionaries_.empty()) {
+        ZSTD_CCtx_setParameter(zstd_, ZSTD_c_compressionLevel, config_.levels[tier].level);
+    } else {
+        ZSTD_CCtx_refCDict(zstd_, zstd_dictionaries_[tier]);
+    }
+    size_t n = ZSTD_compress2(zstd_, dst, capacity, src, size);
+    return ZSTD_isError(n) ? 0 : n;
+#else
+    (void)src, (void)size, (void)dst, (void)capacity, (void)tier;
+    return 0;
+#endif
+}
+
+size_t BatchCompressor::compress_lz4(const char* src, size_t size, char* dst, size_t capacity,
+                                     int level) {
+#ifdef VDR_HAS_LZ4
+    if (size > LZ4_MAX_INPUT_SIZE) {
+        return 0;
+    }
+    std::string_view window = lz4_window(config_.dictionary);
+    int n;
+    if (level <= 1) {
+        // Copying the preloaded state is cheaper than hashing the
+        // dictionary again for every batch
+        if (lz4_dictionary_) {
+            std::memcpy(lz4_, lz4_dictionary_, sizeof(LZ4_stream_t));
+        } else {
+            LZ4_resetStream_fast(lz4_);
+        }
+        n = LZ4_compress_fast_continue(lz4_, src, dst, static_cast<int>(size),
+                                       static_cast<int>(capacity), 1);
+    } else {
+        LZ4_resetStreamHC_fast(lz4hc_, level);
+        if (!window.empty()) {
+            LZ4_loadDictHC(lz4hc_, window.data(), static_cast<int>(window.size()));
+        }
+        n = LZ4_compress_HC_continue(lz4hc_, src, dst, static_cast<int>(size),
+                                     static_cast<int>(capacity));
+    }
+    return n > 0 ? static_cast<size_t>(n) : 0;
+#else
+    (void)src, (void)size, (void)dst, (void)capacity, (void)level;
+    return 0;
+#endif
+}
+
+bool decompress_batch(const uint8_t* data, size_t size, std::string& out,
+                      std::string_view dictionary) {
+    if (size < kBatchHeaderSize || data[0] != 'V' || data[1] != 'B' ||
+        data[2] != kBatchVersion) {
+        return false;
+    }
+    uint8_t flags = data[3];
+    if (flags & ~(kBatchCompressionMask | kBatchFlagDictionary)) {
+        return false;
+    }
+    auto algorithm = static_cast<Compression>(flags & kBatchCompressionMask);
+    if (algorithm == Compression::None) {
+        if (flags != 0) {
+            return false;
+        }
+        out.assign(reinterpret_cast<const char*>(data), size);
+        return true;
+    }
+
+    bool with_dictionary = flags & kBatchFlagDictionary;
+    size_t header_size = kCompressedHeaderSize + (with_dictionary ? kDictionaryIdSize : 0);
+    if (size < header_size) {
+        return false;
+    }
+    uint32_t section_size = read_u32_be(data + kBatchHeaderSize);
+    if (section_size > kMaxUncompressedSection) {
+        return false;
+    }
+    if (with_dictionary) {
+        if (dictionary.empty() ||
+            compression_dictionary_id(dictionary) != read_u32_be(data + kCompressedHeaderSize)) {
+            return false;
+        }
+    } else {
+        dictionary = {};
+    }
+
+    out.resize(kBatchHeaderSize + section_size);
+    std::memcpy(out.data(), data, kBatchHeaderSize);
+    out[3] = 0;
+    const uint8_t* src = data + header_size;
+    size_t src_size = size - header_size;
+    char* dst = out.data() + kBatchHeaderSize;
+    if (algorithm == Compression::Zstd) {
+        return inflate_zstd(src, src_size, dst, section_size, dictionary);
+    }
+    if (algorithm == Compression::Lz4) {
+        return inflate_lz4(src, src_size, dst, section_size, dictionary);
+    }
+    return false;
+}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,159 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/batch_compressor.hpp
+/// @brief Optional zstd/LZ4 compression of framed topic batches
+///
+/// Batches of one topic repeat the same VSS paths, label keys and JSON
+/// field names over and over. BatchCompressor compresses the message
+/// section of a TopicBatcher frame; the header stays readable and its
+/// flags byte says how the rest was compressed:
+///
+///     offset 0  'V' 'B' version flags   flags: bits 0-1 kBatchCompressionMask
+///                                              (1 zstd, 2 LZ4), bit 2
+///                                              kBatchFlagDictionary
+///            4  u32           message count
+///            8  u32           size of the message section uncompressed
+///           12  [u32          dictionary id, with kBatchFlagDictionary]
+///               compressed message section
+///
+/// Small payloads compress poorly without context, so a dictionary trained
+/// offline on captured traffic (vdr_train_dictionary) can be loaded; zstd
+/// and LZ4 both use it, and consumers need the same file to decompress.
+/// The level follows the batch size: cheap levels for the small, frequent
+/// batches of critical topics, stronger ones where a large batch makes the
+/// extra CPU pay off in cellular bytes. Batches under min_bytes, and those
+/// that would not shrink, go out unchanged (flags 0).
+///
+/// zstd and LZ4 are optional: built in with VDR_HAS_ZSTD / VDR_HAS_LZ4.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+union LZ4_stream_u;
+union LZ4_streamHC_u;
+
+namespace vdr {
+namespace sinks {
+
+enum class Compression {
+    None,
+    Zstd,
+    Lz4
+};
+
+/// @name Bits of a batch's flags byte
+/// @{
+constexpr uint8_t kBatchCompressionMask = 0x03;  ///< Holds a Compression value
+constexpr uint8_t kBatchFlagDictionary = 0x04;
+/// @}
+
+/// Parse "none" / "zstd" / "lz4".
+std::optional<Compression> parse_compression(std::string_view name);
+
+const char* to_string(Compression compression);
+
+/// False for algorithms this build was compiled without.
+bool compression_available(Compression compression);
+
+/// Level for batches of at least `min_bytes` (framed size).
+struct CompressionLevel {
+    size_t min_bytes;
+    int level;
+};
+
+/// As configured under `offboard:`.
+struct CompressionConfig {
+    Compression algorithm = Compression::None;
+
+    /// Trained dictionary (contents, not the path); empty for none
+    std::string dictionary;
+
+    /// Batches below this framed size are sent uncompressed
+    size_t min_bytes = 128;
+
+    /// Ascending by min_bytes; a batch uses the last entry it reaches.
+    /// zstd: levels 1-19 (negative: faster). LZ4: 1 or less is the fast
+    /// compressor, 2-12 are LZ4HC levels.
+    std::vector<CompressionLevel> levels = {{0, 1}, {16384, 3}, {262144, 6}};
+};
+
+/// Read a dictionary file. Throws std::runtime_error if it cannot be read.
+std::string load_compression_dictionary(const std::string& path);
+
+/// Id written to batches compressed with `dictionary`: the zstd dictionary
+/// id if it has one, else a hash of the contents.
+uint32_t compression_dictionary_id(std::string_view dictionary);
+
+/// Compresses framed batches; owns the compression contexts.
+///
+/// Not thread-safe: MqttSink compresses on its publish thread.
+class BatchCompressor {
+public:
+    /// Throws std::invalid_argument if the algorithm is not built in, and
+    /// std::runtime_error if the library rejects the dictionary.
+    explicit BatchCompressor(CompressionConfig config = {});
+    ~BatchCompressor();
+
+    BatchCompressor(const BatchCompressor&) = delete;
+    BatchCompressor& operator=(const BatchCompressor&) = delete;
+
+    bool enabled() const noexcept { return config_.algorithm != Compression::None; }
+    const CompressionConfig& config() const noexcept { return config_; }
+
+    /// Level for a batch of `size` bytes.
+    int level_for(size_t size) const noexcept;
+
+    /// Compress a framed, uncompressed batch into `out` and return `out`;
+    /// returns `batch` itself when it stays uncompressed.
+    std::string_view compress(std::string_view batch, std::string& out);
+
+private:
+    void release() noexcept;
+    // Index into config_.levels
+    size_t tier_for(size_t size) const noexcept;
+
+    // Compressed size of `size` bytes at `dst`, or 0 if it did not fit
+    size_t compress_zstd(const char* src, size_t size, char* dst, size_t capacity, size_t tier);
+    size_t compress_lz4(const char* src, size_t size, char* dst, size_t capacity, int level);
+
+    CompressionConfig config_;
+    uint32_t dictionary_id_ = 0;
+
+    ZSTD_CCtx_s* zstd_ = nullptr;
+    std::vector<ZSTD_CDict_s*> zstd_dictionaries_;  // one per level tier
+    LZ4_stream_u* lz4_ = nullptr;
+    LZ4_stream_u* lz4_dictionary_ = nullptr;  // dictionary loaded once, copied into lz4_
+    LZ4_streamHC_u* lz4hc_ = nullptr;
+};
+
+/// Reverse of BatchCompressor::compress(): write the uncompressed framed
+/// batch (flags 0) to `out`, ready for for_each_batch_message(). An
+/// uncompressed batch is copied. `dictionary` must be the one the batch was
+/// compressed with; returns false for a missing or different dictionary,
+/// an algorithm not built in, or malformed data.
+bool decompress_batch(const uint8_t* data, size_t size, std::string& out,
+                      std::string_view dictionary = {});
+
+}  // namespace sinks
+}  // namespace vdr
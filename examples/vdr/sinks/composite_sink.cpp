@@ -0,0 +1,444 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/composite_sink.hpp"
+
+#include "vdr/envelope.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+using vdr::deep_copy;
+
+// An idle worker still refreshes its child's stats and health this often
+constexpr std::chrono::milliseconds kSnapshotInterval{500};
+
+// Raw CDR is only valid during send_serialized(); queue a copy
+void deep_copy(SerializedMessage& dst, const SerializedMessage& src, utils::Arena& arena) {
+    dst = src;
+    dst.topic = arena.copy_string(src.topic);
+    dst.type_name = arena.copy_string(src.type_name);
+    uint8_t* data = arena.allocate_array<uint8_t>(src.size);
+    if (data != nullptr) {
+        std::memcpy(data, src.data, src.size);
+    }
+    dst.data = data;
+}
+
+int64_t steady_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void update_max(std::atomic<int64_t>& max, int64_t value) {
+    int64_t current = max.load(std::memory_order_relaxed);
+    while (value > current &&
+           !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+std::optional<OverflowPolicy> parse_overflow_policy(std::string_view name) {
+    if (name == "drop_newest") return OverflowPolicy::DropNewest;
+    if (name == "drop_oldest") return OverflowPolicy::DropOldest;
+    if (name == "block") return OverflowPolicy::Block;
+    return std::nullopt;
+}
+
+const char* to_string(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DropNewest: return "drop_newest";
+        case OverflowPolicy::DropOldest: return "drop_oldest";
+        case OverflowPolicy::Block: return "block";
+    }
+    return "unknown";
+}
+
+CompositeSink::~CompositeSink() {
+    stop();
+}
+
+void CompositeSink::add(std::unique_ptr<OutputSink> sink, const SinkQueueConfig& config) {
+    auto lane = std::make_unique<Lane>();
+    lane->serialized = sink->accepts_serialized();
+    lane->sink = std::move(sink);
+    lane->config = config;
+    lane->config.capacity = std::max<size_t>(config.capacity, 1);
+    lane->filling.items.reserve(lane->config.capacity);
+    lane->sending.items.reserve(lane->config.capacity);
+    lanes_.push_back(std::move(lane));
+}
+
+bool CompositeSink::start() {
+    if (running_) {
+        return true;
+    }
+
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+        if (!lanes_[i]->sink->start()) {
+            LOG(ERROR) << "CompositeSink: " << lanes_[i]->sink->name() << " failed to start";
+            for (size_t j = 0; j < i; ++j) {
+                lanes_[j]->sink->stop();
+            }
+            return false;
+        }
+    }
+
+    for (auto& lane : lanes_) {
+        snapshot(*lane);
+        lane->stopping = false;
+        lane->worker = std::thread([this, &lane = *lane] { run(lane); });
+    }
+    running_ = true;
+    return true;
+}
+
+void CompositeSink::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    for (auto& lane : lanes_) {
+        {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            lane->stopping = true;
+        }
+        lane->ready.notify_one();
+        lane->room.notify_all();
+    }
+    for (auto& lane : lanes_) {
+        if (lane->worker.joinable()) {
+            lane->worker.join();
+        }
+        lane->sink->stop();
+        snapshot(*lane);
+    }
+}
+
+void CompositeSink::send(const vss_Signal& msg) {
+    enqueue(utils::Span<const vss_Signal>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_events_Event& msg) {
+    enqueue(utils::Span<const telemetry_events_Event>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_metrics_Gauge& msg) {
+    enqueue(utils::Span<const telemetry_metrics_Gauge>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_metrics_Counter& msg) {
+    enqueue(utils::Span<const telemetry_metrics_Counter>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_metrics_Histogram& msg) {
+    enqueue(utils::Span<const telemetry_metrics_Histogram>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_logs_LogEntry& msg) {
+    enqueue(utils::Span<const telemetry_logs_LogEntry>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_diagnostics_ScalarMeasurement& msg) {
+    enqueue(utils::Span<const telemetry_diagnostics_ScalarMeasurement>(&msg, 1));
+}
+
+void CompositeSink::send(const telemetry_diagnostics_VectorMeasurement& msg) {
+    enqueue(utils::Span<const telemetry_diagnostics_VectorMeasurement>(&msg, 1));
+}
+
+void CompositeSink::send_batch(utils::Span<const vss_Signal> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_events_Event> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_metrics_Counter> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) {
+    enqueue(msgs);
+}
+
+void CompositeSink::send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) {
+    enqueue(msgs);
+}
+
+bool CompositeSink::accepts_serialized() const {
+    return std::any_of(lanes_.begin(), lanes_.end(),
+                       [](const auto& lane) { return lane->serialized; });
+}
+
+void CompositeSink::send_serialized(const SerializedMessage& msg) {
+    enqueue(utils::Span<const SerializedMessage>(&msg, 1));
+}
+
+template<typename T>
+void CompositeSink::enqueue(utils::Span<const T> msgs) {
+    if (!running_ || msgs.empty()) {
+        return;
+    }
+    int64_t now = steady_ns();
+    for (auto& lane : lanes_) {
+        if constexpr (std::is_same_v<T, SerializedMessage>) {
+            if (!lane->serialized) {
+                continue;
+            }
+        }
+        enqueue(*lane, msgs, now);
+    }
+}
+
+template<typename T>
+void CompositeSink::enqueue(Lane& lane, utils::Span<const T> msgs, int64_t now) {
+    size_t accepted = 0;
+    bool wake = false;  // the worker sleeps while the queue is empty
+    // Block: one budget for the whole call, not per message
+    auto deadline = std::chrono::steady_clock::now() + lane.config.block_timeout;
+    {
+        std::unique_lock<std::mutex> lock(lane.mutex);
+        for (const T& msg : msgs) {
+            if (lane.filling.size() >= lane.config.capacity &&
+                !make_room(lane, lock, deadline)) {
+                continue;
+            }
+            wake |= lane.filling.size() == 0;
+            lane.filling.items.push_back({Message{}, now});
+            deep_copy(lane.filling.items.back().message.template emplace<T>(), msg,
+                      lane.filling.arena);
+            ++accepted;
+        }
+        lane.max_depth = std::max(lane.max_depth, lane.filling.size());
+    }
+
+    lane.enqueued.fetch_add(accepted, std::memory_order_relaxed);
+    if (wake) {
+        lane.ready.notify_one();
+    }
+}
+
+bool CompositeSink::make_room(Lane& lane, std::unique_lock<std::mutex>& lock,
+                              std::chrono::steady_clock::time_point deadline) {
+    switch (lane.config.overflow) {
+        case OverflowPolicy::DropNewest:
+            break;
+
+        case OverflowPolicy::DropOldest:
+            ++lane.filling.head;
+            lane.dropped.fetch_add(1, std::memory_order_relaxed);
+            if (lane.filling.head >= lane.config.capacity) {
+                // The arena still holds every dropped message: re-copy the
+                // live ones so a stalled sink costs bounded memory
+                Batch compacted;
+                compacted.items.reserve(lane.config.capacity);
+                for (size_t i = lane.filling.head; i < lane.filling.items.size(); ++i) {
+                    const Queued& old = lane.filling.items[i];
+                    compacted.items.push_back({Message{}, old.enqueued_ns});
+                    std::visit([&](const auto& m) {
+                        using M = std::decay_t<decltype(m)>;
+                        deep_copy(compacted.items.back().message.template emplace<M>(), m,
+                                  compacted.arena);
+                    }, old.message);
+                }
+                lane.filling = std::move(compacted);
+            }
+            return true;
+
+        case OverflowPolicy::Block: {
+            // The worker may be waiting for this batch; wake it before waiting
+            lane.ready.notify_one();
+            bool has_room = lane.room.wait_until(lock, deadline, [&] {
+                return lane.filling.size() < lane.config.capacity || lane.stopping;
+            });
+            if (has_room && !lane.stopping) {
+                return true;
+            }
+            break;
+        }
+    }
+    lane.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void CompositeSink::run(Lane& lane) {
+    for (;;) {
+        bool flush = false;
+        {
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            bool woken = lane.ready.wait_for(lock, kSnapshotInterval, [&] {
+                return lane.filling.size() > 0 || lane.stopping || lane.flush_requested;
+            });
+            if (!woken) {
+                lock.unlock();
+                snapshot(lane);
+                continue;
+            }
+            if (lane.filling.size() == 0 && lane.stopping) {
+                break;
+            }
+            std::swap(lane.filling, lane.sending);
+            flush = std::exchange(lane.flush_requested, false);
+        }
+        lane.room.notify_all();
+
+        Batch& batch = lane.sending;
+        for (size_t begin = batch.head; begin < batch.items.size();) {
+            size_t end = begin + 1;
+            while (end < batch.items.size() &&
+                   batch.items[end].message.index() == batch.items[begin].message.index()) {
+                ++end;
+            }
+            deliver(lane, batch, begin, end);
+            begin = end;
+        }
+        lane.delivered.fetch_add(batch.size(), std::memory_order_relaxed);
+        batch.items.clear();
+        batch.arena.reset();
+        batch.head = 0;
+
+        if (flush) {
+            lane.sink->flush();
+        }
+        snapshot(lane);
+    }
+    lane.sink->flush();
+    snapshot(lane);
+}
+
+void CompositeSink::snapshot(Lane& lane) {
+    SinkStats stats = lane.sink->stats();
+    bool healthy = lane.sink->healthy();
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    lane.sink_stats = stats;
+    lane.sink_healthy = healthy;
+}
+
+void CompositeSink::deliver(Lane& lane, const Batch& batch, size_t begin, size_t end) {
+    int64_t now = steady_ns();
+    lane.last_lag_ns.store(now - batch.items[end - 1].enqueued_ns, std::memory_order_relaxed);
+    update_max(lane.max_lag_ns, now - batch.items[begin].enqueued_ns);
+
+    std::visit([&](const auto& first) {
+        using M = std::decay_t<decltype(first)>;
+        if constexpr (std::is_same_v<M, SerializedMessage>) {
+            for (size_t i = begin; i < end; ++i) {
+                lane.sink->send_serialized(std::get<M>(batch.items[i].message));
+            }
+        } else {
+            // Shallow copies: strings and sequences stay in the batch arena
+            auto& run = std::get<std::vector<M>>(lane.runs);
+            run.clear();
+            for (size_t i = begin; i < end; ++i) {
+                run.push_back(std::get<M>(batch.items[i].message));
+            }
+            lane.sink->send_batch(utils::Span<const M>(run));
+        }
+    }, batch.items[begin].message);
+}
+
+void CompositeSink::flush() {
+    for (auto& lane : lanes_) {
+        {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            lane->flush_requested = true;
+        }
+        lane->ready.notify_one();
+    }
+}
+
+bool CompositeSink::healthy() const {
+    return running_ && std::all_of(lanes_.begin(), lanes_.end(), [](const auto& lane) {
+               std::lock_guard<std::mutex> lock(lane->mutex);
+               return lane->sink_healthy;
+           });
+}
+
+SinkStats CompositeSink::stats() const {
+    SinkStats total;
+    for (const auto& lane : lanes_) {
+        SinkStats child;
+        {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            child = lane->sink_stats;
+        }
+        total.messages_sent += lane->delivered.load(std::memory_order_relaxed);
+        total.messages_failed += lane->dropped.load(std::memory_order_relaxed) +
+                                 child.messages_failed;
+        total.bytes_sent += child.bytes_sent;
+        total.bytes_uncompressed += child.bytes_uncompressed;
+        total.bytes_compressed += child.bytes_compressed;
+        total.compress_cpu_ns += child.compress_cpu_ns;
+        total.last_send_timestamp_ns =
+            std::max(total.last_send_timestamp_ns, child.last_send_timestamp_ns);
+    }
+    return total;
+}
+
+std::vector<SinkLaneStats> CompositeSink::lane_stats() const {
+    std::vector<SinkLaneStats> result;
+    result.reserve(lanes_.size());
+    for (const auto& lane : lanes_) {
+        SinkLaneStats stats;
+        stats.sink = lane->sink->name();
+        stats.enqueued = lane->enqueued.load(std::memory_order_relaxed);
+        stats.delivered = lane->delivered.load(std::memory_order_relaxed);
+        stats.dropped = lane->dropped.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            stats.depth = lane->filling.size();
+            stats.max_depth = lane->max_depth;
+            stats.sink_stats = lane->sink_stats;
+        }
+        stats.last_lag_ns = lane->last_lag_ns.load(std::memory_order_relaxed);
+        stats.max_lag_ns = lane->max_lag_ns.load(std::memory_order_relaxed);
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+std::string CompositeSink::name() const {
+    std::string name = "CompositeSink(";
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+        name += (i > 0 ? ", " : "") + lanes_[i]->sink->name();
+    }
+    return name + ")";
+}
+
+}  // namespace sinks
+}  // namespace vdr
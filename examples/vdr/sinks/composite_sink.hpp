@@ -0,0 +1,234 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/composite_sink.hpp
+/// @brief Fan-out to several sinks through per-sink queues and workers
+///
+/// CompositeSink is itself an OutputSink, so it drops in wherever a single
+/// sink is wired today. send() deep-copies the message into the arena of
+/// every child's queue and returns; each child runs on its own worker
+/// thread. A slow child (LogSink writing through glog, MQTT during a
+/// reconnect) fills only its own queue, and its overflow policy decides
+/// what is lost - the DDS receive thread is never held up by it.
+
+#include "common/arena.hpp"
+#include "vdr/output_sink.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace vdr {
+namespace sinks {
+
+/// What a full queue does with a new message.
+enum class OverflowPolicy {
+    DropNewest,  ///< Refuse the new message
+    DropOldest,  ///< Discard the oldest queued message to make room
+    Block        ///< Wait up to block_timeout for room, then refuse
+};
+
+/// Parse "drop_newest" / "drop_oldest" / "block".
+std::optional<OverflowPolicy> parse_overflow_policy(std::string_view name);
+
+const char* to_string(OverflowPolicy policy);
+
+/// Queue settings of one child sink.
+struct SinkQueueConfig {
+    size_t capacity = 4096;  ///< Messages waiting, besides the batch being sent
+    OverflowPolicy overflow = OverflowPolicy::DropNewest;
+    /// Block only: longest wait per send()/send_batch() call, shared by
+    /// every message of the call, so a take never stalls for longer
+    std::chrono::milliseconds block_timeout{5};
+};
+
+/// Queue metrics of one child sink.
+struct SinkLaneStats {
+    std::string sink;          ///< Child name()
+    uint64_t enqueued = 0;
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;      ///< Lost to the overflow policy
+    size_t depth = 0;          ///< Messages waiting now
+    size_t max_depth = 0;
+    int64_t last_lag_ns = 0;   ///< Queueing delay of the last delivered message
+    int64_t max_lag_ns = 0;
+    SinkStats sink_stats;      ///< The child's own stats()
+};
+
+/// OutputSink that forwards every message to several child sinks.
+///
+/// Children are added before start() and are only ever called from their
+/// worker thread (start()/stop() excepted), so they need not be
+/// thread-safe. send() may be called from several threads (polling thread,
+/// listener callbacks). A worker passes what it takes off its queue to the
+/// child's send_batch(), one call per run of messages of the same type.
+class CompositeSink : public OutputSink {
+public:
+    CompositeSink() = default;
+    ~CompositeSink() override;
+
+    CompositeSink(const CompositeSink&) = delete;
+    CompositeSink& operator=(const CompositeSink&) = delete;
+
+    /// Add a child with its own queue. Must be called before start().
+    void add(std::unique_ptr<OutputSink> sink, const SinkQueueConfig& config = {});
+
+    size_t size() const noexcept { return lanes_.size(); }
+
+    /// Starts every child and its worker; fails (and stops the children
+    /// already started) if a child fails to start.
+    bool start() override;
+
+    /// Delivers what is queued, then stops the workers and the children.
+    void stop() override;
+
+    void send(const vss_Signal& msg) override;
+    void send(const telemetry_events_Event& msg) override;
+    void send(const telemetry_metrics_Gauge& msg) override;
+    void send(const telemetry_metrics_Counter& msg) override;
+    void send(const telemetry_metrics_Histogram& msg) override;
+    void send(const telemetry_logs_LogEntry& msg) override;
+    void send(const telemetry_diagnostics_ScalarMeasurement& msg) override;
+    void send(const telemetry_diagnostics_VectorMeasurement& msg) override;
+
+    /// Takes each child's queue lock once per batch.
+    /// @{
+    void send_batch(utils::Span<const vss_Signal> msgs) override;
+    void send_batch(utils::Span<const telemetry_events_Event> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Counter> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) override;
+    void send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) override;
+    void send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) override;
+    void send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) override;
+    /// @}
+
+    /// True if any child takes serialized samples; only those get them.
+    bool accepts_serialized() const override;
+    void send_serialized(const SerializedMessage& msg) override;
+
+    /// Asks each worker to flush its child once its queue is empty;
+    /// does not wait.
+    void flush() override;
+
+    /// Running and every child healthy. Children are not asked from this
+    /// thread: each worker records its child's health and stats after
+    /// every run, and these read that record.
+    bool healthy() const override;
+
+    /// Sums over the children: delivered messages and the children's
+    /// bytes as sent, drops and child failures as failed.
+    SinkStats stats() const override;
+
+    std::vector<SinkLaneStats> lane_stats() const;
+
+    std::string name() const override;
+
+private:
+    using Message = std::variant<vss_Signal, telemetry_events_Event, telemetry_metrics_Gauge,
+                                 telemetry_metrics_Counter, telemetry_metrics_Histogram,
+                                 telemetry_logs_LogEntry,
+                                 telemetry_diagnostics_ScalarMeasurement,
+                                 telemetry_diagnostics_VectorMeasurement, SerializedMessage>;
+
+    struct Queued {
+        Message message;
+        int64_t enqueued_ns;  // steady clock
+    };
+
+    // Messages and the arena their strings and sequences live in; the
+    // worker swaps the whole batch out, so a lane never frees per message
+    struct Batch {
+        utils::Arena arena;
+        std::vector<Queued> items;
+        size_t head = 0;  // items before head were dropped (DropOldest)
+
+        size_t size() const noexcept { return items.size() - head; }
+    };
+
+    // One vector per message type, for handing runs to send_batch()
+    template<typename V>
+    struct RunBuffers;
+    template<typename... Ts>
+    struct RunBuffers<std::variant<Ts...>> {
+        using type = std::tuple<std::vector<Ts>...>;
+    };
+
+    struct Lane {
+        std::unique_ptr<OutputSink> sink;
+        SinkQueueConfig config;
+        bool serialized = false;
+
+        std::mutex mutex;
+        std::condition_variable ready;  // worker: messages queued or stopping
+        std::condition_variable room;   // Block producers: the queue was swapped out
+        Batch filling;                  // producers, under mutex
+        Batch sending;                  // worker only
+        RunBuffers<Message>::type runs;  // worker only
+        bool stopping = false;
+        bool flush_requested = false;
+        size_t max_depth = 0;
+        SinkStats sink_stats;       // the child's, as of the worker's last run
+        bool sink_healthy = false;  // likewise
+        std::thread worker;
+
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> delivered{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<int64_t> last_lag_ns{0};
+        std::atomic<int64_t> max_lag_ns{0};
+    };
+
+    template<typename T>
+    void enqueue(utils::Span<const T> msgs);
+
+    template<typename T>
+    void enqueue(Lane& lane, utils::Span<const T> msgs, int64_t now);
+
+    // Make room for one message according to the lane's overflow policy;
+    // false if the message has to be dropped. Called with the lane locked.
+    // Block waits no later than `deadline`, the end of the enqueue call's budget.
+    bool make_room(Lane& lane, std::unique_lock<std::mutex>& lock,
+                   std::chrono::steady_clock::time_point deadline);
+
+    void run(Lane& lane);
+
+    // Record the child's stats and health in the lane; only from the thread
+    // that may call the child
+    static void snapshot(Lane& lane);
+
+    // Hand items [begin, end), all of one type, to the child: one
+    // send_batch() call, or send_serialized() per sample
+    void deliver(Lane& lane, const Batch& batch, size_t begin, size_t end);
+
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::atomic<bool> running_{false};
+};
+
+}  // namespace sinks
+}  // namespace vdr
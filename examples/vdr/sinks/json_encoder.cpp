@@ -0,0 +1,416 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/json_encoder.hpp"
+
+#include <cstring>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+nlohmann::json encode_header(const vss_types_Header& header) {
+    return {
+        {"source_id", header.source_id ? header.source_id : ""},
+        {"timestamp_ns", header.timestamp_ns},
+        {"seq_num", header.seq_num},
+        {"correlation_id", header.correlation_id ? header.correlation_id : ""}
+    };
+}
+
+// Helper to encode a struct field value to JSON
+nlohmann::json encode_struct_field_value(const vss_types_StructField& field) {
+    switch (field.type) {
+        case vss_types_VALUE_TYPE_BOOL:
+            return field.bool_value;
+        case vss_types_VALUE_TYPE_INT8:
+            return static_cast<int>(field.int8_value);
+        case vss_types_VALUE_TYPE_INT16:
+            return field.int16_value;
+        case vss_types_VALUE_TYPE_INT32:
+            return field.int32_value;
+        case vss_types_VALUE_TYPE_INT64:
+            return field.int64_value;
+        case vss_types_VALUE_TYPE_UINT8:
+            return field.uint8_value;
+        case vss_types_VALUE_TYPE_UINT16:
+            return field.uint16_value;
+        case vss_types_VALUE_TYPE_UINT32:
+            return field.uint32_value;
+        case vss_types_VALUE_TYPE_UINT64:
+            return field.uint64_value;
+        case vss_types_VALUE_TYPE_FLOAT:
+            return field.float_value;
+        case vss_types_VALUE_TYPE_DOUBLE:
+            return field.double_value;
+        case vss_types_VALUE_TYPE_STRING:
+            return field.string_value ? field.string_value : "";
+        case vss_types_VALUE_TYPE_BOOL_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < field.bool_array._length; ++i) {
+                arr.push_back(static_cast<bool>(field.bool_array._buffer[i]));
+            }
+            return arr;
+        }
+        case vss_types_VALUE_TYPE_INT32_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < field.int32_array._length; ++i) {
+                arr.push_back(field.int32_array._buffer[i]);
+            }
+            return arr;
+        }
+        case vss_types_VALUE_TYPE_FLOAT_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < field.float_array._length; ++i) {
+                arr.push_back(field.float_array._buffer[i]);
+            }
+            return arr;
+        }
+        case vss_types_VALUE_TYPE_DOUBLE_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < field.double_array._length; ++i) {
+                arr.push_back(field.double_array._buffer[i]);
+            }
+            return arr;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+// Helper to encode a StructValue to JSON
+nlohmann::json encode_struct_value(const vss_types_StructValue& struct_val) {
+    nlohmann::json obj = nlohmann::json::object();
+
+    // Add type name if present
+    if (struct_val.type_name && strlen(struct_val.type_name) > 0) {
+        obj["_type"] = struct_val.type_name;
+    }
+
+    // Encode all fields
+    for (uint32_t i = 0; i < struct_val.fields._length; ++i) {
+        const auto& field = struct_val.fields._buffer[i];
+        if (field.name) {
+            obj[field.name] = encode_struct_field_value(field);
+        }
+    }
+
+    return obj;
+}
+
+}  // namespace
+
+nlohmann::json encode_json(const vss_Signal& msg) {
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"path", msg.path ? msg.path : ""},
+        {"quality", static_cast<int>(msg.quality)},
+        {"value_type", static_cast<int>(msg.value.type)}
+    };
+
+    switch (msg.value.type) {
+        case vss_types_VALUE_TYPE_BOOL:
+            payload["value"] = msg.value.bool_value;
+            break;
+        case vss_types_VALUE_TYPE_INT8:
+            payload["value"] = static_cast<int>(msg.value.int8_value);
+            break;
+        case vss_types_VALUE_TYPE_INT16:
+            payload["value"] = msg.value.int16_value;
+            break;
+        case vss_types_VALUE_TYPE_INT32:
+            payload["value"] = msg.value.int32_value;
+            break;
+        case vss_types_VALUE_TYPE_INT64:
+            payload["value"] = msg.value.int64_value;
+            break;
+        case vss_types_VALUE_TYPE_UINT8:
+            payload["value"] = msg.value.uint8_value;
+            break;
+        case vss_types_VALUE_TYPE_UINT16:
+            payload["value"] = msg.value.uint16_value;
+            break;
+        case vss_types_VALUE_TYPE_UINT32:
+            payload["value"] = msg.value.uint32_value;
+            break;
+        case vss_types_VALUE_TYPE_UINT64:
+            payload["value"] = msg.value.uint64_value;
+            break;
+        case vss_types_VALUE_TYPE_FLOAT:
+            payload["value"] = msg.value.float_value;
+            break;
+        case vss_types_VALUE_TYPE_DOUBLE:
+            payload["value"] = msg.value.double_value;
+            break;
+        case vss_types_VALUE_TYPE_STRING:
+            payload["value"] = msg.value.string_value ? msg.value.string_value : "";
+            break;
+
+        // Array types
+        case vss_types_VALUE_TYPE_BOOL_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.bool_array._length; ++i) {
+                arr.push_back(static_cast<bool>(msg.value.bool_array._buffer[i]));
+            }
+            payload["value"] = arr;
+            break;
+        }
+        case vss_types_VALUE_TYPE_INT32_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.int32_array._length; ++i) {
+                arr.push_back(msg.value.int32_array._buffer[i]);
+            }
+            payload["value"] = arr;
+            break;
+        }
+        case vss_types_VALUE_TYPE_INT64_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.int64_array._length; ++i) {
+                arr.push_back(msg.value.int64_array._buffer[i]);
+            }
+            payload["value"] = arr;
+            break;
+        }
+        case vss_types_VALUE_TYPE_FLOAT_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.float_array._length; ++i) {
+                arr.push_back(msg.value.float_array._buffer[i]);
+            }
+            payload["value"] = arr;
+            break;
+        }
+        case vss_types_VALUE_TYPE_DOUBLE_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.double_array._length; ++i) {
+                arr.push_back(msg.value.double_array._buffer[i]);
+            }
+            payload["value"] = arr;
+            break;
+        }
+        case vss_types_VALUE_TYPE_STRING_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.string_array._length; ++i) {
+                const char* element = msg.value.string_array._buffer[i];
+                arr.push_back(element ? element : "");
+            }
+            payload["value"] = arr;
+            break;
+        }
+
+        // Struct types
+        case vss_types_VALUE_TYPE_STRUCT:
+            payload["value"] = encode_struct_value(msg.value.struct_value);
+            break;
+
+        case vss_types_VALUE_TYPE_STRUCT_ARRAY: {
+            nlohmann::json arr = nlohmann::json::array();
+            for (uint32_t i = 0; i < msg.value.struct_array._length; ++i) {
+                arr.push_back(encode_struct_value(msg.value.struct_array._buffer[i]));
+            }
+            payload["value"] = arr;
+            break;
+        }
+
+        case vss_types_VALUE_TYPE_EMPTY:
+            payload["value"] = nullptr;
+            break;
+
+        default:
+            payload["value"] = "<unsupported_type>";
+            break;
+    }
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_events_Event& msg) {
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"event_id", msg.event_id ? msg.event_id : ""},
+        {"category", msg.category ? msg.category : ""},
+        {"event_type", msg.event_type ? msg.event_type : ""},
+        {"severity", static_cast<int>(msg.severity)}
+    };
+
+    // Encode attributes as key-value pairs
+    if (msg.attributes._length > 0) {
+        nlohmann::json attrs = nlohmann::json::object();
+        for (uint32_t i = 0; i < msg.attributes._length; ++i) {
+            const auto& kv = msg.attributes._buffer[i];
+            if (kv.key && kv.value) {
+                attrs[kv.key] = kv.value;
+            }
+        }
+        payload["attributes"] = attrs;
+    }
+
+    // Record context signal count
+    if (msg.context._length > 0) {
+        payload["context_signal_count"] = msg.context._length;
+    }
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_metrics_Gauge& msg) {
+    nlohmann::json labels = nlohmann::json::object();
+    for (uint32_t i = 0; i < msg.labels._length; ++i) {
+        const auto& kv = msg.labels._buffer[i];
+        if (kv.key && kv.value) {
+            labels[kv.key] = kv.value;
+        }
+    }
+
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"name", msg.name ? msg.name : ""},
+        {"labels", labels},
+        {"value", msg.value}
+    };
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_metrics_Counter& msg) {
+    nlohmann::json labels = nlohmann::json::object();
+    for (uint32_t i = 0; i < msg.labels._length; ++i) {
+        const auto& kv = msg.labels._buffer[i];
+        if (kv.key && kv.value) {
+            labels[kv.key] = kv.value;
+        }
+    }
+
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"name", msg.name ? msg.name : ""},
+        {"labels", labels},
+        {"value", msg.value}
+    };
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_metrics_Histogram& msg) {
+    nlohmann::json labels = nlohmann::json::object();
+    for (uint32_t i = 0; i < msg.labels._length; ++i) {
+        const auto& kv = msg.labels._buffer[i];
+        if (kv.key && kv.value) {
+            labels[kv.key] = kv.value;
+        }
+    }
+
+    nlohmann::json buckets = nlohmann::json::array();
+    for (uint32_t i = 0; i < msg.buckets._length; ++i) {
+        const auto& bucket = msg.buckets._buffer[i];
+        buckets.push_back({
+            {"upper_bound", bucket.upper_bound},
+            {"cumulative_count", bucket.cumulative_count}
+        });
+    }
+
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"name", msg.name ? msg.name : ""},
+        {"labels", labels},
+        {"sample_count", msg.sample_count},
+        {"sample_sum", msg.sample_sum},
+        {"buckets", buckets}
+    };
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_logs_LogEntry& msg) {
+    nlohmann::json fields = nlohmann::json::object();
+    for (uint32_t i = 0; i < msg.fields._length; ++i) {
+        const auto& kv = msg.fields._buffer[i];
+        if (kv.key && kv.value) {
+            fields[kv.key] = kv.value;
+        }
+    }
+
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"level", static_cast<int>(msg.level)},
+        {"component", msg.component ? msg.component : ""},
+        {"message", msg.message ? msg.message : ""},
+        {"fields", fields}
+    };
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_diagnostics_ScalarMeasurement& msg) {
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"variable_id", msg.variable_id ? msg.variable_id : ""},
+        {"unit", msg.unit ? msg.unit : ""},
+        {"measurement_type", static_cast<int>(msg.measurement_type)},
+        {"value", msg.value}
+    };
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_diagnostics_VectorMeasurement& msg) {
+    nlohmann::json values = nlohmann::json::array();
+    for (uint32_t i = 0; i < msg.values._length; ++i) {
+        values.push_back(msg.values._buffer[i]);
+    }
+
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"variable_id", msg.variable_id ? msg.variable_id : ""},
+        {"unit", msg.unit ? msg.unit : ""},
+        {"measurement_type", static_cast<int>(msg.measurement_type)},
+        {"values", values}
+    };
+
+    return payload;
+}
+
+nlohmann::json encode_json(const telemetry_security_Incident& msg) {
+    nlohmann::json indicators = nlohmann::json::object();
+    for (uint32_t i = 0; i < msg.indicators._length; ++i) {
+        const auto& kv = msg.indicators._buffer[i];
+        if (kv.key && kv.value) {
+            indicators[kv.key] = kv.value;
+        }
+    }
+
+    static const char kHex[] = "0123456789abcdef";
+    std::string evidence;
+    evidence.reserve(msg.raw_evidence._length * 2);
+    for (uint32_t i = 0; i < msg.raw_evidence._length; ++i) {
+        evidence += kHex[msg.raw_evidence._buffer[i] >> 4];
+        evidence += kHex[msg.raw_evidence._buffer[i] & 0x0f];
+    }
+
+    nlohmann::json payload = {
+        {"header", encode_header(msg.header)},
+        {"incident_id", msg.incident_id ? msg.incident_id : ""},
+        {"threat_level", static_cast<int>(msg.threat_level)},
+        {"incident_type", msg.incident_type ? msg.incident_type : ""},
+        {"description", msg.description ? msg.description : ""},
+        {"indicators", indicators},
+        {"raw_evidence", evidence}
+    };
+
+    return payload;
+}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,46 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/json_encoder.hpp
+/// @brief JSON payloads of the offboarded message types
+///
+/// The self-describing format: one object per message with the field
+/// names of the IDL, a nested "header" object and enums as integers.
+/// Event context signals are reduced to a count, incident raw_evidence is
+/// a hex string. See msgpack_encoder.hpp and protobuf_encoder.hpp for the
+/// compact alternatives.
+
+#include "telemetry.h"
+#include "vss_signal.h"
+
+#include <nlohmann/json.hpp>
+
+namespace vdr {
+namespace sinks {
+
+nlohmann::json encode_json(const vss_Signal& msg);
+nlohmann::json encode_json(const telemetry_events_Event& msg);
+nlohmann::json encode_json(const telemetry_metrics_Gauge& msg);
+nlohmann::json encode_json(const telemetry_metrics_Counter& msg);
+nlohmann::json encode_json(const telemetry_metrics_Histogram& msg);
+nlohmann::json encode_json(const telemetry_logs_LogEntry& msg);
+nlohmann::json encode_json(const telemetry_diagnostics_ScalarMeasurement& msg);
+nlohmann::json encode_json(const telemetry_diagnostics_VectorMeasurement& msg);
+nlohmann::json encode_json(const telemetry_security_Incident& msg);
+
+}  // namespace sinks
+}  // namespace vdr
@@ -47,19 +47,95 @@ nlohmann::json LogSink::encode_header(const vss_types_Header& header) {
     };
 }
 
-void LogSink::log_output(const std::string& topic, const nlohmann::json& payload) {
+size_t LogSink::log_output(const char* topic, const nlohmann::json& payload) {
     std::string json_str = payload.dump();
     LOG(INFO) << "[MQTT] topic=" << topic << " payload=" << json_str;
+    return json_str.size();
+}
+
+template<typename T>
+void LogSink::log_batch(utils::Span<const T> msgs) {
+    if (!running_ || msgs.empty()) return;
 
+    uint64_t bytes = 0;
+    for (const T& msg : msgs) {
+        const char* topic = nullptr;
+        nlohmann::json payload = encode(msg, topic);
+        bytes += log_output(topic, payload);
+    }
+
+    // One stats update per batch
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    stats_.messages_sent++;
-    stats_.bytes_sent += json_str.size();
+    stats_.messages_sent += msgs.size();
+    stats_.bytes_sent += bytes;
     stats_.last_send_timestamp_ns = utils::now_ns();
 }
 
 void LogSink::send(const vss_Signal& msg) {
-    if (!running_) return;
+    log_batch(utils::Span<const vss_Signal>(&msg, 1));
+}
+
+void LogSink::send(const telemetry_events_Event& msg) {
+    log_batch(utils::Span<const telemetry_events_Event>(&msg, 1));
+}
+
+void LogSink::send(const telemetry_metrics_Gauge& msg) {
+    log_batch(utils::Span<const telemetry_metrics_Gauge>(&msg, 1));
+}
+
+void LogSink::send(const telemetry_metrics_Counter& msg) {
+    log_batch(utils::Span<const telemetry_metrics_Counter>(&msg, 1));
+}
+
+void LogSink::send(const telemetry_metrics_Histogram& msg) {
+    log_batch(utils::Span<const telemetry_metrics_Histogram>(&msg, 1));
+}
 
+void LogSink::send(const telemetry_logs_LogEntry& msg) {
+    log_batch(utils::Span<const telemetry_logs_LogEntry>(&msg, 1));
+}
+
+void LogSink::send(const telemetry_diagnostics_ScalarMeasurement& msg) {
+    log_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement>(&msg, 1));
+}
+
+void LogSink::send(const telemetry_diagnostics_VectorMeasurement& msg) {
+    log_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement>(&msg, 1));
+}
+
+void LogSink::send_batch(utils::Span<const vss_Signal> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_events_Event> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_metrics_Counter> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) {
+    log_batch(msgs);
+}
+
+void LogSink::send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) {
+    log_batch(msgs);
+}
+
+nlohmann::json LogSink::encode(const vss_Signal& msg, const char*& topic) {
     nlohmann::json payload = {
         {"header", encode_header(msg.header)},
         {"path", msg.path ? msg.path : ""},
@@ -111,12 +187,11 @@ void LogSink::send(const vss_Signal& msg) {
             break;
     }
 
-    log_output("v1/vss/signals", payload);
+    topic = "v1/vss/signals";
+    return payload;
 }
 
-void LogSink::send(const telemetry_events_Event& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_events_Event& msg, const char*& topic) {
     nlohmann::json payload = {
         {"header", encode_header(msg.header)},
         {"event_id", msg.event_id ? msg.event_id : ""},
@@ -142,12 +217,11 @@ void LogSink::send(const telemetry_events_Event& msg) {
         payload["context_signal_count"] = msg.context._length;
     }
 
-    log_output("v1/events", payload);
+    topic = "v1/events";
+    return payload;
 }
 
-void LogSink::send(const telemetry_metrics_Gauge& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_metrics_Gauge& msg, const char*& topic) {
     nlohmann::json labels = nlohmann::json::object();
     for (uint32_t i = 0; i < msg.labels._length; ++i) {
         const auto& kv = msg.labels._buffer[i];
@@ -163,12 +237,11 @@ void LogSink::send(const telemetry_metrics_Gauge& msg) {
         {"value", msg.value}
     };
 
-    log_output("v1/telemetry/gauges", payload);
+    topic = "v1/telemetry/gauges";
+    return payload;
 }
 
-void LogSink::send(const telemetry_metrics_Counter& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_metrics_Counter& msg, const char*& topic) {
     nlohmann::json labels = nlohmann::json::object();
     for (uint32_t i = 0; i < msg.labels._length; ++i) {
         const auto& kv = msg.labels._buffer[i];
@@ -184,12 +257,11 @@ void LogSink::send(const telemetry_metrics_Counter& msg) {
         {"value", msg.value}
     };
 
-    log_output("v1/telemetry/counters", payload);
+    topic = "v1/telemetry/counters";
+    return payload;
 }
 
-void LogSink::send(const telemetry_metrics_Histogram& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_metrics_Histogram& msg, const char*& topic) {
     nlohmann::json labels = nlohmann::json::object();
     for (uint32_t i = 0; i < msg.labels._length; ++i) {
         const auto& kv = msg.labels._buffer[i];
@@ -216,12 +288,11 @@ void LogSink::send(const telemetry_metrics_Histogram& msg) {
         {"buckets", buckets}
     };
 
-    log_output("v1/telemetry/histograms", payload);
+    topic = "v1/telemetry/histograms";
+    return payload;
 }
 
-void LogSink::send(const telemetry_logs_LogEntry& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_logs_LogEntry& msg, const char*& topic) {
     nlohmann::json fields = nlohmann::json::object();
     for (uint32_t i = 0; i < msg.fields._length; ++i) {
         const auto& kv = msg.fields._buffer[i];
@@ -238,12 +309,12 @@ void LogSink::send(const telemetry_logs_LogEntry& msg) {
         {"fields", fields}
     };
 
-    log_output("v1/logs", payload);
+    topic = "v1/logs";
+    return payload;
 }
 
-void LogSink::send(const telemetry_diagnostics_ScalarMeasurement& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_diagnostics_ScalarMeasurement& msg,
+                               const char*& topic) {
     nlohmann::json payload = {
         {"header", encode_header(msg.header)},
         {"variable_id", msg.variable_id ? msg.variable_id : ""},
@@ -252,12 +323,12 @@ void LogSink::send(const telemetry_diagnostics_ScalarMeasurement& msg) {
         {"value", msg.value}
     };
 
-    log_output("v1/diagnostics/scalar", payload);
+    topic = "v1/diagnostics/scalar";
+    return payload;
 }
 
-void LogSink::send(const telemetry_diagnostics_VectorMeasurement& msg) {
-    if (!running_) return;
-
+nlohmann::json LogSink::encode(const telemetry_diagnostics_VectorMeasurement& msg,
+                               const char*& topic) {
     nlohmann::json values = nlohmann::json::array();
     for (uint32_t i = 0; i < msg.values._length; ++i) {
         values.push_back(msg.values._buffer[i]);
@@ -271,7 +342,22 @@ void LogSink::send(const telemetry_diagnostics_VectorMeasurement& msg) {
         {"values", values}
     };
 
-    log_output("v1/diagnostics/vector", payload);
+    topic = "v1/diagnostics/vector";
+    return payload;
+}
+
+void LogSink::send_serialized(const SerializedMessage& msg) {
+    if (!running_) return;
+
+    // Raw CDR is not worth rendering; log what would be forwarded
+    LOG(INFO) << "[MQTT] topic=" << msg.topic << " type=" << msg.type_name
+              << " cdr_bytes=" << msg.size
+              << " source_timestamp_ns=" << msg.source_timestamp_ns;
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.messages_sent++;
+    stats_.bytes_sent += msg.size;
+    stats_.last_send_timestamp_ns = utils::now_ns();
 }
 
 }  // namespace sinks
@@ -51,13 +51,40 @@ public:
     void send(const telemetry_diagnostics_ScalarMeasurement& msg) override;
     void send(const telemetry_diagnostics_VectorMeasurement& msg) override;
 
+    void send_batch(utils::Span<const vss_Signal> msgs) override;
+    void send_batch(utils::Span<const telemetry_events_Event> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Counter> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) override;
+    void send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) override;
+    void send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) override;
+    void send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) override;
+
+    bool accepts_serialized() const override { return true; }
+    void send_serialized(const SerializedMessage& msg) override;
+
     bool healthy() const override { return running_; }
     SinkStats stats() const override;
     std::string name() const override { return "LogSink"; }
 
 private:
+    // Logs and counts a batch; stats are locked once per batch
+    template<typename T>
+    void log_batch(utils::Span<const T> msgs);
+
+    // JSON payload of a message and the topic it would be published on
+    nlohmann::json encode(const vss_Signal& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_events_Event& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_metrics_Gauge& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_metrics_Counter& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_metrics_Histogram& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_logs_LogEntry& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_diagnostics_ScalarMeasurement& msg, const char*& topic);
+    nlohmann::json encode(const telemetry_diagnostics_VectorMeasurement& msg, const char*& topic);
+
     nlohmann::json encode_header(const vss_types_Header& header);
-    void log_output(const std::string& topic, const nlohmann::json& payload);
+    // Returns the payload size in bytes
+    size_t log_output(const char* topic, const nlohmann::json& payload);
 
     std::atomic<bool> running_{false};
     mutable std::mutex stats_mutex_;
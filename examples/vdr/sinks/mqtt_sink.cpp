@@ -14,16 +14,70 @@
 // limitations under the License.
 
 #include "vdr/sinks/mqtt_sink.hpp"
+#include "vdr/sinks/json_encoder.hpp"
+#include "vdr/sinks/msgpack_encoder.hpp"
+#include "vdr/sinks/protobuf_encoder.hpp"
+#include "vdr/sinks/signal_batch_encoder.hpp"
 #include "common/time_utils.hpp"
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <cstring>
+#include <type_traits>
+#include <vector>
 
 namespace vdr {
 namespace sinks {
 
+namespace {
+
+// Topic of each message type below topic_prefix
+const char* mqtt_topic(const vss_Signal&) { return "vss/signals"; }
+const char* mqtt_topic(const telemetry_events_Event&) { return "events"; }
+const char* mqtt_topic(const telemetry_metrics_Gauge&) { return "telemetry/gauges"; }
+const char* mqtt_topic(const telemetry_metrics_Counter&) { return "telemetry/counters"; }
+const char* mqtt_topic(const telemetry_metrics_Histogram&) { return "telemetry/histograms"; }
+const char* mqtt_topic(const telemetry_logs_LogEntry&) { return "logs"; }
+const char* mqtt_topic(const telemetry_diagnostics_ScalarMeasurement&) {
+    return "diagnostics/scalar";
+}
+const char* mqtt_topic(const telemetry_diagnostics_VectorMeasurement&) {
+    return "diagnostics/vector";
+}
+
+// offboard.proto has schemas for events (and incidents, which no sink receives)
+template<typename T>
+constexpr bool kHasProtobuf = std::is_same_v<T, telemetry_events_Event>;
+
+template<typename T>
+constexpr bool kHasSignalBatch = std::is_same_v<T, vss_Signal>;
+
+// Compression works on framed batches; unbatched payloads go out as-is
+CompressionConfig batch_compression(const MqttConfig& config) {
+    if (config.compression.algorithm != Compression::None && config.batch.max_messages <= 1) {
+        LOG(WARNING) << "MqttSink: compression needs batching (batch_size > 1), "
+                     << "publishing uncompressed";
+        return {};
+    }
+    return config.compression;
+}
+
+}  // namespace
+
 MqttSink::MqttSink(const MqttConfig& config)
-    : config_(config) {
+    : config_(config),
+      queue_(config.queue_capacity, [&config](PendingMessage& slot) {
+          slot.payload.reserve(config.payload_reserve);
+      }),
+      batcher_(config.batch),
+      compressor_(batch_compression(config)) {
+    for (const auto& [topic, format] : config_.topic_formats) {
+        if ((format == PayloadFormat::Protobuf && topic != "events") ||
+            (format == PayloadFormat::SignalBatch && topic != "vss/signals")) {
+            LOG(WARNING) << "MqttSink: " << to_string(format) << " does not apply to "
+                         << topic << ", publishing JSON";
+        }
+    }
     mosquitto_lib_init();
 }
 
@@ -93,7 +147,7 @@ void MqttSink::stop() {
     running_ = false;
 
     // Wake up publish thread
-    queue_cv_.notify_all();
+    queue_.notify();
 
     if (publish_thread_.joinable()) {
         publish_thread_.join();
@@ -108,441 +162,283 @@ void MqttSink::stop() {
 
     connected_ = false;
 
-    LOG(INFO) << "MqttSink stopped. Stats: sent=" << stats_.messages_sent
-              << " failed=" << stats_.messages_failed
+    SinkStats final_stats;
+    uint64_t publishes;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        final_stats = stats_;
+        publishes = publishes_;
+    }
+    LOG(INFO) << "MqttSink stopped. Stats: sent=" << final_stats.messages_sent
+              << " publishes=" << publishes
+              << " failed=" << final_stats.messages_failed
               << " dropped=" << dropped_.load();
+    if (compressor_.enabled()) {
+        LOG(INFO) << "MqttSink " << to_string(compressor_.config().algorithm)
+                  << " compression: ratio " << final_stats.compression_ratio() << ", "
+                  << final_stats.compress_cpu_ms_per_mb() << " ms CPU per MiB";
+    }
 }
 
 void MqttSink::flush() {
-    // Wait for queue to drain
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    queue_cv_.wait_for(lock, std::chrono::seconds(5), [this] {
-        return queue_.empty();
-    });
+    if (!running_) {
+        return;
+    }
+    // Publish open batches, then wait for queue and batches to drain
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    flush_requested_ = true;
+    queue_.notify();
+    flush_done_.wait_for(lock, std::chrono::seconds(5),
+                         [this] { return !flush_requested_ || !running_; });
 }
 
-void MqttSink::publish_loop() {
-    while (running_) {
-        PendingMessage msg;
-
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this] {
-                return !queue_.empty() || !running_;
-            });
-
-            if (!running_ && queue_.empty()) {
-                break;
-            }
-
-            if (queue_.empty()) {
-                continue;
-            }
-
-            msg = std::move(queue_.front());
-            queue_.pop();
-        }
+void MqttSink::finish_flush() {
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+        flush_requested_ = false;
+    }
+    flush_done_.notify_all();
+}
 
-        // Publish if connected
-        if (connected_ && mosq_) {
-            int rc = mosquitto_publish(mosq_, nullptr,
-                                       msg.topic.c_str(),
-                                       static_cast<int>(msg.payload.size()),
-                                       msg.payload.c_str(),
-                                       config_.qos,
-                                       config_.retain);
-            if (rc != MOSQ_ERR_SUCCESS) {
-                LOG(WARNING) << "MqttSink: Publish failed - " << mosquitto_strerror(rc);
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                stats_.messages_failed++;
-            } else {
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                stats_.messages_sent++;
-                stats_.bytes_sent += msg.payload.size();
-                stats_.last_send_timestamp_ns = utils::now_ns();
-            }
+void MqttSink::publish(std::string& full_topic, const char* topic, const char* data,
+                       size_t size, size_t messages) {
+    full_topic.assign(config_.topic_prefix);
+    full_topic += '/';
+    full_topic += topic;
+
+    // Publish if connected
+    if (connected_ && mosq_) {
+        int rc = mosquitto_publish(mosq_, nullptr,
+                                   full_topic.c_str(),
+                                   static_cast<int>(size),
+                                   data,
+                                   config_.qos,
+                                   config_.retain);
+        if (rc != MOSQ_ERR_SUCCESS) {
+            LOG(WARNING) << "MqttSink: Publish failed - " << mosquitto_strerror(rc);
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.messages_failed += messages;
         } else {
-            // Not connected, message is lost (or could re-queue)
             std::lock_guard<std::mutex> lock(stats_mutex_);
-            stats_.messages_failed++;
+            stats_.messages_sent += messages;
+            stats_.bytes_sent += size;
+            stats_.last_send_timestamp_ns = utils::now_ns();
+            ++publishes_;
         }
+    } else {
+        // Not connected, messages are lost (or could re-queue)
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.messages_failed += messages;
     }
 }
 
-void MqttSink::publish(const std::string& topic, const nlohmann::json& payload) {
-    if (!running_) return;
-
-    std::string full_topic = config_.topic_prefix + "/" + topic;
-    std::string json_str = payload.dump();
-
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        if (queue_.size() >= MAX_QUEUE_SIZE) {
-            // Drop oldest message
-            queue_.pop();
-            ++dropped_;
+void MqttSink::publish_loop() {
+    // Full topic, rebuilt in place for every publish
+    std::string full_topic;
+    std::string compressed;
+    auto emit = [&](const char* topic, const char* data, size_t size, size_t messages) {
+        if (compressor_.enabled()) {
+            int64_t cpu_start = utils::thread_cpu_ns();
+            std::string_view payload = compressor_.compress({data, size}, compressed);
+            int64_t cpu_ns = utils::thread_cpu_ns() - cpu_start;
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.bytes_uncompressed += size;
+                stats_.bytes_compressed += payload.size();
+                stats_.compress_cpu_ns += static_cast<uint64_t>(cpu_ns);
+            }
+            data = payload.data();
+            size = payload.size();
         }
-        queue_.push({full_topic, json_str});
-        ++queued_;
-    }
-    queue_cv_.notify_one();
-}
+        publish(full_topic, topic, data, size, messages);
+    };
+    auto steady_ns = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
 
-nlohmann::json MqttSink::encode_header(const vss_types_Header& header) {
-    return {
-        {"source_id", header.source_id ? header.source_id : ""},
-        {"timestamp_ns", header.timestamp_ns},
-        {"seq_num", header.seq_num},
-        {"correlation_id", header.correlation_id ? header.correlation_id : ""}
+    int64_t now = 0;
+    auto forward = [&](PendingMessage& msg) {
+        if (batcher_.enabled()) {
+            batcher_.add(msg.topic, msg.payload, now, emit);
+        } else {
+            emit(msg.topic, msg.payload.data(), msg.payload.size(), 1);
+        }
     };
-}
 
-// Helper to encode a struct field value to JSON
-nlohmann::json encode_struct_field_value(const vss_types_StructField& field) {
-    switch (field.type) {
-        case vss_types_VALUE_TYPE_BOOL:
-            return field.bool_value;
-        case vss_types_VALUE_TYPE_INT8:
-            return static_cast<int>(field.int8_value);
-        case vss_types_VALUE_TYPE_INT16:
-            return field.int16_value;
-        case vss_types_VALUE_TYPE_INT32:
-            return field.int32_value;
-        case vss_types_VALUE_TYPE_INT64:
-            return field.int64_value;
-        case vss_types_VALUE_TYPE_UINT8:
-            return field.uint8_value;
-        case vss_types_VALUE_TYPE_UINT16:
-            return field.uint16_value;
-        case vss_types_VALUE_TYPE_UINT32:
-            return field.uint32_value;
-        case vss_types_VALUE_TYPE_UINT64:
-            return field.uint64_value;
-        case vss_types_VALUE_TYPE_FLOAT:
-            return field.float_value;
-        case vss_types_VALUE_TYPE_DOUBLE:
-            return field.double_value;
-        case vss_types_VALUE_TYPE_STRING:
-            return field.string_value ? field.string_value : "";
-        case vss_types_VALUE_TYPE_BOOL_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < field.bool_array._length; ++i) {
-                arr.push_back(static_cast<bool>(field.bool_array._buffer[i]));
-            }
-            return arr;
+    // Drain everything queued, emit batches that are due, then sleep until
+    // producers notify or the next batch deadline; once stopped, exit only
+    // when the queue is empty and every batch is out
+    const int64_t max_sleep_ns = std::chrono::nanoseconds(std::chrono::milliseconds(100)).count();
+    for (;;) {
+        now = steady_ns();
+        size_t consumed = queue_.consume(forward, kPublishBurst);
+        batcher_.flush_due(now, emit);
+        if (consumed > 0) {
+            continue;
         }
-        case vss_types_VALUE_TYPE_INT32_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < field.int32_array._length; ++i) {
-                arr.push_back(field.int32_array._buffer[i]);
-            }
-            return arr;
+        if (flush_requested_) {
+            batcher_.flush_all(emit);
+            finish_flush();
         }
-        case vss_types_VALUE_TYPE_FLOAT_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < field.float_array._length; ++i) {
-                arr.push_back(field.float_array._buffer[i]);
-            }
-            return arr;
+        if (!running_) {
+            break;
         }
-        case vss_types_VALUE_TYPE_DOUBLE_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < field.double_array._length; ++i) {
-                arr.push_back(field.double_array._buffer[i]);
-            }
-            return arr;
+        int64_t sleep_ns = std::min(batcher_.next_deadline() - now, max_sleep_ns);
+        if (sleep_ns > 0) {
+            queue_.wait_for(std::chrono::nanoseconds(sleep_ns));
         }
-        default:
-            return nullptr;
     }
+    batcher_.flush_all(emit);
+    finish_flush();  // wakes a flush() that raced stop()
 }
 
-// Helper to encode a StructValue to JSON
-nlohmann::json encode_struct_value(const vss_types_StructValue& struct_val) {
-    nlohmann::json obj = nlohmann::json::object();
+PayloadFormat MqttSink::format_for(const char* topic) const {
+    auto it = config_.topic_formats.find(std::string_view(topic));
+    return it != config_.topic_formats.end() ? it->second : config_.format;
+}
 
-    // Add type name if present
-    if (struct_val.type_name && strlen(struct_val.type_name) > 0) {
-        obj["_type"] = struct_val.type_name;
-    }
+template<typename T>
+void MqttSink::publish_batch(utils::Span<const T> msgs) {
+    if (!running_ || msgs.empty()) return;
 
-    // Encode all fields
-    for (uint32_t i = 0; i < struct_val.fields._length; ++i) {
-        const auto& field = struct_val.fields._buffer[i];
-        if (field.name) {
-            obj[field.name] = encode_struct_field_value(field);
+    const char* topic = mqtt_topic(msgs[0]);
+    PayloadFormat format = format_for(topic);
+    if constexpr (kHasSignalBatch<T>) {
+        if (format == PayloadFormat::SignalBatch) {
+            publish_signal_batch(msgs);
+            return;
         }
     }
+    if ((format == PayloadFormat::Protobuf && !kHasProtobuf<T>) ||
+        format == PayloadFormat::SignalBatch) {
+        format = PayloadFormat::Json;
+    }
 
-    return obj;
-}
-
-void MqttSink::send(const vss_Signal& msg) {
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"path", msg.path ? msg.path : ""},
-        {"quality", static_cast<int>(msg.quality)},
-        {"value_type", static_cast<int>(msg.value.type)}
-    };
-
-    switch (msg.value.type) {
-        case vss_types_VALUE_TYPE_BOOL:
-            payload["value"] = msg.value.bool_value;
-            break;
-        case vss_types_VALUE_TYPE_INT8:
-            payload["value"] = static_cast<int>(msg.value.int8_value);
-            break;
-        case vss_types_VALUE_TYPE_INT16:
-            payload["value"] = msg.value.int16_value;
-            break;
-        case vss_types_VALUE_TYPE_INT32:
-            payload["value"] = msg.value.int32_value;
-            break;
-        case vss_types_VALUE_TYPE_INT64:
-            payload["value"] = msg.value.int64_value;
-            break;
-        case vss_types_VALUE_TYPE_UINT8:
-            payload["value"] = msg.value.uint8_value;
-            break;
-        case vss_types_VALUE_TYPE_UINT16:
-            payload["value"] = msg.value.uint16_value;
-            break;
-        case vss_types_VALUE_TYPE_UINT32:
-            payload["value"] = msg.value.uint32_value;
-            break;
-        case vss_types_VALUE_TYPE_UINT64:
-            payload["value"] = msg.value.uint64_value;
-            break;
-        case vss_types_VALUE_TYPE_FLOAT:
-            payload["value"] = msg.value.float_value;
-            break;
-        case vss_types_VALUE_TYPE_DOUBLE:
-            payload["value"] = msg.value.double_value;
-            break;
-        case vss_types_VALUE_TYPE_STRING:
-            payload["value"] = msg.value.string_value ? msg.value.string_value : "";
-            break;
-
-        // Array types
-        case vss_types_VALUE_TYPE_BOOL_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.bool_array._length; ++i) {
-                arr.push_back(static_cast<bool>(msg.value.bool_array._buffer[i]));
-            }
-            payload["value"] = arr;
-            break;
+    // Binary formats are written straight into the claimed slot's buffer;
+    // a JSON document is built and dumped first, then copied in
+    size_t pushed = 0;
+    std::string json;
+    for (const T& msg : msgs) {
+        if (format == PayloadFormat::Json) {
+            json = encode_json(msg).dump();
         }
-        case vss_types_VALUE_TYPE_INT32_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.int32_array._length; ++i) {
-                arr.push_back(msg.value.int32_array._buffer[i]);
+        bool queued = queue_.try_push([&](PendingMessage& slot) {
+            slot.topic = topic;
+            slot.payload.clear();
+            if (format == PayloadFormat::MessagePack) {
+                encode_msgpack(msg, slot.payload);
+            } else if (format == PayloadFormat::Json) {
+                slot.payload.assign(json);
+            } else if constexpr (kHasProtobuf<T>) {
+                encode_protobuf(msg, slot.payload);
             }
-            payload["value"] = arr;
-            break;
-        }
-        case vss_types_VALUE_TYPE_INT64_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.int64_array._length; ++i) {
-                arr.push_back(msg.value.int64_array._buffer[i]);
-            }
-            payload["value"] = arr;
-            break;
-        }
-        case vss_types_VALUE_TYPE_FLOAT_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.float_array._length; ++i) {
-                arr.push_back(msg.value.float_array._buffer[i]);
-            }
-            payload["value"] = arr;
-            break;
-        }
-        case vss_types_VALUE_TYPE_DOUBLE_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.double_array._length; ++i) {
-                arr.push_back(msg.value.double_array._buffer[i]);
-            }
-            payload["value"] = arr;
-            break;
-        }
-        case vss_types_VALUE_TYPE_STRING_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.string_array._length; ++i) {
-                arr.push_back(msg.value.string_array._buffer[i] ? msg.value.string_array._buffer[i] : "");
-            }
-            payload["value"] = arr;
-            break;
-        }
-
-        // Struct types
-        case vss_types_VALUE_TYPE_STRUCT:
-            payload["value"] = encode_struct_value(msg.value.struct_value);
-            break;
-
-        case vss_types_VALUE_TYPE_STRUCT_ARRAY: {
-            nlohmann::json arr = nlohmann::json::array();
-            for (uint32_t i = 0; i < msg.value.struct_array._length; ++i) {
-                arr.push_back(encode_struct_value(msg.value.struct_array._buffer[i]));
-            }
-            payload["value"] = arr;
-            break;
+        });
+        if (queued) {
+            ++pushed;
+        } else {
+            ++dropped_;
         }
-
-        case vss_types_VALUE_TYPE_EMPTY:
-            payload["value"] = nullptr;
-            break;
-
-        default:
-            payload["value"] = "<unsupported_type>";
-            break;
     }
 
-    publish("vss/signals", payload);
+    // One wake-up per batch, and only if the publish thread sleeps
+    if (pushed > 0) {
+        queued_ += pushed;
+        queue_.notify();
+    }
 }
 
-void MqttSink::send(const telemetry_events_Event& msg) {
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"event_id", msg.event_id ? msg.event_id : ""},
-        {"category", msg.category ? msg.category : ""},
-        {"event_type", msg.event_type ? msg.event_type : ""},
-        {"severity", static_cast<int>(msg.severity)}
-    };
-
-    // Encode attributes as key-value pairs
-    if (msg.attributes._length > 0) {
-        nlohmann::json attrs = nlohmann::json::object();
-        for (uint32_t i = 0; i < msg.attributes._length; ++i) {
-            const auto& kv = msg.attributes._buffer[i];
-            if (kv.key && kv.value) {
-                attrs[kv.key] = kv.value;
-            }
-        }
-        payload["attributes"] = attrs;
+void MqttSink::publish_signal_batch(utils::Span<const vss_Signal> msgs) {
+    const char* topic = mqtt_topic(msgs[0]);
+    std::lock_guard<std::mutex> lock(signal_batch_mutex_);
+    if (resend_dictionary_.exchange(false)) {
+        signal_batch_.resend_dictionary();
     }
+    signal_batch_.encode(msgs, signal_dictionary_, signal_frame_);
 
-    // Record context signal count
-    if (msg.context._length > 0) {
-        payload["context_signal_count"] = msg.context._length;
+    auto push = [&](const std::string& frame) {
+        return queue_.try_push([&](PendingMessage& slot) {
+            slot.topic = topic;
+            slot.payload.assign(frame);
+        });
+    };
+    // A batch whose dictionary frame was dropped could not be decoded: drop
+    // it too and send the whole dictionary with the next one. Past the
+    // queue each frame counts as one message in SinkStats
+    bool dictionary_queued = signal_dictionary_.empty() || push(signal_dictionary_);
+    if (!dictionary_queued) {
+        signal_batch_.resend_dictionary();
+    }
+    if (dictionary_queued && push(signal_frame_)) {
+        queued_ += msgs.size();
+        queue_.notify();
+    } else {
+        dropped_ += msgs.size();
     }
-
-    publish("events", payload);
 }
 
-void MqttSink::send(const telemetry_metrics_Gauge& msg) {
-    nlohmann::json labels = nlohmann::json::object();
-    for (uint32_t i = 0; i < msg.labels._length; ++i) {
-        const auto& kv = msg.labels._buffer[i];
-        if (kv.key && kv.value) {
-            labels[kv.key] = kv.value;
-        }
-    }
+void MqttSink::send(const vss_Signal& msg) {
+    publish_batch(utils::Span<const vss_Signal>(&msg, 1));
+}
 
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"name", msg.name ? msg.name : ""},
-        {"labels", labels},
-        {"value", msg.value}
-    };
+void MqttSink::send(const telemetry_events_Event& msg) {
+    publish_batch(utils::Span<const telemetry_events_Event>(&msg, 1));
+}
 
-    publish("telemetry/gauges", payload);
+void MqttSink::send(const telemetry_metrics_Gauge& msg) {
+    publish_batch(utils::Span<const telemetry_metrics_Gauge>(&msg, 1));
 }
 
 void MqttSink::send(const telemetry_metrics_Counter& msg) {
-    nlohmann::json labels = nlohmann::json::object();
-    for (uint32_t i = 0; i < msg.labels._length; ++i) {
-        const auto& kv = msg.labels._buffer[i];
-        if (kv.key && kv.value) {
-            labels[kv.key] = kv.value;
-        }
-    }
-
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"name", msg.name ? msg.name : ""},
-        {"labels", labels},
-        {"value", msg.value}
-    };
-
-    publish("telemetry/counters", payload);
+    publish_batch(utils::Span<const telemetry_metrics_Counter>(&msg, 1));
 }
 
 void MqttSink::send(const telemetry_metrics_Histogram& msg) {
-    nlohmann::json labels = nlohmann::json::object();
-    for (uint32_t i = 0; i < msg.labels._length; ++i) {
-        const auto& kv = msg.labels._buffer[i];
-        if (kv.key && kv.value) {
-            labels[kv.key] = kv.value;
-        }
-    }
+    publish_batch(utils::Span<const telemetry_metrics_Histogram>(&msg, 1));
+}
 
-    nlohmann::json buckets = nlohmann::json::array();
-    for (uint32_t i = 0; i < msg.buckets._length; ++i) {
-        const auto& bucket = msg.buckets._buffer[i];
-        buckets.push_back({
-            {"upper_bound", bucket.upper_bound},
-            {"cumulative_count", bucket.cumulative_count}
-        });
-    }
+void MqttSink::send(const telemetry_logs_LogEntry& msg) {
+    publish_batch(utils::Span<const telemetry_logs_LogEntry>(&msg, 1));
+}
 
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"name", msg.name ? msg.name : ""},
-        {"labels", labels},
-        {"sample_count", msg.sample_count},
-        {"sample_sum", msg.sample_sum},
-        {"buckets", buckets}
-    };
+void MqttSink::send(const telemetry_diagnostics_ScalarMeasurement& msg) {
+    publish_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement>(&msg, 1));
+}
 
-    publish("telemetry/histograms", payload);
+void MqttSink::send(const telemetry_diagnostics_VectorMeasurement& msg) {
+    publish_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement>(&msg, 1));
 }
 
-void MqttSink::send(const telemetry_logs_LogEntry& msg) {
-    nlohmann::json fields = nlohmann::json::object();
-    for (uint32_t i = 0; i < msg.fields._length; ++i) {
-        const auto& kv = msg.fields._buffer[i];
-        if (kv.key && kv.value) {
-            fields[kv.key] = kv.value;
-        }
-    }
+void MqttSink::send_batch(utils::Span<const vss_Signal> msgs) {
+    publish_batch(msgs);
+}
 
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"level", static_cast<int>(msg.level)},
-        {"component", msg.component ? msg.component : ""},
-        {"message", msg.message ? msg.message : ""},
-        {"fields", fields}
-    };
+void MqttSink::send_batch(utils::Span<const telemetry_events_Event> msgs) {
+    publish_batch(msgs);
+}
 
-    publish("logs", payload);
+void MqttSink::send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) {
+    publish_batch(msgs);
 }
 
-void MqttSink::send(const telemetry_diagnostics_ScalarMeasurement& msg) {
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"variable_id", msg.variable_id ? msg.variable_id : ""},
-        {"unit", msg.unit ? msg.unit : ""},
-        {"measurement_type", static_cast<int>(msg.measurement_type)},
-        {"value", msg.value}
-    };
+void MqttSink::send_batch(utils::Span<const telemetry_metrics_Counter> msgs) {
+    publish_batch(msgs);
+}
 
-    publish("diagnostics/scalar", payload);
+void MqttSink::send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) {
+    publish_batch(msgs);
 }
 
-void MqttSink::send(const telemetry_diagnostics_VectorMeasurement& msg) {
-    nlohmann::json values = nlohmann::json::array();
-    for (uint32_t i = 0; i < msg.values._length; ++i) {
-        values.push_back(msg.values._buffer[i]);
-    }
+void MqttSink::send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) {
+    publish_batch(msgs);
+}
 
-    nlohmann::json payload = {
-        {"header", encode_header(msg.header)},
-        {"variable_id", msg.variable_id ? msg.variable_id : ""},
-        {"unit", msg.unit ? msg.unit : ""},
-        {"measurement_type", static_cast<int>(msg.measurement_type)},
-        {"values", values}
-    };
+void MqttSink::send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) {
+    publish_batch(msgs);
+}
 
-    publish("diagnostics/vector", payload);
+void MqttSink::send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) {
+    publish_batch(msgs);
 }
 
 bool MqttSink::healthy() const {
@@ -559,6 +455,8 @@ void MqttSink::on_connect(struct mosquitto*, void* obj, int rc) {
     auto* self = static_cast<MqttSink*>(obj);
     if (rc == 0) {
         self->connected_ = true;
+        // Subscribers that joined while we were away need the dictionary
+        self->resend_dictionary_ = true;
         LOG(INFO) << "MqttSink: Connected to broker";
     } else {
         self->connected_ = false;
@@ -21,17 +21,22 @@
 /// Reference implementation for MQTT publishing. Requires libmosquitto.
 /// This demonstrates how a customer would implement a real output sink.
 
+#include "common/mpsc_ring.hpp"
 #include "vdr/output_sink.hpp"
+#include "vdr/sinks/batch_compressor.hpp"
+#include "vdr/sinks/payload_format.hpp"
+#include "vdr/sinks/signal_batch_encoder.hpp"
+#include "vdr/sinks/topic_batcher.hpp"
 
-#include <nlohmann/json.hpp>
 #include <mosquitto.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
-#include <queue>
-#include <condition_variable>
 
 namespace vdr {
 namespace sinks {
@@ -47,19 +52,47 @@ struct MqttConfig {
     int qos = 1;  // 0=at most once, 1=at least once, 2=exactly once
     bool retain = false;
     std::string topic_prefix = "vdr/v1";
+
+    // Publish queue: slots (rounded up to a power of two) and the payload
+    // bytes reserved per slot; longer payloads grow their slot once
+    size_t queue_capacity = 16384;
+    size_t payload_reserve = 512;
+
+    // Per-topic batching of queued messages (offboard: section)
+    BatchConfig batch;
+
+    // Compression of framed batches (offboard: section); needs batching
+    CompressionConfig compression;
+
+    // Payload encoding, overridable per topic below topic_prefix
+    // (e.g. "vss/signals"); topics without a Protobuf schema (all but
+    // "events") publish JSON when set to Protobuf, and all but
+    // "vss/signals" when set to SignalBatch
+    PayloadFormat format = PayloadFormat::Json;
+    std::map<std::string, PayloadFormat, std::less<>> topic_formats;
 };
 
 /// OutputSink that publishes to MQTT broker via Mosquitto.
 ///
 /// Features:
-/// - Async publishing with background thread
+/// - Async publishing with background thread, fed through a lock-free
+///   ring of preallocated slots (utils::MpscRing); when it is full, new
+///   messages are dropped and counted
+/// - Per-topic batching (TopicBatcher): one framed MQTT message per batch,
+///   unless config.batch.max_messages is 1
+/// - Optional zstd/LZ4 compression of each batch (BatchCompressor); the
+///   ratio and CPU cost show in stats()
 /// - Automatic reconnection on disconnect
 /// - Message queuing during disconnection
-/// - JSON payload encoding
+/// - JSON, MessagePack, (events) Protobuf or (signals) dictionary-coded
+///   signal batch payloads, chosen per topic. A signal batch's new
+///   dictionary entries are queued just ahead of it on the same topic, and
+///   a full dictionary snapshot follows every (re)connect
 ///
 /// Thread-safe.
 class MqttSink : public OutputSink {
 public:
+    /// Throws if config.compression cannot be set up (see BatchCompressor).
     explicit MqttSink(const MqttConfig& config = MqttConfig{});
     ~MqttSink() override;
 
@@ -79,6 +112,15 @@ public:
     void send(const telemetry_diagnostics_ScalarMeasurement& msg) override;
     void send(const telemetry_diagnostics_VectorMeasurement& msg) override;
 
+    void send_batch(utils::Span<const vss_Signal> msgs) override;
+    void send_batch(utils::Span<const telemetry_events_Event> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Gauge> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Counter> msgs) override;
+    void send_batch(utils::Span<const telemetry_metrics_Histogram> msgs) override;
+    void send_batch(utils::Span<const telemetry_logs_LogEntry> msgs) override;
+    void send_batch(utils::Span<const telemetry_diagnostics_ScalarMeasurement> msgs) override;
+    void send_batch(utils::Span<const telemetry_diagnostics_VectorMeasurement> msgs) override;
+
     bool healthy() const override;
     SinkStats stats() const override;
     std::string name() const override { return "MqttSink"; }
@@ -89,13 +131,26 @@ public:
 private:
     // Internal message for publish queue
     struct PendingMessage {
-        std::string topic;
-        std::string payload;
+        const char* topic = nullptr;  // below topic_prefix; a literal from mqtt_topic()
+        std::string payload;          // reserved up front and reused
     };
 
+    // Messages published per consume() before checking for shutdown
+    static constexpr size_t kPublishBurst = 256;
+
     void publish_loop();
-    void publish(const std::string& topic, const nlohmann::json& payload);
-    nlohmann::json encode_header(const vss_types_Header& header);
+    // Publish thread: clear flush_requested_ and wake flush()
+    void finish_flush();
+    // Publish one payload (a framed batch of `messages`) below topic_prefix
+    void publish(std::string& full_topic, const char* topic, const char* data, size_t size,
+                 size_t messages);
+    // Encodes a batch and queues it with a single wake-up
+    template<typename T>
+    void publish_batch(utils::Span<const T> msgs);
+    // One EncodedSignalBatch frame, after its dictionary frame if any
+    void publish_signal_batch(utils::Span<const vss_Signal> msgs);
+
+    PayloadFormat format_for(const char* topic) const;
 
     // Mosquitto callbacks
     static void on_connect(struct mosquitto* mosq, void* obj, int rc);
@@ -108,11 +163,25 @@ private:
     std::atomic<bool> running_{false};
     std::atomic<bool> connected_{false};
 
-    // Publish queue
-    std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
-    std::queue<PendingMessage> queue_;
-    static constexpr size_t MAX_QUEUE_SIZE = 10000;
+    // Publish queue: any sending thread produces, publish_loop consumes
+    utils::MpscRing<PendingMessage> queue_;
+
+    // Batches of the publish thread; flush() asks it to emit them early and
+    // waits on flush_done_. flush_requested_ is written under flush_mutex_
+    // and read without it by the publish thread.
+    TopicBatcher batcher_;
+    std::atomic<bool> flush_requested_{false};
+    std::mutex flush_mutex_;
+    std::condition_variable flush_done_;
+    BatchCompressor compressor_;  // publish thread only
+
+    // SignalBatch session; the mutex keeps each dictionary frame in the
+    // queue ahead of the batches that use it
+    std::mutex signal_batch_mutex_;
+    SignalBatchEncoder signal_batch_;
+    std::string signal_dictionary_;  // frames of the last encode(); reused
+    std::string signal_frame_;
+    std::atomic<bool> resend_dictionary_{false};
 
     // Background thread for publishing
     std::thread publish_thread_;
@@ -122,6 +191,7 @@ private:
     SinkStats stats_;
     std::atomic<uint64_t> queued_{0};
     std::atomic<uint64_t> dropped_{0};
+    uint64_t publishes_ = 0;  // MQTT messages; guarded by stats_mutex_
 };
 
 }  // namespace sinks
@@ -0,0 +1,232 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/msgpack_encoder.hpp"
+#include "common/msgpack_writer.hpp"
+
+#include <type_traits>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+using utils::MsgpackWriter;
+
+void write_header(MsgpackWriter& w, const vss_types_Header& header) {
+    w.array(4);
+    w.string(header.source_id);
+    w.integer(header.timestamp_ns);
+    w.uinteger(header.seq_num);
+    w.string(header.correlation_id);
+}
+
+// Entries with a null key or value are skipped, as in the JSON payload
+void write_key_values(MsgpackWriter& w, const dds_sequence_vss_types_KeyValue& kvs) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < kvs._length; ++i) {
+        count += kvs._buffer[i].key && kvs._buffer[i].value;
+    }
+    w.map(count);
+    for (uint32_t i = 0; i < kvs._length; ++i) {
+        const auto& kv = kvs._buffer[i];
+        if (kv.key && kv.value) {
+            w.string(kv.key);
+            w.string(kv.value);
+        }
+    }
+}
+
+template<typename Seq, typename Fn>
+void write_array(MsgpackWriter& w, const Seq& seq, Fn&& write_element) {
+    w.array(seq._length);
+    for (uint32_t i = 0; i < seq._length; ++i) {
+        write_element(seq._buffer[i]);
+    }
+}
+
+void write_doubles(MsgpackWriter& w, const dds_sequence_double& seq) {
+    write_array(w, seq, [&w](double v) { w.float64(v); });
+}
+
+void write_struct_value(MsgpackWriter& w, const vss_types_StructValue& value);
+
+// Shared by Value and StructField, which carry the same scalar/array members
+template<typename V>
+void write_value(MsgpackWriter& w, const V& value) {
+    switch (value.type) {
+        case vss_types_VALUE_TYPE_BOOL: w.boolean(value.bool_value); return;
+        case vss_types_VALUE_TYPE_INT8: w.integer(value.int8_value); return;
+        case vss_types_VALUE_TYPE_INT16: w.integer(value.int16_value); return;
+        case vss_types_VALUE_TYPE_INT32: w.integer(value.int32_value); return;
+        case vss_types_VALUE_TYPE_INT64: w.integer(value.int64_value); return;
+        case vss_types_VALUE_TYPE_UINT8: w.uinteger(value.uint8_value); return;
+        case vss_types_VALUE_TYPE_UINT16: w.uinteger(value.uint16_value); return;
+        case vss_types_VALUE_TYPE_UINT32: w.uinteger(value.uint32_value); return;
+        case vss_types_VALUE_TYPE_UINT64: w.uinteger(value.uint64_value); return;
+        case vss_types_VALUE_TYPE_FLOAT: w.float32(value.float_value); return;
+        case vss_types_VALUE_TYPE_DOUBLE: w.float64(value.double_value); return;
+        case vss_types_VALUE_TYPE_STRING: w.string(value.string_value); return;
+        case vss_types_VALUE_TYPE_BOOL_ARRAY:
+            write_array(w, value.bool_array, [&w](bool v) { w.boolean(v); });
+            return;
+        case vss_types_VALUE_TYPE_INT32_ARRAY:
+            write_array(w, value.int32_array, [&w](int32_t v) { w.integer(v); });
+            return;
+        case vss_types_VALUE_TYPE_INT64_ARRAY:
+            write_array(w, value.int64_array, [&w](int64_t v) { w.integer(v); });
+            return;
+        case vss_types_VALUE_TYPE_FLOAT_ARRAY:
+            write_array(w, value.float_array, [&w](float v) { w.float32(v); });
+            return;
+        case vss_types_VALUE_TYPE_DOUBLE_ARRAY:
+            write_doubles(w, value.double_array);
+            return;
+        case vss_types_VALUE_TYPE_STRING_ARRAY:
+            write_array(w, value.string_array, [&w](const char* v) { w.string(v); });
+            return;
+        default:
+            break;
+    }
+
+    if constexpr (std::is_same_v<V, vss_types_Value>) {
+        if (value.type == vss_types_VALUE_TYPE_STRUCT) {
+            write_struct_value(w, value.struct_value);
+            return;
+        }
+        if (value.type == vss_types_VALUE_TYPE_STRUCT_ARRAY) {
+            write_array(w, value.struct_array,
+                        [&w](const vss_types_StructValue& v) { write_struct_value(w, v); });
+            return;
+        }
+    }
+    w.nil();  // EMPTY, or a type the member cannot carry
+}
+
+void write_struct_value(MsgpackWriter& w, const vss_types_StructValue& value) {
+    bool typed = value.type_name && value.type_name[0] != '\0';
+    uint32_t count = typed;
+    for (uint32_t i = 0; i < value.fields._length; ++i) {
+        count += value.fields._buffer[i].name != nullptr;
+    }
+    w.map(count);
+    if (typed) {
+        w.string("_type");
+        w.string(value.type_name);
+    }
+    for (uint32_t i = 0; i < value.fields._length; ++i) {
+        const auto& field = value.fields._buffer[i];
+        if (field.name) {
+            w.string(field.name);
+            write_value(w, field);
+        }
+    }
+}
+
+void write_signal(MsgpackWriter& w, const vss_Signal& msg) {
+    w.array(5);
+    write_header(w, msg.header);
+    w.string(msg.path);
+    w.uinteger(static_cast<uint32_t>(msg.quality));
+    w.uinteger(static_cast<uint32_t>(msg.value.type));
+    write_value(w, msg.value);
+}
+
+// Gauge and Counter share their layout
+template<typename Metric>
+void write_metric(MsgpackWriter& w, const Metric& msg) {
+    w.array(4);
+    write_header(w, msg.header);
+    w.string(msg.name);
+    write_key_values(w, msg.labels);
+    w.float64(msg.value);
+}
+
+}  // namespace
+
+void encode_msgpack(const vss_Signal& msg, std::string& out) {
+    MsgpackWriter w(out);
+    write_signal(w, msg);
+}
+
+void encode_msgpack(const telemetry_events_Event& msg, std::string& out) {
+    MsgpackWriter w(out);
+    w.array(7);
+    write_header(w, msg.header);
+    w.string(msg.event_id);
+    w.string(msg.category);
+    w.string(msg.event_type);
+    w.uinteger(static_cast<uint32_t>(msg.severity));
+    write_key_values(w, msg.attributes);
+    write_array(w, msg.context, [&w](const vss_Signal& s) { write_signal(w, s); });
+}
+
+void encode_msgpack(const telemetry_metrics_Gauge& msg, std::string& out) {
+    MsgpackWriter w(out);
+    write_metric(w, msg);
+}
+
+void encode_msgpack(const telemetry_metrics_Counter& msg, std::string& out) {
+    MsgpackWriter w(out);
+    write_metric(w, msg);
+}
+
+void encode_msgpack(const telemetry_metrics_Histogram& msg, std::string& out) {
+    MsgpackWriter w(out);
+    w.array(6);
+    write_header(w, msg.header);
+    w.string(msg.name);
+    write_key_values(w, msg.labels);
+    w.uinteger(msg.sample_count);
+    w.float64(msg.sample_sum);
+    write_array(w, msg.buckets, [&w](const telemetry_metrics_HistogramBucket& bucket) {
+        w.array(2);
+        w.float64(bucket.upper_bound);
+        w.uinteger(bucket.cumulative_count);
+    });
+}
+
+void encode_msgpack(const telemetry_logs_LogEntry& msg, std::string& out) {
+    MsgpackWriter w(out);
+    w.array(5);
+    write_header(w, msg.header);
+    w.uinteger(static_cast<uint32_t>(msg.level));
+    w.string(msg.component);
+    w.string(msg.message);
+    write_key_values(w, msg.fields);
+}
+
+void encode_msgpack(const telemetry_diagnostics_ScalarMeasurement& msg, std::string& out) {
+    MsgpackWriter w(out);
+    w.array(5);
+    write_header(w, msg.header);
+    w.string(msg.variable_id);
+    w.string(msg.unit);
+    w.uinteger(static_cast<uint32_t>(msg.measurement_type));
+    w.float64(msg.value);
+}
+
+void encode_msgpack(const telemetry_diagnostics_VectorMeasurement& msg, std::string& out) {
+    MsgpackWriter w(out);
+    w.array(5);
+    write_header(w, msg.header);
+    w.string(msg.variable_id);
+    w.string(msg.unit);
+    w.uinteger(static_cast<uint32_t>(msg.measurement_type));
+    write_doubles(w, msg.values);
+}
+
+}  // namespace sinks
+}  // namespace vdr
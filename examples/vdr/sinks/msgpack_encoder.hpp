@@ -0,0 +1,66 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/msgpack_encoder.hpp
+/// @brief MessagePack payloads written straight from the DDS structs
+///
+/// The compact format selected by SPECIFICATION.md for signals, metrics
+/// and logs. Each message is a MessagePack array with a fixed field order,
+/// so field names are not repeated in every payload; enums are integers
+/// and integers take their smallest encoding. Label and attribute lists
+/// stay maps. No document model is built: encode_msgpack() appends to the
+/// caller's buffer, which is cleared and reused between messages.
+///
+/// Layouts (consumers index by position; new fields are only appended):
+///   header:       [source_id, timestamp_ns, seq_num, correlation_id]
+///   Signal:       [header, path, quality, value_type, value]
+///   Event:        [header, event_id, category, event_type, severity,
+///                  {attributes}, [context Signal, ...]]
+///   Gauge:        [header, name, {labels}, value]
+///   Counter:      [header, name, {labels}, value]
+///   Histogram:    [header, name, {labels}, sample_count, sample_sum,
+///                  [[upper_bound, cumulative_count], ...]]
+///   LogEntry:     [header, level, component, message, {fields}]
+///   Scalar:       [header, variable_id, unit, measurement_type, value]
+///   Vector:       [header, variable_id, unit, measurement_type, [values]]
+///
+/// A value is nil (EMPTY), a bool, integer, float (float32 for FLOAT),
+/// string, array of those, or for STRUCT a map of field name to value with
+/// the struct's type name under "_type", as in the JSON payload.
+
+#include "telemetry.h"
+#include "vss_signal.h"
+
+#include <string>
+
+namespace vdr {
+namespace sinks {
+
+/// @name Append one message to `out`
+/// @{
+void encode_msgpack(const vss_Signal& msg, std::string& out);
+void encode_msgpack(const telemetry_events_Event& msg, std::string& out);
+void encode_msgpack(const telemetry_metrics_Gauge& msg, std::string& out);
+void encode_msgpack(const telemetry_metrics_Counter& msg, std::string& out);
+void encode_msgpack(const telemetry_metrics_Histogram& msg, std::string& out);
+void encode_msgpack(const telemetry_logs_LogEntry& msg, std::string& out);
+void encode_msgpack(const telemetry_diagnostics_ScalarMeasurement& msg, std::string& out);
+void encode_msgpack(const telemetry_diagnostics_VectorMeasurement& msg, std::string& out);
+/// @}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,40 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/payload_format.hpp"
+
+namespace vdr {
+namespace sinks {
+
+std::optional<PayloadFormat> parse_payload_format(std::string_view name) {
+    if (name == "json") return PayloadFormat::Json;
+    if (name == "msgpack") return PayloadFormat::MessagePack;
+    if (name == "protobuf") return PayloadFormat::Protobuf;
+    if (name == "signal_batch") return PayloadFormat::SignalBatch;
+    return std::nullopt;
+}
+
+const char* to_string(PayloadFormat format) {
+    switch (format) {
+        case PayloadFormat::Json: return "json";
+        case PayloadFormat::MessagePack: return "msgpack";
+        case PayloadFormat::Protobuf: return "protobuf";
+        case PayloadFormat::SignalBatch: return "signal_batch";
+    }
+    return "unknown";
+}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,41 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/payload_format.hpp
+/// @brief Selectable encodings of offboarded payloads
+
+#include <optional>
+#include <string_view>
+
+namespace vdr {
+namespace sinks {
+
+/// Encoding of one message payload.
+enum class PayloadFormat {
+    Json,         ///< Self-describing objects (json_encoder.hpp)
+    MessagePack,  ///< Positional arrays (msgpack_encoder.hpp)
+    Protobuf,     ///< offboard.proto messages; events only (protobuf_encoder.hpp)
+    SignalBatch   ///< Dictionary-coded batches; signals only (signal_batch_encoder.hpp)
+};
+
+/// Parse "json" / "msgpack" / "protobuf" / "signal_batch".
+std::optional<PayloadFormat> parse_payload_format(std::string_view name);
+
+const char* to_string(PayloadFormat format);
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,217 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/protobuf_encoder.hpp"
+
+#include "offboard.pb.h"
+
+#include <google/protobuf/arena.h>
+
+#include <type_traits>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+namespace pb = vdr::offboard;
+
+// Arena of the calling thread: the first block is owned here, so
+// encoding only reaches the heap for messages larger than it
+class ThreadArena {
+public:
+    static constexpr size_t kInitialBlock = 16 * 1024;
+
+    ThreadArena() : arena_(options()) {}
+
+    google::protobuf::Arena& get() { return arena_; }
+
+private:
+    google::protobuf::ArenaOptions options() {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block_;
+        options.initial_block_size = sizeof(block_);
+        return options;
+    }
+
+    alignas(8) char block_[kInitialBlock];
+    google::protobuf::Arena arena_;
+};
+
+google::protobuf::Arena& thread_arena() {
+    thread_local ThreadArena arena;
+    return arena.get();
+}
+
+// Encodes one message on the thread arena and resets it afterwards
+template<typename Message, typename Fill>
+void encode_on_arena(std::string& out, Fill&& fill) {
+    google::protobuf::Arena& arena = thread_arena();
+    auto* message = google::protobuf::Arena::CreateMessage<Message>(&arena);
+    fill(*message);
+    message->AppendToString(&out);
+    arena.Reset();
+}
+
+// proto3 does not serialize empty strings, so null and "" are not set
+bool has_text(const char* s) {
+    return s && s[0] != '\0';
+}
+
+void set_string(const char* src, std::string* dst) {
+    if (has_text(src)) {
+        dst->assign(src);
+    }
+}
+
+void fill_header(const vss_types_Header& src, pb::Header& dst) {
+    if (has_text(src.source_id)) dst.set_source_id(src.source_id);
+    dst.set_timestamp_ns(src.timestamp_ns);
+    dst.set_seq_num(src.seq_num);
+    if (has_text(src.correlation_id)) dst.set_correlation_id(src.correlation_id);
+}
+
+// Entries with a null key or value are skipped, as in the JSON payload
+template<typename Repeated>
+void fill_key_values(const dds_sequence_vss_types_KeyValue& src, Repeated& dst) {
+    dst.Reserve(static_cast<int>(src._length));
+    for (uint32_t i = 0; i < src._length; ++i) {
+        const auto& kv = src._buffer[i];
+        if (kv.key && kv.value) {
+            pb::KeyValue* entry = dst.Add();
+            entry->set_key(kv.key);
+            entry->set_value(kv.value);
+        }
+    }
+}
+
+template<typename Seq, typename Repeated>
+void fill_numbers(const Seq& src, Repeated& dst) {
+    dst.Reserve(static_cast<int>(src._length));
+    for (uint32_t i = 0; i < src._length; ++i) {
+        dst.AddAlreadyReserved(src._buffer[i]);
+    }
+}
+
+void fill_struct_value(const vss_types_StructValue& src, pb::StructValue& dst);
+
+// Shared by Value and StructField, which carry the same scalar/array members
+template<typename V>
+void fill_value(const V& src, pb::Value& dst) {
+    switch (src.type) {
+        case vss_types_VALUE_TYPE_BOOL: dst.set_bool_value(src.bool_value); break;
+        case vss_types_VALUE_TYPE_INT8: dst.set_int8_value(src.int8_value); break;
+        case vss_types_VALUE_TYPE_INT16: dst.set_int16_value(src.int16_value); break;
+        case vss_types_VALUE_TYPE_INT32: dst.set_int32_value(src.int32_value); break;
+        case vss_types_VALUE_TYPE_INT64: dst.set_int64_value(src.int64_value); break;
+        case vss_types_VALUE_TYPE_UINT8: dst.set_uint8_value(src.uint8_value); break;
+        case vss_types_VALUE_TYPE_UINT16: dst.set_uint16_value(src.uint16_value); break;
+        case vss_types_VALUE_TYPE_UINT32: dst.set_uint32_value(src.uint32_value); break;
+        case vss_types_VALUE_TYPE_UINT64: dst.set_uint64_value(src.uint64_value); break;
+        case vss_types_VALUE_TYPE_FLOAT: dst.set_float_value(src.float_value); break;
+        case vss_types_VALUE_TYPE_DOUBLE: dst.set_double_value(src.double_value); break;
+        case vss_types_VALUE_TYPE_STRING:
+            set_string(src.string_value, dst.mutable_string_value());
+            break;
+        case vss_types_VALUE_TYPE_BOOL_ARRAY:
+            fill_numbers(src.bool_array, *dst.mutable_bool_array()->mutable_values());
+            break;
+        case vss_types_VALUE_TYPE_INT32_ARRAY:
+            fill_numbers(src.int32_array, *dst.mutable_int32_array()->mutable_values());
+            break;
+        case vss_types_VALUE_TYPE_INT64_ARRAY:
+            fill_numbers(src.int64_array, *dst.mutable_int64_array()->mutable_values());
+            break;
+        case vss_types_VALUE_TYPE_FLOAT_ARRAY:
+            fill_numbers(src.float_array, *dst.mutable_float_array()->mutable_values());
+            break;
+        case vss_types_VALUE_TYPE_DOUBLE_ARRAY:
+            fill_numbers(src.double_array, *dst.mutable_double_array()->mutable_values());
+            break;
+        case vss_types_VALUE_TYPE_STRING_ARRAY: {
+            auto* values = dst.mutable_string_array()->mutable_values();
+            values->Reserve(static_cast<int>(src.string_array._length));
+            for (uint32_t i = 0; i < src.string_array._length; ++i) {
+                set_string(src.string_array._buffer[i], values->Add());
+            }
+            break;
+        }
+        default:
+            if constexpr (std::is_same_v<V, vss_types_Value>) {
+                if (src.type == vss_types_VALUE_TYPE_STRUCT) {
+                    fill_struct_value(src.struct_value, *dst.mutable_struct_value());
+                } else if (src.type == vss_types_VALUE_TYPE_STRUCT_ARRAY) {
+                    auto* values = dst.mutable_struct_array()->mutable_values();
+                    values->Reserve(static_cast<int>(src.struct_array._length));
+                    for (uint32_t i = 0; i < src.struct_array._length; ++i) {
+                        fill_struct_value(src.struct_array._buffer[i], *values->Add());
+                    }
+                }
+            }
+            break;  // EMPTY: no member set
+    }
+}
+
+void fill_struct_value(const vss_types_StructValue& src, pb::StructValue& dst) {
+    if (has_text(src.type_name)) dst.set_type_name(src.type_name);
+    dst.mutable_fields()->Reserve(static_cast<int>(src.fields._length));
+    for (uint32_t i = 0; i < src.fields._length; ++i) {
+        const auto& field = src.fields._buffer[i];
+        pb::StructField* out = dst.add_fields();
+        if (has_text(field.name)) out->set_name(field.name);
+        fill_value(field, *out->mutable_value());
+    }
+}
+
+void fill_signal(const vss_Signal& src, pb::Signal& dst) {
+    if (has_text(src.path)) dst.set_path(src.path);
+    fill_header(src.header, *dst.mutable_header());
+    dst.set_quality(static_cast<pb::Quality>(src.quality));
+    fill_value(src.value, *dst.mutable_value());
+}
+
+}  // namespace
+
+void encode_protobuf(const telemetry_events_Event& msg, std::string& out) {
+    encode_on_arena<pb::Event>(out, [&msg](pb::Event& event) {
+        if (has_text(msg.event_id)) event.set_event_id(msg.event_id);
+        fill_header(msg.header, *event.mutable_header());
+        if (has_text(msg.category)) event.set_category(msg.category);
+        if (has_text(msg.event_type)) event.set_event_type(msg.event_type);
+        event.set_severity(static_cast<pb::Severity>(msg.severity));
+        fill_key_values(msg.attributes, *event.mutable_attributes());
+        event.mutable_context()->Reserve(static_cast<int>(msg.context._length));
+        for (uint32_t i = 0; i < msg.context._length; ++i) {
+            fill_signal(msg.context._buffer[i], *event.add_context());
+        }
+    });
+}
+
+void encode_protobuf(const telemetry_security_Incident& msg, std::string& out) {
+    encode_on_arena<pb::Incident>(out, [&msg](pb::Incident& incident) {
+        if (has_text(msg.incident_id)) incident.set_incident_id(msg.incident_id);
+        fill_header(msg.header, *incident.mutable_header());
+        incident.set_threat_level(static_cast<pb::ThreatLevel>(msg.threat_level));
+        if (has_text(msg.incident_type)) incident.set_incident_type(msg.incident_type);
+        if (has_text(msg.description)) incident.set_description(msg.description);
+        fill_key_values(msg.indicators, *incident.mutable_indicators());
+        if (msg.raw_evidence._length > 0) {
+            incident.set_raw_evidence(msg.raw_evidence._buffer, msg.raw_evidence._length);
+        }
+    });
+}
+
+}  // namespace sinks
+}  // namespace vdr
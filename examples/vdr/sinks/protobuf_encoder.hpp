@@ -0,0 +1,45 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/protobuf_encoder.hpp
+/// @brief Protobuf payloads of events and security incidents
+///
+/// SPECIFICATION.md selects Protobuf for events: they are low-rate but
+/// reliability-critical, and consumers need to keep decoding them as the
+/// schema evolves. The schemas are in examples/proto/offboard.proto.
+/// Unlike the JSON payload, an Event carries its full context signals.
+///
+/// The message tree is built from the DDS struct on a per-thread
+/// google::protobuf::Arena that starts on a preallocated block and is
+/// reset after every message, so a steady stream of events does no heap
+/// allocation for the message tree. The wire bytes are appended to `out`.
+
+#include "telemetry.h"
+
+#include <string>
+
+namespace vdr {
+namespace sinks {
+
+/// @name Append one message to `out`
+/// @{
+void encode_protobuf(const telemetry_events_Event& msg, std::string& out);
+void encode_protobuf(const telemetry_security_Incident& msg, std::string& out);
+/// @}
+
+}  // namespace sinks
+}  // namespace vdr
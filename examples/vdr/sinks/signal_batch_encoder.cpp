@@ -0,0 +1,204 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/signal_batch_encoder.hpp"
+#include "codec/signal_batch_format.hpp"
+
+#include <chrono>
+#include <random>
+#include <type_traits>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+using codec::ByteWriter;
+using codec::ValueType;
+
+static_assert(static_cast<int>(ValueType::String) == vss_types_VALUE_TYPE_STRING &&
+              static_cast<int>(ValueType::StringArray) == vss_types_VALUE_TYPE_STRING_ARRAY &&
+              static_cast<int>(ValueType::StructArray) == vss_types_VALUE_TYPE_STRUCT_ARRAY,
+              "codec::ValueType must be numbered as vss_types_ValueType");
+
+uint64_t random_session_id() {
+    std::random_device rd;
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    uint64_t id = (static_cast<uint64_t>(rd()) << 32) ^ rd() ^ static_cast<uint64_t>(now);
+    return id != 0 ? id : 1;
+}
+
+// Type as written: a StructField cannot carry structs, and unknown types
+// are written as EMPTY
+template<typename V>
+ValueType wire_type(const V& value) {
+    constexpr auto kLast = std::is_same_v<V, vss_types_Value> ? vss_types_VALUE_TYPE_STRUCT_ARRAY
+                                                              : vss_types_VALUE_TYPE_STRING_ARRAY;
+    auto type = static_cast<int>(value.type);
+    return type >= 0 && type <= kLast ? static_cast<ValueType>(type) : ValueType::Empty;
+}
+
+void write_string(ByteWriter& w, const char* text) {
+    w.str(text ? std::string_view(text) : std::string_view());
+}
+
+template<typename Seq, typename Fn>
+void write_array(ByteWriter& w, const Seq& seq, Fn&& write_element) {
+    w.varint(seq._length);
+    for (uint32_t i = 0; i < seq._length; ++i) {
+        write_element(seq._buffer[i]);
+    }
+}
+
+void write_struct_value(ByteWriter& w, const vss_types_StructValue& value);
+
+// Shared by Value and StructField, which carry the same scalar/array members
+template<typename V>
+void write_value(ByteWriter& w, ValueType type, const V& value) {
+    switch (type) {
+        case ValueType::Empty: return;
+        case ValueType::Bool: w.u8(value.bool_value ? 1 : 0); return;
+        case ValueType::Int8: w.svarint(value.int8_value); return;
+        case ValueType::Int16: w.svarint(value.int16_value); return;
+        case ValueType::Int32: w.svarint(value.int32_value); return;
+        case ValueType::Int64: w.svarint(value.int64_value); return;
+        case ValueType::Uint8: w.varint(value.uint8_value); return;
+        case ValueType::Uint16: w.varint(value.uint16_value); return;
+        case ValueType::Uint32: w.varint(value.uint32_value); return;
+        case ValueType::Uint64: w.varint(value.uint64_value); return;
+        case ValueType::Float: w.fixed(value.float_value); return;
+        case ValueType::Double: w.fixed(value.double_value); return;
+        case ValueType::String: write_string(w, value.string_value); return;
+        case ValueType::BoolArray:
+            write_array(w, value.bool_array, [&w](bool v) { w.u8(v ? 1 : 0); });
+            return;
+        case ValueType::Int32Array:
+            write_array(w, value.int32_array, [&w](int32_t v) { w.svarint(v); });
+            return;
+        case ValueType::Int64Array:
+            write_array(w, value.int64_array, [&w](int64_t v) { w.svarint(v); });
+            return;
+        case ValueType::FloatArray:
+            write_array(w, value.float_array, [&w](float v) { w.fixed(v); });
+            return;
+        case ValueType::DoubleArray:
+            write_array(w, value.double_array, [&w](double v) { w.fixed(v); });
+            return;
+        case ValueType::StringArray:
+            write_array(w, value.string_array, [&w](const char* v) { write_string(w, v); });
+            return;
+        case ValueType::Struct:
+        case ValueType::StructArray:
+            break;
+    }
+
+    if constexpr (std::is_same_v<V, vss_types_Value>) {
+        if (type == ValueType::Struct) {
+            write_struct_value(w, value.struct_value);
+        } else {
+            write_array(w, value.struct_array,
+                        [&w](const vss_types_StructValue& v) { write_struct_value(w, v); });
+        }
+    }
+}
+
+void write_struct_value(ByteWriter& w, const vss_types_StructValue& value) {
+    write_string(w, value.type_name);
+    w.varint(value.fields._length);
+    for (uint32_t i = 0; i < value.fields._length; ++i) {
+        const auto& field = value.fields._buffer[i];
+        ValueType type = wire_type(field);
+        write_string(w, field.name);
+        w.u8(static_cast<uint8_t>(type));
+        write_value(w, type, field);
+    }
+}
+
+}  // namespace
+
+SignalBatchEncoder::SignalBatchEncoder(uint64_t session_id)
+    : session_id_(session_id != 0 ? session_id : random_session_id()) {}
+
+uint32_t SignalBatchEncoder::intern(const char* text) {
+    std::string_view key = text ? std::string_view(text) : std::string_view();
+    auto it = ids_.find(key);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    auto id = static_cast<uint32_t>(entries_.size());
+    entries_.emplace_back(key);
+    ids_.emplace(entries_.back(), id);
+    return id;
+}
+
+void SignalBatchEncoder::encode(utils::Span<const vss_Signal> signals, std::string& dictionary,
+                                std::string& batch) {
+    dictionary.clear();
+    batch.clear();
+
+    int64_t base_ns = signals.empty() ? 0 : signals[0].header.timestamp_ns;
+    uint32_t batch_source = signals.empty() ? intern(nullptr)
+                                            : intern(signals[0].header.source_id);
+
+    // The signals are written first, since the header carries the
+    // dictionary size they need
+    body_.clear();
+    ByteWriter b(body_);
+    int64_t previous_ns = base_ns;
+    for (const vss_Signal& signal : signals) {
+        uint32_t path_id = intern(signal.path);
+        uint32_t source_id = intern(signal.header.source_id);
+        ValueType type = wire_type(signal.value);
+
+        uint8_t head = static_cast<uint8_t>(type) |
+                       static_cast<uint8_t>((signal.quality & codec::kQualityMask)
+                                            << codec::kQualityShift);
+        if (source_id != batch_source) {
+            head |= codec::kSourceOverride;
+        }
+        b.varint(path_id);
+        b.u8(head);
+        if (source_id != batch_source) {
+            b.varint(source_id);
+        }
+        // Modulo 2^64, so any two timestamps have a delta
+        b.svarint(static_cast<int64_t>(static_cast<uint64_t>(signal.header.timestamp_ns) -
+                                       static_cast<uint64_t>(previous_ns)));
+        previous_ns = signal.header.timestamp_ns;
+        write_value(b, type, signal.value);
+    }
+
+    ByteWriter w(batch);
+    w.frame_header(codec::FrameKind::Batch, session_id_);
+    w.varint(entries_.size());
+    w.svarint(base_ns);
+    w.varint(batch_source);
+    w.varint(signals.size());
+    batch.append(body_);
+
+    if (sent_ < entries_.size()) {
+        ByteWriter d(dictionary);
+        d.frame_header(codec::FrameKind::Dictionary, session_id_);
+        d.varint(sent_);
+        d.varint(entries_.size() - sent_);
+        for (size_t id = sent_; id < entries_.size(); ++id) {
+            d.str(entries_[id]);
+        }
+        sent_ = entries_.size();
+    }
+}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,75 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/signal_batch_encoder.hpp
+/// @brief EncodedSignalBatch frames written from vss_Signal batches
+///
+/// The dictionary-coded format SPECIFICATION.md sketches for high-rate
+/// signals (src/codec/signal_batch_format.hpp): VSS paths and source ids
+/// become varint ids, timestamps are deltas from the batch base and values
+/// are packed by type, so a batch of ten scalar signals takes about a
+/// hundred bytes. Offboard consumers decode with vdr::codec's
+/// SignalBatchDecoder, which has no DDS dependency.
+
+#include "common/span.hpp"
+#include "vss_signal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vdr {
+namespace sinks {
+
+/// Encoder of one session: owns its dictionary and session id.
+///
+/// Not thread-safe; callers serialize encode() (MqttSink holds a mutex).
+class SignalBatchEncoder {
+public:
+    /// A session id of 0 picks a random one.
+    explicit SignalBatchEncoder(uint64_t session_id = 0);
+
+    /// Encode `signals` as one batch frame, replacing the contents of
+    /// `batch`. Dictionary entries not sent yet are written to
+    /// `dictionary` as a dictionary frame, which must reach the decoder
+    /// first; `dictionary` is left empty when there are none.
+    void encode(utils::Span<const vss_Signal> signals, std::string& dictionary,
+                std::string& batch);
+
+    /// Make the next encode() write a full snapshot of the dictionary,
+    /// e.g. after a reconnect or when a dictionary frame was lost.
+    void resend_dictionary() noexcept { sent_ = 0; }
+
+    uint64_t session_id() const noexcept { return session_id_; }
+    size_t dictionary_size() const noexcept { return entries_.size(); }
+
+private:
+    // Id of `text` (null reads as ""), assigned on first use
+    uint32_t intern(const char* text);
+
+    uint64_t session_id_;
+    std::deque<std::string> entries_;  // deque: ids_ keys point into the strings
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    size_t sent_ = 0;  // entries written to a dictionary frame
+    std::string body_;  // signals of the batch being encoded; reused
+};
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,98 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/sinks/topic_batcher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace vdr {
+namespace sinks {
+
+namespace {
+
+void put_u32(char* out, uint32_t value) {
+    out[0] = static_cast<char>(value >> 24);
+    out[1] = static_cast<char>(value >> 16);
+    out[2] = static_cast<char>(value >> 8);
+    out[3] = static_cast<char>(value);
+}
+
+}  // namespace
+
+TopicBatcher::TopicBatcher(BatchConfig config)
+    : config_(std::move(config)),
+      interval_ns_(std::chrono::nanoseconds(config_.flush_interval).count()),
+      critical_interval_ns_(std::chrono::nanoseconds(config_.critical_flush_interval).count()) {}
+
+TopicBatcher::Lane& TopicBatcher::lane_for(const char* topic) {
+    // Topics are the encoders' literals, so the pointer nearly always
+    // matches; strcmp only covers equal literals folded differently
+    for (Lane& lane : lanes_) {
+        if (lane.topic == topic) {
+            return lane;
+        }
+    }
+    for (Lane& lane : lanes_) {
+        if (std::strcmp(lane.topic, topic) == 0) {
+            return lane;
+        }
+    }
+
+    Lane lane;
+    lane.topic = topic;
+    lane.critical = std::find(config_.critical_topics.begin(), config_.critical_topics.end(),
+                              topic) != config_.critical_topics.end();
+    lane.frame.reserve(std::min<size_t>(config_.max_bytes, 16384));
+    lane.frame.assign(kBatchHeaderSize, '\0');
+    lane.frame[0] = 'V';
+    lane.frame[1] = 'B';
+    lane.frame[2] = static_cast<char>(kBatchVersion);
+    lanes_.push_back(std::move(lane));
+    return lanes_.back();
+}
+
+void TopicBatcher::append(Lane& lane, std::string_view payload) {
+    char length[kBatchLengthSize];
+    put_u32(length, static_cast<uint32_t>(payload.size()));
+    lane.frame.append(length, kBatchLengthSize);
+    lane.frame.append(payload.data(), payload.size());
+    ++lane.count;
+}
+
+void TopicBatcher::finish(Lane& lane) {
+    put_u32(&lane.frame[4], static_cast<uint32_t>(lane.count));
+}
+
+int64_t TopicBatcher::next_deadline() const noexcept {
+    int64_t next = INT64_MAX;
+    for (const Lane& lane : lanes_) {
+        if (lane.count > 0 && lane.deadline_ns < next) {
+            next = lane.deadline_ns;
+        }
+    }
+    return next;
+}
+
+size_t TopicBatcher::pending() const noexcept {
+    size_t total = 0;
+    for (const Lane& lane : lanes_) {
+        total += lane.count;
+    }
+    return total;
+}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -0,0 +1,182 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file sinks/topic_batcher.hpp
+/// @brief Groups encoded messages per MQTT topic into framed batches
+///
+/// Publishing every DDS sample as its own MQTT message costs a broker
+/// round trip, a topic string and a fixed header per sample. TopicBatcher
+/// collects the encoded payloads of one topic and hands them out as a
+/// single framed payload once the batch reaches `max_messages` or
+/// `max_bytes`, or its oldest message has waited for the topic's flush
+/// interval. Critical topics get a shorter interval.
+///
+/// Batch layout (integers big-endian):
+///
+///     offset 0  'V' 'B'       magic
+///            2  u8            version (kBatchVersion)
+///            3  u8            flags, 0 (see batch_compressor.hpp)
+///            4  u32           message count
+///            8  per message:  u32 length, then `length` payload bytes
+///
+/// for_each_batch_message() walks a received batch; a compressed one
+/// (flags set by BatchCompressor) goes through decompress_batch() first.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vdr {
+namespace sinks {
+
+/// Limits of one topic batch, as configured under `offboard:`.
+struct BatchConfig {
+    size_t max_messages = 10;    ///< offboard.batch_size; 1 publishes unbatched
+    size_t max_bytes = 65536;    ///< Framed size, including headers
+    std::chrono::milliseconds flush_interval{1000};         ///< offboard.flush_interval_ms
+    std::chrono::milliseconds critical_flush_interval{50};  ///< For critical_topics
+    std::vector<std::string> critical_topics = {"events"};  ///< Topics below topic_prefix
+};
+
+constexpr uint8_t kBatchVersion = 1;
+constexpr size_t kBatchHeaderSize = 8;
+constexpr size_t kBatchLengthSize = 4;
+
+/// Per-topic batching stage.
+///
+/// Not thread-safe: one thread adds messages and polls deadlines (the
+/// MqttSink publish thread). Emit callbacks receive
+/// `(const char* topic, const char* data, size_t size, size_t messages)`;
+/// `data` is only valid during the call.
+class TopicBatcher {
+public:
+    explicit TopicBatcher(BatchConfig config);
+
+    /// False when max_messages <= 1; callers then publish payloads as-is.
+    bool enabled() const noexcept { return config_.max_messages > 1; }
+
+    const BatchConfig& config() const noexcept { return config_; }
+
+    /// Append one payload to its topic's batch at time `now_ns` (steady
+    /// clock). Emits the batch first if the payload would push it over
+    /// max_bytes, and after appending if a limit is reached. A payload
+    /// larger than max_bytes on its own goes out as a batch of one.
+    template<typename Emit>
+    void add(const char* topic, std::string_view payload, int64_t now_ns, Emit&& emit) {
+        Lane& lane = lane_for(topic);
+        size_t framed = kBatchLengthSize + payload.size();
+        if (lane.count > 0 && lane.frame.size() + framed > config_.max_bytes) {
+            emit_lane(lane, emit);
+        }
+        if (lane.count == 0) {
+            lane.deadline_ns = now_ns + (lane.critical ? critical_interval_ns_ : interval_ns_);
+        }
+        append(lane, payload);
+        if (lane.count >= config_.max_messages || lane.frame.size() >= config_.max_bytes) {
+            emit_lane(lane, emit);
+        }
+    }
+
+    /// Emit every batch whose deadline is at or before `now_ns`.
+    template<typename Emit>
+    void flush_due(int64_t now_ns, Emit&& emit) {
+        for (Lane& lane : lanes_) {
+            if (lane.count > 0 && lane.deadline_ns <= now_ns) {
+                emit_lane(lane, emit);
+            }
+        }
+    }
+
+    /// Emit every non-empty batch.
+    template<typename Emit>
+    void flush_all(Emit&& emit) {
+        for (Lane& lane : lanes_) {
+            if (lane.count > 0) {
+                emit_lane(lane, emit);
+            }
+        }
+    }
+
+    /// Earliest pending deadline, INT64_MAX if nothing is pending.
+    int64_t next_deadline() const noexcept;
+
+    /// Messages waiting in all batches.
+    size_t pending() const noexcept;
+
+private:
+    struct Lane {
+        const char* topic;        // as passed to add(), compared by pointer first
+        std::string frame;        // header + messages; capacity is kept
+        size_t count = 0;
+        int64_t deadline_ns = 0;
+        bool critical = false;
+    };
+
+    Lane& lane_for(const char* topic);
+    void append(Lane& lane, std::string_view payload);
+    void finish(Lane& lane);
+
+    template<typename Emit>
+    void emit_lane(Lane& lane, Emit& emit) {
+        finish(lane);
+        emit(lane.topic, lane.frame.data(), lane.frame.size(), lane.count);
+        lane.frame.resize(kBatchHeaderSize);
+        lane.count = 0;
+    }
+
+    BatchConfig config_;
+    int64_t interval_ns_;
+    int64_t critical_interval_ns_;
+    std::vector<Lane> lanes_;  // one per topic seen; a handful at most
+};
+
+/// Call `fn(std::string_view message)` for every message of a framed
+/// batch, in order. Returns false, possibly after some calls, if the data
+/// is not a well-formed batch.
+template<typename Fn>
+bool for_each_batch_message(const uint8_t* data, size_t size, Fn&& fn) {
+    auto read_u32 = [](const uint8_t* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+               (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    };
+    if (size < kBatchHeaderSize || data[0] != 'V' || data[1] != 'B' ||
+        data[2] != kBatchVersion || data[3] != 0) {
+        return false;
+    }
+    uint32_t count = read_u32(data + 4);
+    size_t pos = kBatchHeaderSize;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (size - pos < kBatchLengthSize) {
+            return false;
+        }
+        uint32_t length = read_u32(data + pos);
+        pos += kBatchLengthSize;
+        if (size - pos < length) {
+            return false;
+        }
+        fn(std::string_view(reinterpret_cast<const char*>(data + pos), length));
+        pos += length;
+    }
+    return pos == size;
+}
+
+}  // namespace sinks
+}  // namespace vdr
@@ -14,89 +14,31 @@
 // limitations under the License.
 
 #include "vdr/subscriber.hpp"
-#include "common/qos_profiles.hpp"
 
 #include <glog/logging.h>
 
-namespace vdr {
-
-SubscriptionManager::SubscriptionManager(dds::Participant& participant,
-                                          const SubscriptionConfig& config)
-    : participant_(participant), config_(config) {
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
-    // Create topics and readers based on configuration
-
-    if (config_.vss_signals) {
-        auto qos = dds::qos_profiles::reliable_standard(100);
-        topic_vss_signal_ = std::make_unique<dds::Topic>(
-            participant_, &vss_Signal_desc,
-            "rt/vss/signals", qos.get());
-        reader_vss_signal_ = std::make_unique<dds::Reader>(
-            participant_, *topic_vss_signal_, qos.get());
-    }
-
-    if (config_.events) {
-        auto qos = dds::qos_profiles::reliable_critical();
-        topic_event_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_events_Event_desc,
-            "rt/events/vehicle", qos.get());
-        reader_event_ = std::make_unique<dds::Reader>(
-            participant_, *topic_event_, qos.get());
-    }
-
-    if (config_.gauges) {
-        auto qos = dds::qos_profiles::best_effort(1);
-        topic_gauge_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_metrics_Gauge_desc,
-            "rt/telemetry/gauges", qos.get());
-        reader_gauge_ = std::make_unique<dds::Reader>(
-            participant_, *topic_gauge_, qos.get());
-    }
+namespace vdr {
 
-    if (config_.counters) {
-        auto qos = dds::qos_profiles::best_effort(1);
-        topic_counter_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_metrics_Counter_desc,
-            "rt/telemetry/counters", qos.get());
-        reader_counter_ = std::make_unique<dds::Reader>(
-            participant_, *topic_counter_, qos.get());
-    }
+namespace {
 
-    if (config_.histograms) {
-        auto qos = dds::qos_profiles::best_effort(1);
-        topic_histogram_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_metrics_Histogram_desc,
-            "rt/telemetry/histograms", qos.get());
-        reader_histogram_ = std::make_unique<dds::Reader>(
-            participant_, *topic_histogram_, qos.get());
-    }
+// Samples per take when draining from a listener callback
+constexpr size_t kListenerBatch = 64;
 
-    if (config_.logs) {
-        auto qos = dds::qos_profiles::best_effort(100);
-        topic_log_entry_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_logs_LogEntry_desc,
-            "rt/logs/entries", qos.get());
-        reader_log_entry_ = std::make_unique<dds::Reader>(
-            participant_, *topic_log_entry_, qos.get());
-    }
+}  // namespace
 
-    if (config_.scalar_measurements) {
-        auto qos = dds::qos_profiles::reliable_standard(10);
-        topic_scalar_measurement_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_diagnostics_ScalarMeasurement_desc,
-            "rt/diagnostics/scalar", qos.get());
-        reader_scalar_measurement_ = std::make_unique<dds::Reader>(
-            participant_, *topic_scalar_measurement_, qos.get());
-    }
+SubscriptionManager::SubscriptionManager(dds::Participant& participant,
+                                          const SubscriptionConfig& config)
+    : participant_(participant), config_(config) {
 
-    if (config_.vector_measurements) {
-        auto qos = dds::qos_profiles::reliable_standard(10);
-        topic_vector_measurement_ = std::make_unique<dds::Topic>(
-            participant_, &telemetry_diagnostics_VectorMeasurement_desc,
-            "rt/diagnostics/vector", qos.get());
-        reader_vector_measurement_ = std::make_unique<dds::Reader>(
-            participant_, *topic_vector_measurement_, qos.get());
-    }
+    // Bulk topics are read as raw CDR; typed topics come from subscribe()
+    add_serialized<telemetry_opaque_FreezeFrame>(config_.freeze_frames);
+    add_serialized<telemetry_avtp_CanTrace>(config_.can_traces);
 
     LOG(INFO) << "SubscriptionManager initialized";
 }
@@ -111,8 +53,26 @@ void SubscriptionManager::start() {
         return;
     }
 
+    // Attach a read condition or listener for every reader that has a consumer
+    waitset_ = std::make_unique<dds::WaitSet>(participant_);
+    for (const auto& active : readers_) {
+        attach(*active.reader, *active.config, active.drain);
+    }
+
+    // Serialized readers without a consumer stay detached: their read
+    // condition would otherwise remain triggered and spin the receive thread
+    if (cb_serialized_) {
+        for (const auto& bulk : serialized_) {
+            attach(*bulk.reader, bulk.config, [this, &bulk](size_t max_samples) {
+                return process_serialized(*bulk.reader, bulk.name, bulk.type_name,
+                                          max_samples);
+            });
+        }
+    }
+
     poll_thread_ = std::thread(&SubscriptionManager::poll_loop, this);
-    LOG(INFO) << "SubscriptionManager started";
+    LOG(INFO) << "SubscriptionManager started with " << conditions_.size()
+              << " waitset and " << listeners_.size() << " listener readers";
 }
 
 void SubscriptionManager::stop() {
@@ -120,96 +80,240 @@ void SubscriptionManager::stop() {
         return;
     }
 
+    if (waitset_) {
+        waitset_->wake();
+    }
     if (poll_thread_.joinable()) {
         poll_thread_.join();
     }
+
+    // Waits for callbacks still running on DDS threads
+    for (dds::Reader* reader : listener_readers_) {
+        try {
+            reader->set_listener(nullptr);
+        } catch (const dds::Error& e) {
+            LOG(ERROR) << "Failed to remove listener: " << e.what();
+        }
+    }
+    listener_readers_.clear();
+    listeners_.clear();
+
+    scheduler_.clear();
+    conditions_.clear();
+    waitset_.reset();
     LOG(INFO) << "SubscriptionManager stopped";
 }
 
-void SubscriptionManager::on_vss_signal(VssSignalCallback callback) {
-    cb_vss_signal_ = std::move(callback);
+void SubscriptionManager::on_serialized(SerializedCallback callback) {
+    cb_serialized_ = std::move(callback);
 }
 
-void SubscriptionManager::on_event(EventCallback callback) {
-    cb_event_ = std::move(callback);
-}
+void SubscriptionManager::ingest_can(CanIngest& ingest) {
+    using Traits = TopicTraits<telemetry_avtp_AcfCanBatch>;
+    const TopicConfig& config = config_.can_batches;
 
-void SubscriptionManager::on_gauge(GaugeCallback callback) {
-    cb_gauge_ = std::move(callback);
-}
+    if (!config.enabled) {
+        return;
+    }
+    if (can_reader_) {
+        throw dds::Error(DDS_RETCODE_PRECONDITION_NOT_MET, "ingest_can called twice");
+    }
+    if (auto error = validate(config.qos)) {
+        throw std::invalid_argument(std::string(Traits::name) + ": " + *error);
+    }
 
-void SubscriptionManager::on_counter(CounterCallback callback) {
-    cb_counter_ = std::move(callback);
-}
+    auto qos = make_qos(config.qos);
+    can_topic_ = std::make_unique<dds::Topic>(participant_, Traits::descriptor(), Traits::name,
+                                              qos.get());
+    can_reader_ = std::make_unique<dds::Reader>(participant_, *can_topic_, qos.get());
 
-void SubscriptionManager::on_histogram(HistogramCallback callback) {
-    cb_histogram_ = std::move(callback);
+    dds::Reader* reader = can_reader_.get();
+    readers_.push_back({reader, &config, [&ingest, reader](size_t max_samples) {
+        return drain_can_batches(ingest, *reader, max_samples);
+    }});
 }
 
-void SubscriptionManager::on_log_entry(LogEntryCallback callback) {
-    cb_log_entry_ = std::move(callback);
+std::vector<dds::Reader*> SubscriptionManager::setup_signal_topic(dds::Topic& topic,
+                                                                  const TopicConfig& config) {
+    signal_topic_ = &topic;
+
+    auto rates = std::make_shared<const SignalRates>(config_.signal_paths,
+                                                     config_.signal_rules);
+    if (rates->trivial()) {
+        return {};
+    }
+
+    topic.set_filter<vss_Signal>([rates](const vss_Signal& msg) {
+        return msg.path != nullptr && rates->group_for(msg.path) == 0;
+    });
+    LOG(INFO) << "Filtering rt/vss/signals to " << config_.signal_paths.size()
+              << " path patterns, " << rates->group_count() - 1
+              << " downsampled reader groups";
+
+    std::vector<dds::Reader*> readers;
+    for (size_t group = 1; group < rates->group_count(); ++group) {
+        add_signal_rate_group(rates, group, config);
+        readers.push_back(signal_groups_.back().reader.get());
+    }
+    return readers;
 }
 
-void SubscriptionManager::on_scalar_measurement(ScalarMeasurementCallback callback) {
-    cb_scalar_measurement_ = std::move(callback);
+void SubscriptionManager::add_signal_rate_group(std::shared_ptr<const SignalRates> rates,
+                                                size_t group, const TopicConfig& config) {
+    double max_hz = rates->max_hz(group);
+    auto min_separation = static_cast<dds_duration_t>(1e9 / max_hz);
+
+    // Downsampling is done once, by the topic filter on source timestamps:
+    // some Cyclone builds accept TIME_BASED_FILTER without enforcing it,
+    // and a second filter at the same separation would compound with this
+    // one on clock jitter. The reader keeps the configured history, since
+    // vss_Signal is not assumed to be keyed by path; the latency budget
+    // only lets DDS batch deliveries within one period.
+    auto limiter = std::make_shared<RateLimiter>(min_separation);
+    auto qos = make_qos(config.qos);
+    auto reader_qos = make_qos(config.qos);
+    reader_qos.latency_budget(min_separation);
+
+    SignalRateGroup rate_group;
+    rate_group.max_hz = max_hz;
+    rate_group.topic = std::make_unique<dds::Topic>(
+        participant_, &vss_Signal_desc, "rt/vss/signals", qos.get());
+
+    int id = static_cast<int>(group);
+    rate_group.topic->set_filter<vss_Signal>([rates, limiter, id](const vss_Signal& msg) {
+        return msg.path != nullptr && rates->group_for(msg.path) == id &&
+               limiter->admit(msg.path, msg.header.timestamp_ns);
+    });
+    rate_group.reader = std::make_unique<dds::Reader>(
+        participant_, *rate_group.topic, reader_qos.get());
+
+    signal_groups_.push_back(std::move(rate_group));
 }
 
-void SubscriptionManager::on_vector_measurement(VectorMeasurementCallback callback) {
-    cb_vector_measurement_ = std::move(callback);
+dds::FilterStats SubscriptionManager::signal_filter_stats() const {
+    if (!signal_topic_) {
+        return {};
+    }
+
+    // Every topic entity's filter sees every sample; count each sample once
+    dds::FilterStats stats = signal_topic_->filter_stats();
+    uint64_t seen = stats.accepted + stats.rejected;
+    for (const auto& group : signal_groups_) {
+        stats.accepted += group.topic->filter_stats().accepted;
+    }
+    stats.rejected = seen - stats.accepted;
+    return stats;
 }
 
 void SubscriptionManager::poll_loop() {
     LOG(INFO) << "Poll loop started";
 
+    // One slot per topic plus one for the wake-up guard
+    std::vector<dds_attach_t> triggered(scheduler_.size() + 1);
+
     while (running_) {
-        // Poll each reader
-        if (reader_vss_signal_ && cb_vss_signal_) {
-            process_reader<vss_Signal>(*reader_vss_signal_, cb_vss_signal_);
+        size_t count = 0;
+        try {
+            // Sleep until data arrives; stop() wakes us explicitly
+            count = waitset_->wait(triggered.data(), triggered.size(), DDS_INFINITY);
+        } catch (const dds::Error& e) {
+            LOG(ERROR) << "Error waiting for DDS data: " << e.what();
+            continue;
         }
 
-        if (reader_event_ && cb_event_) {
-            process_reader<telemetry_events_Event>(*reader_event_, cb_event_);
+        if (running_ && count > 0) {
+            scheduler_.run(triggered.data(), count);
         }
+    }
 
-        if (reader_gauge_ && cb_gauge_) {
-            process_reader<telemetry_metrics_Gauge>(*reader_gauge_, cb_gauge_);
-        }
+    LOG(INFO) << "Poll loop exited";
+}
 
-        if (reader_counter_ && cb_counter_) {
-            process_reader<telemetry_metrics_Counter>(*reader_counter_, cb_counter_);
-        }
+void SubscriptionManager::log_take_error(const char* topic_name, const dds::Error& error) {
+    LOG(ERROR) << "Error reading from " << topic_name << ": " << error.what();
+}
 
-        if (reader_histogram_ && cb_histogram_) {
-            process_reader<telemetry_metrics_Histogram>(*reader_histogram_, cb_histogram_);
-        }
+void SubscriptionManager::attach(dds::Reader& reader, const TopicConfig& topic,
+                                 DrainScheduler::DrainFn drain) {
+    if (topic.dispatch == Dispatch::Listener) {
+        // Take until a take comes back empty: DATA_AVAILABLE only fires again
+        // on new data. The lock keeps the initial drain below and the first
+        // callbacks off the reader's loan at the same time.
+        auto drain_all = [drain, busy = std::make_shared<std::mutex>()] {
+            std::lock_guard<std::mutex> lock(*busy);
+            while (drain(kListenerBatch) > 0) {
+            }
+        };
+        auto listener = std::make_unique<dds::Listener>(
+            [drain_all](dds_entity_t) { drain_all(); });
+        reader.set_listener(listener->get());
+        listener_readers_.push_back(&reader);
+        listeners_.push_back(std::move(listener));
+
+        // Samples already cached (e.g. transient-local history received
+        // during setup) raised no DATA_AVAILABLE
+        drain_all();
+        return;
+    }
 
-        if (reader_log_entry_ && cb_log_entry_) {
-            process_reader<telemetry_logs_LogEntry>(*reader_log_entry_, cb_log_entry_);
-        }
+    auto condition = std::make_unique<dds::ReadCondition>(reader);
+    const dds::ReadCondition* cond = condition.get();
 
-        if (reader_scalar_measurement_ && cb_scalar_measurement_) {
-            process_reader<telemetry_diagnostics_ScalarMeasurement>(
-                *reader_scalar_measurement_, cb_scalar_measurement_);
-        }
+    dds_attach_t token = scheduler_.add(topic.priority, topic.drain_budget, std::move(drain),
+                                        [cond] { return cond->triggered(); });
 
-        if (reader_vector_measurement_ && cb_vector_measurement_) {
-            process_reader<telemetry_diagnostics_VectorMeasurement>(
-                *reader_vector_measurement_, cb_vector_measurement_);
-        }
+    waitset_->attach(*condition, token);
+    conditions_.push_back(std::move(condition));
+}
+
+template<typename T>
+void SubscriptionManager::add_serialized(const TopicConfig& config) {
+    using Traits = TopicTraits<T>;
 
-        // Small sleep to avoid busy-waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (!config.enabled) {
+        return;
+    }
+    if (auto error = validate(config.qos)) {
+        throw std::invalid_argument(std::string(Traits::name) + ": " + *error);
     }
 
-    LOG(INFO) << "Poll loop exited";
+    auto qos = make_qos(config.qos);
+    SerializedTopic bulk{Traits::name, Traits::descriptor()->m_typename, config, nullptr, nullptr};
+    bulk.topic = std::make_unique<dds::Topic>(participant_, Traits::descriptor(), Traits::name,
+                                              qos.get());
+    bulk.reader = std::make_unique<dds::Reader>(participant_, *bulk.topic, qos.get());
+    serialized_.push_back(std::move(bulk));
+}
+
+size_t SubscriptionManager::process_serialized(dds::Reader& reader, const char* topic_name,
+                                               const char* type_name, size_t max_samples) {
+    try {
+        size_t taken = 0;
+        reader.take_serialized([&](const dds::SerializedSample& sample) {
+            SerializedMessage msg{topic_name, type_name, sample.data, sample.size,
+                                  sample.info.source_timestamp};
+            cb_serialized_(msg);
+        }, max_samples, &taken);
+        return taken;
+    } catch (const dds::Error& e) {
+        LOG(ERROR) << "Error reading serialized samples from " << topic_name
+                   << ": " << e.what();
+        return 0;
+    }
 }
 
-template<typename T, typename Callback>
-void SubscriptionManager::process_reader(dds::Reader& reader, const Callback& callback) {
+size_t SubscriptionManager::drain_can_batches(CanIngest& ingest, dds::Reader& reader,
+                                              size_t max_samples) {
     try {
-        reader.take_each<T>(callback, 100);
+        // Frames land in the ring; the drain budget counts batches
+        size_t taken = 0;
+        reader.take_serialized([&ingest](const dds::SerializedSample& sample) {
+            ingest.ingest(sample.data, sample.size);
+        }, max_samples, &taken);
+        return taken;
     } catch (const dds::Error& e) {
-        LOG(ERROR) << "Error reading from DDS: " << e.what();
+        log_take_error("rt/avtp/can/batches", e);
+        return 0;
     }
 }
 
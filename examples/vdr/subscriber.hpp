@@ -21,49 +21,87 @@
 /// Manages DDS subscriptions based on configuration.
 
 #include "common/dds_wrapper.hpp"
+#include "vdr/can_ingest.hpp"
+#include "vdr/drain_scheduler.hpp"
+#include "vdr/output_sink.hpp"
+#include "vdr/signal_rates.hpp"
+#include "vdr/topic_config.hpp"
+#include "vdr/topic_registry.hpp"
 #include "telemetry.h"
 #include "vss_signal.h"
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <atomic>
 
 namespace vdr {
 
 /*
- * Callback types for received data.
+ * Callback for bulk topics forwarded as serialized CDR.
  */
-using VssSignalCallback = std::function<void(const vss_Signal&)>;
-using EventCallback = std::function<void(const telemetry_events_Event&)>;
-using GaugeCallback = std::function<void(const telemetry_metrics_Gauge&)>;
-using CounterCallback = std::function<void(const telemetry_metrics_Counter&)>;
-using HistogramCallback = std::function<void(const telemetry_metrics_Histogram&)>;
-using LogEntryCallback = std::function<void(const telemetry_logs_LogEntry&)>;
-using ScalarMeasurementCallback = std::function<void(const telemetry_diagnostics_ScalarMeasurement&)>;
-using VectorMeasurementCallback = std::function<void(const telemetry_diagnostics_VectorMeasurement&)>;
+using SerializedCallback = std::function<void(const SerializedMessage&)>;
 
 /*
  * Subscription configuration.
+ *
+ * Defaults mirror config/vdr_config.yaml.
  */
 struct SubscriptionConfig {
-    bool vss_signals = true;
-    bool events = true;
-    bool gauges = true;
-    bool counters = true;
-    bool histograms = true;
-    bool logs = true;
-    bool scalar_measurements = true;
-    bool vector_measurements = true;
+    TopicConfig vss_signals{true, Priority::High, 0, Dispatch::Waitset,
+                            {QosProfile::ReliableStandard, 100, DDS_LENGTH_UNLIMITED, 4096}};
+
+    // VSS paths to receive on rt/vss/signals (see utils::PathFilter for
+    // the pattern syntax). Empty receives every path.
+    std::vector<std::string> signal_paths;
+
+    // Per-signal offboard rates; each distinct rate gets its own reader,
+    // downsampled inside DDS (see SignalRates)
+    std::vector<SignalRule> signal_rules;
+
+    TopicConfig events{true, Priority::Critical, 0, Dispatch::Listener,
+                       {QosProfile::ReliableCritical, 0, 10000}};
+    TopicConfig gauges{true, Priority::Low, 0, Dispatch::Waitset,
+                       {QosProfile::BestEffort, 1}};
+    TopicConfig counters{true, Priority::Low, 0, Dispatch::Waitset,
+                         {QosProfile::BestEffort, 1}};
+    TopicConfig histograms{true, Priority::Low, 0, Dispatch::Waitset,
+                           {QosProfile::BestEffort, 1}};
+    TopicConfig logs{true, Priority::Low, 0, Dispatch::Waitset,
+                     {QosProfile::BestEffort, 100}};
+    TopicConfig scalar_measurements{true, Priority::Medium, 0, Dispatch::Waitset,
+                                    {QosProfile::ReliableStandard, 10}};
+    TopicConfig vector_measurements{true, Priority::Medium, 0, Dispatch::Waitset,
+                                    {QosProfile::ReliableStandard, 10}};
+
+    // AVTP CAN batches, decoded into a frame ring (see ingest_can)
+    TopicConfig can_batches{false, Priority::High, 0, Dispatch::Waitset,
+                            {QosProfile::ReliableStandard, 100}};
+
+    // Bulk topics, forwarded as serialized CDR (see on_serialized)
+    TopicConfig freeze_frames{false, Priority::Low, 0, Dispatch::Waitset,
+                              {QosProfile::ReliableStandard, 10}};
+    TopicConfig can_traces{false, Priority::Low, 0, Dispatch::Waitset,
+                           {QosProfile::ReliableStandard, 10}};
 };
 
 /*
  * SubscriptionManager - manages all DDS subscriptions for VDR.
  *
- * Creates readers based on configuration and dispatches callbacks
- * when data arrives.
+ * Topics are added with subscribe(), one TopicBinding per IDL type (see
+ * topic_registry.hpp); each binding's take loop is compiled with its
+ * handler inlined. A single waitset covers every waitset-dispatched
+ * reader, so the receive thread sleeps until data arrives and then drains
+ * only the readers that triggered, in priority order (see DrainScheduler).
+ * Listener-dispatched topics invoke their handler from DDS threads
+ * instead, so handlers must be thread-safe when both modes are in use.
+ *
+ * subscribe(), ingest_can() and on_serialized() must be called before start().
  */
 class SubscriptionManager {
 public:
@@ -77,58 +115,223 @@ public:
     // Stop receiving data
     void stop();
 
-    // Register callbacks
-    void on_vss_signal(VssSignalCallback callback);
-    void on_event(EventCallback callback);
-    void on_gauge(GaugeCallback callback);
-    void on_counter(CounterCallback callback);
-    void on_histogram(HistogramCallback callback);
-    void on_log_entry(LogEntryCallback callback);
-    void on_scalar_measurement(ScalarMeasurementCallback callback);
-    void on_vector_measurement(VectorMeasurementCallback callback);
+    // Create a reader for each enabled binding, e.g.
+    //   subscribe(bind<vss_Signal>(config.vss_signals, handler), ...)
+    // with bind() or bind_batch() bindings (see topic_registry.hpp).
+    // Throws std::invalid_argument if a binding has invalid QoS settings
+    // (see validate()). rt/vss/signals additionally applies the
+    // signal_paths and signal_rules of the SubscriptionConfig, so it may
+    // be bound only once; a second binding throws std::invalid_argument.
+    template<typename... Bindings>
+    void subscribe(Bindings&&... bindings) {
+        (add(std::forward<Bindings>(bindings)), ...);
+    }
+
+    // Receives the bulk topics (freeze frames, CAN traces) without
+    // deserializing them
+    void on_serialized(SerializedCallback callback);
+
+    // Decode rt/avtp/can/batches into `ingest`'s frame ring on the receive
+    // thread, with no per-frame callback; `ingest` must outlive the manager.
+    // Does nothing if can_batches is disabled.
+    void ingest_can(CanIngest& ingest);
+
+    // rt/vss/signals samples delivered/dropped by the signal_paths filter
+    // and signal_rules downsampling, over all signal reader groups
+    dds::FilterStats signal_filter_stats() const;
 
 private:
+    // Owns one binding and the topic and reader it drains
+    struct Subscription {
+        virtual ~Subscription() = default;
+
+        std::unique_ptr<dds::Topic> topic;
+        std::unique_ptr<dds::Reader> reader;
+    };
+
+    template<typename Binding>
+    struct BoundSubscription : Subscription {
+        explicit BoundSubscription(Binding b) : binding(std::move(b)) {}
+
+        Binding binding;
+    };
+
+    // A reader attached to the waitset or a listener on every start()
+    struct ActiveReader {
+        dds::Reader* reader;
+        const TopicConfig* config;
+        DrainScheduler::DrainFn drain;
+    };
+
+    // Bulk topic forwarded as serialized CDR
+    struct SerializedTopic {
+        const char* name;
+        const char* type_name;
+        TopicConfig config;
+        std::unique_ptr<dds::Topic> topic;
+        std::unique_ptr<dds::Reader> reader;
+    };
+
     void poll_loop();
 
-    template<typename T, typename Callback>
-    void process_reader(dds::Reader& reader, const Callback& callback);
+    template<typename Binding>
+    void add(Binding binding);
+
+    template<typename Binding>
+    static size_t drain_reader(Binding& binding, dds::Reader& reader, size_t max_samples,
+                               const char* topic_name);
+
+    static void log_take_error(const char* topic_name, const dds::Error& error);
+
+    void attach(dds::Reader& reader, const TopicConfig& topic,
+                DrainScheduler::DrainFn drain);
+
+    // Installs the signal_paths filter on `topic` and creates one reader
+    // group per signal_rules rate; returns the group readers
+    std::vector<dds::Reader*> setup_signal_topic(dds::Topic& topic, const TopicConfig& config);
+
+    void add_signal_rate_group(std::shared_ptr<const SignalRates> rates, size_t group,
+                               const TopicConfig& config);
+
+    template<typename T>
+    void add_serialized(const TopicConfig& config);
+
+    size_t process_serialized(dds::Reader& reader, const char* topic_name,
+                              const char* type_name, size_t max_samples);
+
+    static size_t drain_can_batches(CanIngest& ingest, dds::Reader& reader,
+                                    size_t max_samples);
 
     dds::Participant& participant_;
     SubscriptionConfig config_;
 
-    // Topics
-    std::unique_ptr<dds::Topic> topic_vss_signal_;
-    std::unique_ptr<dds::Topic> topic_event_;
-    std::unique_ptr<dds::Topic> topic_gauge_;
-    std::unique_ptr<dds::Topic> topic_counter_;
-    std::unique_ptr<dds::Topic> topic_histogram_;
-    std::unique_ptr<dds::Topic> topic_log_entry_;
-    std::unique_ptr<dds::Topic> topic_scalar_measurement_;
-    std::unique_ptr<dds::Topic> topic_vector_measurement_;
-
-    // Readers
-    std::unique_ptr<dds::Reader> reader_vss_signal_;
-    std::unique_ptr<dds::Reader> reader_event_;
-    std::unique_ptr<dds::Reader> reader_gauge_;
-    std::unique_ptr<dds::Reader> reader_counter_;
-    std::unique_ptr<dds::Reader> reader_histogram_;
-    std::unique_ptr<dds::Reader> reader_log_entry_;
-    std::unique_ptr<dds::Reader> reader_scalar_measurement_;
-    std::unique_ptr<dds::Reader> reader_vector_measurement_;
-
-    // Callbacks
-    VssSignalCallback cb_vss_signal_;
-    EventCallback cb_event_;
-    GaugeCallback cb_gauge_;
-    CounterCallback cb_counter_;
-    HistogramCallback cb_histogram_;
-    LogEntryCallback cb_log_entry_;
-    ScalarMeasurementCallback cb_scalar_measurement_;
-    VectorMeasurementCallback cb_vector_measurement_;
-
-    // Polling thread
+    // Typed subscriptions and the readers to attach on start()
+    std::vector<std::unique_ptr<Subscription>> subscriptions_;
+    std::vector<ActiveReader> readers_;
+
+    // Downsampled rt/vss/signals readers, one per signal_rules rate
+    struct SignalRateGroup {
+        double max_hz = 0.0;
+        std::unique_ptr<dds::Topic> topic;
+        std::unique_ptr<dds::Reader> reader;
+    };
+    dds::Topic* signal_topic_ = nullptr;
+    std::vector<SignalRateGroup> signal_groups_;
+
+    // rt/avtp/can/batches, taken as raw CDR into a CanIngest
+    std::unique_ptr<dds::Topic> can_topic_;
+    std::unique_ptr<dds::Reader> can_reader_;
+
+    // Bulk topics
+    std::vector<SerializedTopic> serialized_;
+    SerializedCallback cb_serialized_;
+
+    // Waitset over all active readers (rebuilt on every start())
+    std::unique_ptr<dds::WaitSet> waitset_;
+    std::vector<std::unique_ptr<dds::ReadCondition>> conditions_;
+    DrainScheduler scheduler_;
+
+    // Listener-dispatched readers and their listeners (rebuilt on every start())
+    std::vector<dds::Reader*> listener_readers_;
+    std::vector<std::unique_ptr<dds::Listener>> listeners_;
+
+    // Receive thread
     std::atomic<bool> running_{false};
     std::thread poll_thread_;
 };
 
+/*
+ * Subscribe every typed topic of `config` to one generic handler, e.g.
+ *   [&sink](const auto& msg) { sink->send(msg); }
+ * The handler is copied into, and instantiated for, each topic type.
+ */
+template<typename Handler>
+void subscribe_all(SubscriptionManager& subscriptions, const SubscriptionConfig& config,
+                   const Handler& handler) {
+    subscriptions.subscribe(
+        bind<vss_Signal>(config.vss_signals, handler),
+        bind<telemetry_events_Event>(config.events, handler),
+        bind<telemetry_metrics_Gauge>(config.gauges, handler),
+        bind<telemetry_metrics_Counter>(config.counters, handler),
+        bind<telemetry_metrics_Histogram>(config.histograms, handler),
+        bind<telemetry_logs_LogEntry>(config.logs, handler),
+        bind<telemetry_diagnostics_ScalarMeasurement>(config.scalar_measurements, handler),
+        bind<telemetry_diagnostics_VectorMeasurement>(config.vector_measurements, handler));
+}
+
+/*
+ * Like subscribe_all(), with a handler taking every take as one span, e.g.
+ *   [&sink](auto batch) { sink->send_batch(batch); }
+ */
+template<typename Handler>
+void subscribe_all_batches(SubscriptionManager& subscriptions, const SubscriptionConfig& config,
+                           const Handler& handler) {
+    subscriptions.subscribe(
+        bind_batch<vss_Signal>(config.vss_signals, handler),
+        bind_batch<telemetry_events_Event>(config.events, handler),
+        bind_batch<telemetry_metrics_Gauge>(config.gauges, handler),
+        bind_batch<telemetry_metrics_Counter>(config.counters, handler),
+        bind_batch<telemetry_metrics_Histogram>(config.histograms, handler),
+        bind_batch<telemetry_logs_LogEntry>(config.logs, handler),
+        bind_batch<telemetry_diagnostics_ScalarMeasurement>(config.scalar_measurements, handler),
+        bind_batch<telemetry_diagnostics_VectorMeasurement>(config.vector_measurements, handler));
+}
+
+// Template implementations
+
+template<typename Binding>
+void SubscriptionManager::add(Binding binding) {
+    using T = typename Binding::Sample;
+    using Traits = TopicTraits<T>;
+
+    if (!binding.config().enabled) {
+        return;
+    }
+    if (auto error = validate(binding.config().qos)) {
+        throw std::invalid_argument(std::string(Traits::name) + ": " + *error);
+    }
+    if constexpr (std::is_same_v<T, vss_Signal>) {
+        // Its filter and rate groups are shared by every reader of the topic
+        if (signal_topic_) {
+            throw std::invalid_argument(std::string(Traits::name) + ": already subscribed");
+        }
+    }
+
+    auto subscription = std::make_unique<BoundSubscription<Binding>>(std::move(binding));
+    Binding* bound = &subscription->binding;
+    const TopicConfig& config = bound->config();
+
+    auto qos = make_qos(config.qos);
+    subscription->topic = std::make_unique<dds::Topic>(
+        participant_, Traits::descriptor(), Traits::name, qos.get());
+
+    // Filters must be in place before the reader sees any data
+    std::vector<dds::Reader*> readers;
+    if constexpr (std::is_same_v<T, vss_Signal>) {
+        readers = setup_signal_topic(*subscription->topic, config);
+    }
+
+    subscription->reader = std::make_unique<dds::Reader>(
+        participant_, *subscription->topic, qos.get());
+    readers.insert(readers.begin(), subscription->reader.get());
+
+    for (dds::Reader* reader : readers) {
+        readers_.push_back({reader, &config, [bound, reader](size_t max_samples) {
+            return drain_reader(*bound, *reader, max_samples, Traits::name);
+        }});
+    }
+    subscriptions_.push_back(std::move(subscription));
+}
+
+template<typename Binding>
+size_t SubscriptionManager::drain_reader(Binding& binding, dds::Reader& reader,
+                                         size_t max_samples, const char* topic_name) {
+    try {
+        return binding.drain(reader, max_samples);
+    } catch (const dds::Error& e) {
+        log_take_error(topic_name, e);
+        return 0;
+    }
+}
+
 }  // namespace vdr
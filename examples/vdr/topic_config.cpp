@@ -0,0 +1,100 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/topic_config.hpp"
+#include "common/qos_profiles.hpp"
+
+namespace vdr {
+
+std::optional<Dispatch> parse_dispatch(std::string_view name) {
+    if (name == "waitset") return Dispatch::Waitset;
+    if (name == "listener") return Dispatch::Listener;
+    return std::nullopt;
+}
+
+const char* to_string(Dispatch dispatch) {
+    switch (dispatch) {
+        case Dispatch::Waitset: return "waitset";
+        case Dispatch::Listener: return "listener";
+    }
+    return "unknown";
+}
+
+std::optional<QosProfile> parse_qos_profile(std::string_view name) {
+    if (name == "reliable_critical") return QosProfile::ReliableCritical;
+    if (name == "reliable_standard") return QosProfile::ReliableStandard;
+    if (name == "best_effort") return QosProfile::BestEffort;
+    return std::nullopt;
+}
+
+const char* to_string(QosProfile profile) {
+    switch (profile) {
+        case QosProfile::ReliableCritical: return "reliable_critical";
+        case QosProfile::ReliableStandard: return "reliable_standard";
+        case QosProfile::BestEffort: return "best_effort";
+    }
+    return "unknown";
+}
+
+std::optional<std::string> validate(const TopicQos& qos) {
+    auto valid_limit = [](int32_t limit) {
+        return limit == DDS_LENGTH_UNLIMITED || limit > 0;
+    };
+
+    if (qos.history_depth < 0) {
+        return "history depth must be >= 0 (0 = keep all)";
+    }
+    if (!valid_limit(qos.max_samples)) {
+        return "max_samples must be positive or -1 (unlimited)";
+    }
+    if (!valid_limit(qos.max_instances)) {
+        return "max_instances must be positive or -1 (unlimited)";
+    }
+    if (qos.max_samples != DDS_LENGTH_UNLIMITED && qos.history_depth > qos.max_samples) {
+        return "history depth " + std::to_string(qos.history_depth) +
+               " exceeds max_samples " + std::to_string(qos.max_samples);
+    }
+    // A best-effort writer never waits for the reader, so keep-all grows
+    // without bound whenever the VDR falls behind
+    if (qos.profile == QosProfile::BestEffort && qos.history_depth == 0 &&
+        qos.max_samples == DDS_LENGTH_UNLIMITED) {
+        return "keep-all history on a best-effort topic needs max_samples";
+    }
+    return std::nullopt;
+}
+
+dds::Qos make_qos(const TopicQos& settings) {
+    dds::Qos qos = [&] {
+        switch (settings.profile) {
+            case QosProfile::ReliableCritical: return dds::qos_profiles::reliable_critical();
+            case QosProfile::BestEffort: return dds::qos_profiles::best_effort();
+            case QosProfile::ReliableStandard: break;
+        }
+        return dds::qos_profiles::reliable_standard();
+    }();
+
+    if (settings.history_depth > 0) {
+        qos.history_keep_last(settings.history_depth);
+    } else {
+        qos.history_keep_all();
+    }
+    if (settings.max_samples != DDS_LENGTH_UNLIMITED ||
+        settings.max_instances != DDS_LENGTH_UNLIMITED) {
+        qos.resource_limits(settings.max_samples, settings.max_instances);
+    }
+    return qos;
+}
+
+}  // namespace vdr
@@ -0,0 +1,89 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file topic_config.hpp
+/// @brief Per-topic subscription settings
+///
+/// Priority, dispatch mode and reader QoS of one subscribed topic, as
+/// loaded from the subscriptions section of vdr_config.yaml.
+
+#include "common/dds_wrapper.hpp"
+#include "vdr/drain_scheduler.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace vdr {
+
+/*
+ * How a topic's samples reach its handler.
+ *
+ * Waitset: the SubscriptionManager thread drains the reader in priority
+ * order (see DrainScheduler). Listener: the handler runs directly on the
+ * Cyclone receive thread that stored the sample - lowest latency, but a
+ * slow handler holds up reception, so reserve it for light, urgent topics.
+ */
+enum class Dispatch {
+    Waitset,
+    Listener,
+};
+
+std::optional<Dispatch> parse_dispatch(std::string_view name);
+const char* to_string(Dispatch dispatch);
+
+/*
+ * Base QoS profile of a topic (see common/qos_profiles.hpp).
+ */
+enum class QosProfile {
+    ReliableCritical,
+    ReliableStandard,
+    BestEffort,
+};
+
+std::optional<QosProfile> parse_qos_profile(std::string_view name);
+const char* to_string(QosProfile profile);
+
+/*
+ * Reader QoS of a topic: a base profile with history and resource limits
+ * applied on top. Limits use DDS_LENGTH_UNLIMITED for no bound.
+ */
+struct TopicQos {
+    QosProfile profile = QosProfile::ReliableStandard;
+    int32_t history_depth = 100;  // KEEP_LAST depth per instance, 0 = KEEP_ALL
+    int32_t max_samples = DDS_LENGTH_UNLIMITED;
+    int32_t max_instances = DDS_LENGTH_UNLIMITED;
+};
+
+// Why the settings cannot be used, or nullopt if they are valid
+std::optional<std::string> validate(const TopicQos& qos);
+
+dds::Qos make_qos(const TopicQos& qos);
+
+/*
+ * Per-topic subscription settings.
+ */
+struct TopicConfig {
+    bool enabled = true;
+    Priority priority = Priority::Medium;
+    size_t drain_budget = 0;  // Samples per scheduling round, 0 = priority default
+    Dispatch dispatch = Dispatch::Waitset;
+    TopicQos qos;
+};
+
+}  // namespace vdr
@@ -0,0 +1,267 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file topic_registry.hpp
+/// @brief Compile-time table of subscribable topics
+///
+/// TopicTraits<T> maps every IDL type the VDR can receive to its DDS topic
+/// name, type descriptor and default reader QoS (see the topic table in
+/// SPECIFICATION.md). TopicBinding<T, Handler> pairs one of those types with
+/// a concrete handler, so the take loop for that topic is instantiated with
+/// the handler inlined instead of going through a type-erased callback.
+///
+/// Subscribing to a new type means adding a TopicTraits specialization and
+/// passing a binding to SubscriptionManager::subscribe(). bind() calls the
+/// handler per sample, bind_batch() once per take with all of its samples.
+
+#include "common/dds_wrapper.hpp"
+#include "common/span.hpp"
+#include "vdr/topic_config.hpp"
+#include "telemetry.h"
+#include "vss_signal.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vdr {
+
+/// Topic name, type descriptor and default QoS of a subscribable type.
+///
+/// Deliberately undefined for other types, so subscribing to a type
+/// without a topic is a compile error.
+template<typename T>
+struct TopicTraits;
+
+template<>
+struct TopicTraits<vss_Signal> {
+    static constexpr const char* name = "rt/vss/signals";
+    static const dds_topic_descriptor_t* descriptor() { return &vss_Signal_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 100};
+};
+
+template<>
+struct TopicTraits<telemetry_events_Event> {
+    static constexpr const char* name = "rt/events/vehicle";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_events_Event_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableCritical, 0};
+};
+
+template<>
+struct TopicTraits<telemetry_diagnostics_ScalarMeasurement> {
+    static constexpr const char* name = "rt/diagnostics/scalar";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_diagnostics_ScalarMeasurement_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 10};
+};
+
+template<>
+struct TopicTraits<telemetry_diagnostics_VectorMeasurement> {
+    static constexpr const char* name = "rt/diagnostics/vector";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_diagnostics_VectorMeasurement_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 10};
+};
+
+template<>
+struct TopicTraits<telemetry_diagnostics_MatrixMeasurement> {
+    static constexpr const char* name = "rt/diagnostics/matrix";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_diagnostics_MatrixMeasurement_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 10};
+};
+
+template<>
+struct TopicTraits<telemetry_metrics_Counter> {
+    static constexpr const char* name = "rt/telemetry/counters";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_metrics_Counter_desc; }
+    static constexpr TopicQos default_qos{QosProfile::BestEffort, 1};
+};
+
+template<>
+struct TopicTraits<telemetry_metrics_Gauge> {
+    static constexpr const char* name = "rt/telemetry/gauges";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_metrics_Gauge_desc; }
+    static constexpr TopicQos default_qos{QosProfile::BestEffort, 1};
+};
+
+template<>
+struct TopicTraits<telemetry_metrics_Histogram> {
+    static constexpr const char* name = "rt/telemetry/histograms";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_metrics_Histogram_desc; }
+    static constexpr TopicQos default_qos{QosProfile::BestEffort, 1};
+};
+
+template<>
+struct TopicTraits<telemetry_metrics_Summary> {
+    static constexpr const char* name = "rt/telemetry/summaries";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_metrics_Summary_desc; }
+    static constexpr TopicQos default_qos{QosProfile::BestEffort, 1};
+};
+
+template<>
+struct TopicTraits<telemetry_logs_LogEntry> {
+    static constexpr const char* name = "rt/logs/entries";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_logs_LogEntry_desc; }
+    static constexpr TopicQos default_qos{QosProfile::BestEffort, 100};
+};
+
+template<>
+struct TopicTraits<telemetry_avtp_AcfCanFrame> {
+    static constexpr const char* name = "rt/avtp/can/frames";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_avtp_AcfCanFrame_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 500};
+};
+
+template<>
+struct TopicTraits<telemetry_avtp_AcfCanBatch> {
+    static constexpr const char* name = "rt/avtp/can/batches";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_avtp_AcfCanBatch_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 100};
+};
+
+template<>
+struct TopicTraits<telemetry_avtp_CanTrace> {
+    static constexpr const char* name = "rt/avtp/can/traces";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_avtp_CanTrace_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 10};
+};
+
+template<>
+struct TopicTraits<telemetry_avtp_StreamStats> {
+    static constexpr const char* name = "rt/avtp/stats";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_avtp_StreamStats_desc; }
+    static constexpr TopicQos default_qos{QosProfile::BestEffort, 1};
+};
+
+template<>
+struct TopicTraits<telemetry_opaque_FreezeFrame> {
+    static constexpr const char* name = "rt/opaque/freeze_frames";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_opaque_FreezeFrame_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 10};
+};
+
+template<>
+struct TopicTraits<telemetry_opaque_StateSnapshot> {
+    static constexpr const char* name = "rt/opaque/state_snapshots";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_opaque_StateSnapshot_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableStandard, 10};
+};
+
+template<>
+struct TopicTraits<telemetry_security_Incident> {
+    static constexpr const char* name = "rt/security/incidents";
+    static const dds_topic_descriptor_t* descriptor() { return &telemetry_security_Incident_desc; }
+    static constexpr TopicQos default_qos{QosProfile::ReliableCritical, 0};
+};
+
+/// A topic type bound to its handler and subscription settings.
+///
+/// Handler is any callable taking `const T&`; it is stored by value and
+/// called directly from drain(), so lambdas are inlined into the take
+/// loop. The handler runs on the receive thread, or on a DDS thread for
+/// listener dispatch.
+template<typename T, typename Handler>
+class TopicBinding {
+public:
+    using Sample = T;
+    using Traits = TopicTraits<T>;
+
+    TopicBinding(const TopicConfig& config, Handler handler)
+        : config_(config), handler_(std::move(handler)) {}
+
+    const TopicConfig& config() const { return config_; }
+
+    /// Take up to `max_samples` from `reader` and hand each valid sample
+    /// to the handler. Returns the number of samples taken, including
+    /// invalid ones (dispose/unregister), so callers stop only when the
+    /// reader is empty.
+    size_t drain(dds::Reader& reader, size_t max_samples) {
+        size_t taken = 0;
+        reader.take_each<T>(handler_, max_samples, &taken);
+        return taken;
+    }
+
+private:
+    TopicConfig config_;
+    Handler handler_;
+};
+
+/// A topic type bound to a handler taking a whole take at once.
+///
+/// Handler is any callable taking `utils::Span<const T>`; it gets the
+/// valid samples of each take in one call (at most the drain budget, or
+/// the take size for unbudgeted topics). The span holds shallow copies:
+/// their strings and sequences point into the DDS loan, which is held
+/// until the handler returns.
+template<typename T, typename Handler>
+class TopicBatchBinding {
+public:
+    using Sample = T;
+    using Traits = TopicTraits<T>;
+
+    TopicBatchBinding(const TopicConfig& config, Handler handler)
+        : config_(config), handler_(std::move(handler)) {}
+
+    const TopicConfig& config() const { return config_; }
+
+    /// Take up to `max_samples` from `reader` and hand the valid ones to
+    /// the handler in one span. Returns the number of samples taken,
+    /// including invalid ones.
+    size_t drain(dds::Reader& reader, size_t max_samples) {
+        // Per thread, since listener dispatch may drain several readers of
+        // one binding concurrently; grows once, then allocates nothing
+        thread_local std::vector<T> batch;
+
+        auto samples = reader.take_loan<T>(max_samples);
+        batch.clear();
+        for (auto sample : samples) {
+            if (sample.valid()) {
+                batch.push_back(sample.data);
+            }
+        }
+        if (!batch.empty()) {
+            handler_(utils::Span<const T>(batch));
+        }
+        return samples.size();
+    }
+
+private:
+    TopicConfig config_;
+    Handler handler_;
+};
+
+/// Bind `handler` to T's topic with explicit settings.
+template<typename T, typename Handler>
+TopicBinding<T, std::decay_t<Handler>> bind(const TopicConfig& config, Handler&& handler) {
+    return {config, std::forward<Handler>(handler)};
+}
+
+/// Bind `handler` to T's topic with the default settings of its traits.
+template<typename T, typename Handler>
+TopicBinding<T, std::decay_t<Handler>> bind(Handler&& handler) {
+    TopicConfig config;
+    config.qos = TopicTraits<T>::default_qos;
+    return {config, std::forward<Handler>(handler)};
+}
+
+/// Bind a batch `handler` to T's topic with explicit settings.
+template<typename T, typename Handler>
+TopicBatchBinding<T, std::decay_t<Handler>> bind_batch(const TopicConfig& config,
+                                                       Handler&& handler) {
+    return {config, std::forward<Handler>(handler)};
+}
+
+}  // namespace vdr
@@ -0,0 +1,104 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vdr/vssdag_mapping.hpp"
+
+#include <glog/logging.h>
+#include <yaml-cpp/yaml.h>
+
+#include <exception>
+#include <utility>
+
+namespace vdr {
+
+std::optional<TransformSpec> load_transform(const YAML::Node& transform,
+                                            const std::string& path) {
+    TransformSpec spec;
+    if (transform["value_map"]) {
+        spec.kind = TransformKind::ValueMap;
+        for (const auto& entry : transform["value_map"]) {
+            try {
+                spec.value_map.emplace_back(entry.first.as<double>(), entry.second.as<double>());
+            } catch (const YAML::Exception&) {
+                LOG(WARNING) << "Ignoring non-numeric value_map entry of " << path;
+            }
+        }
+    } else if (transform["code"]) {
+        spec = parse_transform_code(transform["code"].as<std::string>());
+    }
+
+    try {
+        SignalTransform check(spec);
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "Transform of " << path << " cannot run: " << e.what();
+        return std::nullopt;
+    }
+    return spec;
+}
+
+std::vector<CanSignalMapping> load_vssdag_mappings(const std::string& path) {
+    std::vector<CanSignalMapping> mappings;
+    size_t native = 0;
+    size_t lua = 0;
+
+    YAML::Node yaml = YAML::LoadFile(path);
+    for (const auto& signal : yaml["signals"]) {
+        const YAML::Node source = signal["source"];
+        const YAML::Node depends_on = signal["depends_on"];
+        bool derived = !source && depends_on;
+        if (!derived && (!source || source["type"].as<std::string>("") != "dbc")) {
+            continue;
+        }
+
+        CanSignalMapping mapping;
+        mapping.vss_path = signal["signal"].as<std::string>("");
+        if (derived) {
+            for (const auto& dependency : depends_on) {
+                mapping.depends_on.push_back(dependency.as<std::string>());
+            }
+        } else {
+            mapping.dbc_signal = source["name"].as<std::string>("");
+        }
+        std::string datatype = signal["datatype"].as<std::string>("double");
+        if (auto type = parse_value_type(datatype)) {
+            mapping.type = *type;
+        } else {
+            LOG(WARNING) << "Unknown datatype '" << datatype << "' for " << mapping.vss_path
+                         << ", publishing as double";
+        }
+
+        if (signal["transform"]) {
+            auto spec = load_transform(signal["transform"], mapping.vss_path);
+            if (!spec && derived) {
+                LOG(WARNING) << "Not publishing derived signal " << mapping.vss_path;
+                continue;
+            }
+            if (spec) {
+                mapping.transform = std::move(*spec);
+            }
+            if (mapping.transform.kind == TransformKind::Lua) {
+                ++lua;
+            } else if (mapping.transform.kind != TransformKind::Identity) {
+                ++native;
+            }
+        }
+        mappings.push_back(std::move(mapping));
+    }
+
+    LOG(INFO) << "CAN signal transforms: " << native << " native, " << lua << " Lua";
+    return mappings;
+}
+
+}  // namespace vdr
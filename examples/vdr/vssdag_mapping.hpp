@@ -0,0 +1,48 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file vssdag_mapping.hpp
+/// @brief CAN signal mappings from a vssdag probe config
+///
+/// Reads the `signals` of a vssdag_probe_config.yaml into CanDecoder
+/// mappings: signals with `source: {type: dbc}`, and derived signals
+/// (`depends_on`, no source). Other sources (e.g. mock) are not decoded.
+
+#include "vdr/can_decoder.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace YAML {
+class Node;
+}
+
+namespace vdr {
+
+/// Parse a signal's `transform:` node. Returns std::nullopt, after logging
+/// why, if this build cannot run it (invalid parameters, or custom code
+/// without the Lua fallback).
+std::optional<TransformSpec> load_transform(const YAML::Node& transform,
+                                            const std::string& path);
+
+/// Load the mappings of the vssdag probe config at `path`. A DBC signal
+/// whose transform cannot run is published untransformed; a derived signal
+/// whose transform cannot run is left out. Throws YAML::Exception.
+std::vector<CanSignalMapping> load_vssdag_mappings(const std::string& path);
+
+}  // namespace vdr
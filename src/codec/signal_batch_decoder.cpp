@@ -0,0 +1,238 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "codec/signal_batch_decoder.hpp"
+
+namespace vdr {
+namespace codec {
+
+namespace {
+
+void clear(FieldValue& value) {
+    value.string_value.clear();
+    value.bool_array.clear();
+    value.int_array.clear();
+    value.double_array.clear();
+    value.string_array.clear();
+}
+
+// Scalar and array types; false for STRUCT/STRUCT_ARRAY and unknown types
+bool read_field_value(ByteReader& reader, ValueType type, FieldValue& out) {
+    out.type = type;
+    clear(out);
+    switch (type) {
+        case ValueType::Empty: break;
+        case ValueType::Bool: out.bool_value = reader.u8() != 0; break;
+        case ValueType::Int8:
+        case ValueType::Int16:
+        case ValueType::Int32:
+        case ValueType::Int64: out.int_value = reader.svarint(); break;
+        case ValueType::Uint8:
+        case ValueType::Uint16:
+        case ValueType::Uint32:
+        case ValueType::Uint64: out.uint_value = reader.varint(); break;
+        case ValueType::Float: out.double_value = reader.fixed<float>(); break;
+        case ValueType::Double: out.double_value = reader.fixed<double>(); break;
+        case ValueType::String: out.string_value = reader.str(); break;
+        case ValueType::BoolArray:
+            for (uint64_t n = reader.count(); n > 0; --n) {
+                out.bool_array.push_back(reader.u8() != 0);
+            }
+            break;
+        case ValueType::Int32Array:
+        case ValueType::Int64Array:
+            for (uint64_t n = reader.count(); n > 0; --n) {
+                out.int_array.push_back(reader.svarint());
+            }
+            break;
+        case ValueType::FloatArray:
+            for (uint64_t n = reader.count(sizeof(float)); n > 0; --n) {
+                out.double_array.push_back(reader.fixed<float>());
+            }
+            break;
+        case ValueType::DoubleArray:
+            for (uint64_t n = reader.count(sizeof(double)); n > 0; --n) {
+                out.double_array.push_back(reader.fixed<double>());
+            }
+            break;
+        case ValueType::StringArray:
+            for (uint64_t n = reader.count(); n > 0; --n) {
+                out.string_array.emplace_back(reader.str());
+            }
+            break;
+        default: return false;
+    }
+    return reader.ok();
+}
+
+bool read_struct(ByteReader& reader, DecodedStruct& out) {
+    out.type_name = reader.str();
+    // name length + type byte per field at least
+    uint64_t count = reader.count(2);
+    out.fields.resize(count);
+    for (auto& field : out.fields) {
+        field.name = reader.str();
+        auto type = static_cast<ValueType>(reader.u8());
+        if (!read_field_value(reader, type, field)) {
+            return false;
+        }
+    }
+    return reader.ok();
+}
+
+bool read_value(ByteReader& reader, ValueType type, DecodedValue& out) {
+    if (type == ValueType::Struct) {
+        out.type = type;
+        clear(out);
+        return read_struct(reader, out.struct_value);
+    }
+    if (type == ValueType::StructArray) {
+        out.type = type;
+        clear(out);
+        // type name length + field count per struct at least
+        out.struct_array.resize(reader.count(2));
+        for (auto& element : out.struct_array) {
+            if (!read_struct(reader, element)) {
+                return false;
+            }
+        }
+        return reader.ok();
+    }
+    return read_field_value(reader, type, out);
+}
+
+}  // namespace
+
+const char* to_string(DecodeStatus status) {
+    switch (status) {
+        case DecodeStatus::Ok: return "ok";
+        case DecodeStatus::Malformed: return "malformed";
+        case DecodeStatus::UnsupportedVersion: return "unsupported version";
+        case DecodeStatus::UnknownSession: return "unknown session";
+        case DecodeStatus::MissingEntries: return "missing dictionary entries";
+    }
+    return "unknown";
+}
+
+DecodeStatus SignalBatchDecoder::decode(const uint8_t* data, size_t size,
+                                        const SignalFn& on_signal) {
+    if (size < kFrameHeaderSize || data[0] != 'V' || data[1] != 'S') {
+        return DecodeStatus::Malformed;
+    }
+    if (data[2] != kSignalBatchVersion) {
+        return DecodeStatus::UnsupportedVersion;
+    }
+    ByteReader reader(data + 4, size - 4);
+    uint64_t session_id = reader.fixed<uint64_t>();
+    switch (static_cast<FrameKind>(data[3])) {
+        case FrameKind::Dictionary: return decode_dictionary(reader, session_id);
+        case FrameKind::Batch: return decode_batch(reader, session_id, on_signal);
+    }
+    return DecodeStatus::Malformed;
+}
+
+void SignalBatchDecoder::reset() {
+    entries_.clear();
+    session_id_ = 0;
+    has_session_ = false;
+}
+
+DecodeStatus SignalBatchDecoder::decode_dictionary(ByteReader& reader, uint64_t session_id) {
+    uint64_t first_id = reader.varint();
+    uint64_t count = reader.count();
+    if (!reader.ok()) {
+        return DecodeStatus::Malformed;
+    }
+
+    // Parse everything before touching the dictionary, so a malformed
+    // frame leaves it as it was
+    std::vector<std::string_view> names(count);
+    for (auto& name : names) {
+        name = reader.str();
+    }
+    if (!reader.ok()) {
+        return DecodeStatus::Malformed;
+    }
+
+    bool same_session = has_session_ && session_id == session_id_;
+    if (first_id == 0) {
+        if (same_session && names.size() < entries_.size()) {
+            // Stale snapshot: ids are append-only, so ours is a superset
+            return DecodeStatus::Ok;
+        }
+        entries_.clear();
+        session_id_ = session_id;
+        has_session_ = true;
+    } else if (!same_session) {
+        return DecodeStatus::UnknownSession;
+    } else if (first_id > entries_.size()) {
+        return DecodeStatus::MissingEntries;
+    }
+
+    // Entries we already hold (a repeated update) are skipped
+    for (size_t id = entries_.size() - first_id; id < names.size(); ++id) {
+        entries_.emplace_back(names[id]);
+    }
+    return DecodeStatus::Ok;
+}
+
+DecodeStatus SignalBatchDecoder::decode_batch(ByteReader& reader, uint64_t session_id,
+                                              const SignalFn& on_signal) {
+    if (!has_session_ || session_id != session_id_) {
+        return DecodeStatus::UnknownSession;
+    }
+    uint64_t dictionary_size = reader.varint();
+    // Deltas wrap modulo 2^64, like the encoder's; crafted input cannot
+    // overflow a signed sum
+    uint64_t timestamp_ns = static_cast<uint64_t>(reader.svarint());
+    uint64_t batch_source = reader.varint();
+    // path id + head + timestamp delta per signal at least
+    uint64_t count = reader.count(3);
+    if (!reader.ok()) {
+        return DecodeStatus::Malformed;
+    }
+    if (dictionary_size > entries_.size()) {
+        return DecodeStatus::MissingEntries;
+    }
+    if (batch_source >= dictionary_size) {
+        return DecodeStatus::Malformed;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t path_id = reader.varint();
+        uint8_t head = reader.u8();
+        uint64_t source = batch_source;
+        if (head & kSourceOverride) {
+            source = reader.varint();
+        }
+        timestamp_ns += static_cast<uint64_t>(reader.svarint());
+        if (!reader.ok() || path_id >= dictionary_size || source >= dictionary_size) {
+            return DecodeStatus::Malformed;
+        }
+
+        signal_.path = entries_[path_id];
+        signal_.source_id = entries_[source];
+        signal_.timestamp_ns = static_cast<int64_t>(timestamp_ns);
+        signal_.quality = (head >> kQualityShift) & kQualityMask;
+        if (!read_value(reader, static_cast<ValueType>(head & kValueTypeMask), signal_.value)) {
+            return DecodeStatus::Malformed;
+        }
+        on_signal(signal_);
+    }
+    return reader.remaining() == 0 ? DecodeStatus::Ok : DecodeStatus::Malformed;
+}
+
+}  // namespace codec
+}  // namespace vdr
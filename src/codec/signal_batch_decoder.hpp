@@ -0,0 +1,128 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file signal_batch_decoder.hpp
+/// @brief Standalone decoder for EncodedSignalBatch frames
+///
+/// Has no dependency on DDS or the VSS C types, so offboard consumers can
+/// link vdr_signal_batch on its own. See signal_batch_format.hpp for the
+/// wire format.
+
+#include "codec/signal_batch_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vdr {
+namespace codec {
+
+/*
+ * Scalar or array value, the part shared by signal values and struct
+ * fields. Integers are widened to 64 bits and floats to double; `type`
+ * keeps the original width.
+ */
+struct FieldValue {
+    ValueType type = ValueType::Empty;
+    bool bool_value = false;
+    int64_t int_value = 0;     // INT8..INT64
+    uint64_t uint_value = 0;   // UINT8..UINT64
+    double double_value = 0;   // FLOAT, DOUBLE
+    std::string string_value;
+    std::vector<bool> bool_array;
+    std::vector<int64_t> int_array;     // INT32_ARRAY, INT64_ARRAY
+    std::vector<double> double_array;   // FLOAT_ARRAY, DOUBLE_ARRAY
+    std::vector<std::string> string_array;
+};
+
+struct DecodedField : FieldValue {
+    std::string name;
+};
+
+struct DecodedStruct {
+    std::string type_name;
+    std::vector<DecodedField> fields;
+};
+
+struct DecodedValue : FieldValue {
+    DecodedStruct struct_value;
+    std::vector<DecodedStruct> struct_array;
+};
+
+/*
+ * One signal of a batch. path and source_id point into the decoder's
+ * dictionary and stay valid until the next dictionary frame is decoded.
+ */
+struct DecodedSignal {
+    std::string_view path;
+    std::string_view source_id;
+    int64_t timestamp_ns = 0;
+    uint8_t quality = 0;  // vss::types::Quality
+    DecodedValue value;
+};
+
+enum class DecodeStatus {
+    Ok,
+    Malformed,           // truncated frame, bad magic or out-of-range id
+    UnsupportedVersion,
+    UnknownSession,      // batch or dictionary update for a session without a snapshot
+    MissingEntries       // dictionary frames were lost; wait for the next snapshot
+};
+
+const char* to_string(DecodeStatus status);
+
+/*
+ * Decodes the frames of one session in the order they were produced.
+ *
+ * Dictionary frames update the dictionary; a snapshot (first id 0) from a
+ * new session replaces it. Batch frames are decoded against the
+ * dictionary and each signal is passed to the callback; the DecodedSignal
+ * is reused between calls, so copy what must outlive the callback. If a
+ * batch turns out malformed part way, the signals before that point have
+ * already been delivered.
+ *
+ * Not thread-safe; use one decoder per session.
+ */
+class SignalBatchDecoder {
+public:
+    using SignalFn = std::function<void(const DecodedSignal&)>;
+
+    DecodeStatus decode(const uint8_t* data, size_t size, const SignalFn& on_signal);
+
+    // Forget the session, e.g. when the producer is known to have restarted
+    void reset();
+
+    uint64_t session_id() const noexcept { return session_id_; }
+    size_t dictionary_size() const noexcept { return entries_.size(); }
+    const std::vector<std::string>& dictionary() const noexcept { return entries_; }
+
+private:
+    DecodeStatus decode_dictionary(ByteReader& reader, uint64_t session_id);
+    DecodeStatus decode_batch(ByteReader& reader, uint64_t session_id,
+                              const SignalFn& on_signal);
+
+    std::vector<std::string> entries_;
+    uint64_t session_id_ = 0;
+    bool has_session_ = false;
+    DecodedSignal signal_;
+};
+
+}  // namespace codec
+}  // namespace vdr
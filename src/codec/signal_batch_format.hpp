@@ -0,0 +1,235 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file signal_batch_format.hpp
+/// @brief Wire format of EncodedSignalBatch, the dictionary-coded signal batch
+///
+/// A session is a stream of frames from one encoder, identified by a
+/// random 64-bit session id. VSS paths and source ids are replaced by
+/// varint ids from a dictionary that only grows: ids are assigned in
+/// order of first use and never change within the session, so the number
+/// of entries doubles as the dictionary version. The encoder sends each
+/// entry once, in a dictionary frame ahead of the first batch that uses
+/// it, and a full snapshot when asked to (e.g. after a reconnect).
+///
+/// All integers are LEB128 varints ("v"), signed ones zigzag-coded ("z")
+/// first; f32/f64 are little-endian IEEE 754; str is v length + bytes.
+///
+///   frame       = 'V' 'S' version(u8) kind(u8) session_id(u64 LE) body
+///   dictionary  = first_id(v) count(v) { str }*count
+///                 first_id 0 replaces the dictionary (snapshot);
+///                 otherwise it must equal the decoder's entry count
+///   batch       = dictionary_size(v) base_timestamp_ns(z) source_id(v)
+///                 count(v) { signal }*count
+///   signal      = path_id(v) head(u8) [source_id(v)] timestamp_delta(z) value
+///   head        = value_type (bits 0-4) | quality << 5 (bits 5-6)
+///                 | bit 7: the signal's source differs from the batch's
+///
+/// timestamp_delta is relative to the previous signal's timestamp (the
+/// batch base for the first one), modulo 2^64, so a batch sorted by time
+/// costs one to three bytes per timestamp. Values by type:
+///   EMPTY        nothing
+///   BOOL         u8 0/1
+///   INT8..INT64  z            UINT8..UINT64  v
+///   FLOAT        f32          DOUBLE         f64
+///   STRING       str
+///   *_ARRAY      count(v) then elements as above (BOOL as u8)
+///   STRUCT       type_name(str) field_count(v)
+///                { name(str) value_type(u8) value }*field_count
+///   STRUCT_ARRAY count(v) { STRUCT }*count
+/// Header seq_num and correlation_id are not carried.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace vdr {
+namespace codec {
+
+constexpr uint8_t kSignalBatchVersion = 1;
+constexpr size_t kFrameHeaderSize = 12;
+
+enum class FrameKind : uint8_t {
+    Dictionary = 1,
+    Batch = 2
+};
+
+/*
+ * Value types, numbered as vss::types::ValueType.
+ */
+enum class ValueType : uint8_t {
+    Empty, Bool, Int8, Int16, Int32, Int64, Uint8, Uint16, Uint32, Uint64, Float, Double,
+    String, BoolArray, Int32Array, Int64Array, FloatArray, DoubleArray, StringArray,
+    Struct, StructArray
+};
+
+constexpr uint8_t kValueTypeMask = 0x1f;
+constexpr uint8_t kQualityShift = 5;
+constexpr uint8_t kQualityMask = 0x03;
+constexpr uint8_t kSourceOverride = 0x80;
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Reverses `N` bytes in place on big-endian hosts; a no-op elsewhere
+template<size_t N>
+inline void to_little_endian(char (&bytes)[N]) noexcept {
+    if constexpr (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__) {
+        for (size_t i = 0; i < N / 2; ++i) {
+            char tmp = bytes[i];
+            bytes[i] = bytes[N - 1 - i];
+            bytes[N - 1 - i] = tmp;
+        }
+    }
+}
+
+/*
+ * Appends the format's primitives to a byte buffer.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::string& out) : out_(out) {}
+
+    void u8(uint8_t value) { out_.push_back(static_cast<char>(value)); }
+
+    void varint(uint64_t value) {
+        char bytes[10];
+        size_t n = 0;
+        while (value >= 0x80) {
+            bytes[n++] = static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        bytes[n++] = static_cast<char>(value);
+        out_.append(bytes, n);
+    }
+
+    void svarint(int64_t value) { varint(zigzag(value)); }
+
+    template<typename T>
+    void fixed(T value) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "fixed() is for f32/f64/u64");
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        to_little_endian(bytes);
+        out_.append(bytes, sizeof(T));
+    }
+
+    void str(std::string_view value) {
+        varint(value.size());
+        out_.append(value.data(), value.size());
+    }
+
+    void frame_header(FrameKind kind, uint64_t session_id) {
+        u8('V');
+        u8('S');
+        u8(kSignalBatchVersion);
+        u8(static_cast<uint8_t>(kind));
+        fixed(session_id);
+    }
+
+    std::string& buffer() noexcept { return out_; }
+
+private:
+    std::string& out_;
+};
+
+/*
+ * Bounds-checked cursor over one frame. Errors are sticky, as with
+ * dds::CdrReader: once a read runs past the end, ok() turns false and
+ * every further read yields zero/empty.
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    bool ok() const noexcept { return ok_; }
+    size_t remaining() const noexcept { return ok_ ? size_ - pos_ : 0; }
+
+    uint8_t u8() {
+        if (!has(1)) return 0;
+        return data_[pos_++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (!has(1)) return 0;
+            uint8_t byte = data_[pos_++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok_ = false;  // more than 10 bytes
+        return 0;
+    }
+
+    int64_t svarint() { return unzigzag(varint()); }
+
+    template<typename T>
+    T fixed() {
+        T value{};
+        if (!has(sizeof(T))) return value;
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, data_ + pos_, sizeof(T));
+        to_little_endian(bytes);
+        std::memcpy(&value, bytes, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    // View into the frame; valid as long as the frame's buffer
+    std::string_view str() {
+        uint64_t length = varint();
+        if (!has(length)) return {};
+        std::string_view value(reinterpret_cast<const char*>(data_ + pos_), length);
+        pos_ += length;
+        return value;
+    }
+
+    // Element count that needs at least `min_bytes` per element to follow;
+    // rejects counts the frame cannot hold before anything is allocated
+    uint64_t count(size_t min_bytes = 1) {
+        uint64_t n = varint();
+        if (ok_ && n > remaining() / (min_bytes ? min_bytes : 1)) {
+            ok_ = false;
+        }
+        return ok_ ? n : 0;
+    }
+
+private:
+    bool has(uint64_t bytes) {
+        if (!ok_ || bytes > size_ - pos_) {
+            ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+}  // namespace codec
+}  // namespace vdr
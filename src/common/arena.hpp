@@ -0,0 +1,144 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file arena.hpp
+/// @brief Bump allocator for batch-scoped message copies
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace utils {
+
+/*
+ * Bump-pointer arena.
+ *
+ * Allocations are carved sequentially out of large blocks and are never
+ * freed individually; reset() releases everything at once while keeping
+ * the blocks for reuse, so a steady-state batch allocates nothing.
+ * Only trivially destructible data may live in the arena.
+ *
+ * Not thread-safe. Moving an arena keeps previously returned pointers valid.
+ */
+class Arena {
+public:
+    static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+    explicit Arena(size_t block_size = kDefaultBlockSize)
+        : block_size_(block_size) {}
+
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        if (!blocks_.empty()) {
+            if (void* p = bump(blocks_[current_], bytes, align)) {
+                return p;
+            }
+        }
+        return allocate_slow(bytes, align);
+    }
+
+    template<typename T>
+    T* allocate_array(size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Copy a NUL-terminated string; nullptr stays nullptr
+    char* copy_string(const char* src) {
+        if (src == nullptr) {
+            return nullptr;
+        }
+        size_t len = std::strlen(src) + 1;
+        char* dst = static_cast<char*>(allocate(len, 1));
+        std::memcpy(dst, src, len);
+        return dst;
+    }
+
+    // Release all allocations, keeping the blocks for reuse
+    void reset() noexcept {
+        for (auto& block : blocks_) {
+            block.used = 0;
+        }
+        current_ = 0;
+    }
+
+    size_t bytes_used() const noexcept {
+        size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.used;
+        }
+        return total;
+    }
+
+    size_t bytes_reserved() const noexcept {
+        size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    static void* bump(Block& block, size_t bytes, size_t align) noexcept {
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t aligned = (base + block.used + align - 1) & ~(uintptr_t{align} - 1);
+        size_t offset = aligned - base;
+        if (offset + bytes > block.size) {
+            return nullptr;
+        }
+        block.used = offset + bytes;
+        return block.data.get() + offset;
+    }
+
+    void* allocate_slow(size_t bytes, size_t align) {
+        // Reuse blocks retained by a previous reset() before growing
+        while (current_ + 1 < blocks_.size()) {
+            ++current_;
+            if (void* p = bump(blocks_[current_], bytes, align)) {
+                return p;
+            }
+        }
+
+        Block block;
+        block.size = bytes + align > block_size_ ? bytes + align : block_size_;
+        block.data = std::make_unique<std::byte[]>(block.size);
+        blocks_.push_back(std::move(block));
+        current_ = blocks_.size() - 1;
+        return bump(blocks_[current_], bytes, align);
+    }
+
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+};
+
+}  // namespace utils
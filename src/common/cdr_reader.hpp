@@ -0,0 +1,212 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file cdr_reader.hpp
+/// @brief Bounds-checked cursor over a serialized CDR sample
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace dds {
+
+/*
+ * Primitive sequence left in place in a CDR buffer.
+ *
+ * Elements are read on access with memcpy (the buffer need not be aligned
+ * for T) and byte-swapped if the stream's endianness differs from the host.
+ */
+template<typename T>
+class CdrArray {
+public:
+    CdrArray() = default;
+    CdrArray(const uint8_t* data, uint32_t count, bool swap)
+        : data_(data), count_(count), swap_(swap) {}
+
+    size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    T operator[](size_t i) const noexcept;
+
+    // Elements as they are in the stream, without byte-swapping; for
+    // octet sequences this is the payload itself
+    const uint8_t* raw() const noexcept { return data_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    uint32_t count_ = 0;
+    bool swap_ = false;
+};
+
+/*
+ * Forward-only reader for one serialized sample (as delivered by
+ * Reader::take_serialized), starting at the 4-byte encapsulation header.
+ *
+ * Supports plain XCDR1 (CDR_LE/CDR_BE) and plain XCDR2 (CDR2_LE/CDR2_BE),
+ * i.e. @final types. Alignment follows the encoding: XCDR1 aligns
+ * primitives to their size, XCDR2 caps alignment at 4 bytes.
+ *
+ * Errors are sticky: once a read runs past the buffer, or the encoding is
+ * unsupported, ok() turns false and every further read yields zero/empty.
+ * Decoders check ok() once at the end instead of after every field.
+ *
+ * Strings and arrays are returned as views into the buffer; nothing is
+ * allocated or copied.
+ */
+class CdrReader {
+public:
+    CdrReader(const uint8_t* data, size_t size) noexcept {
+        if (size < 4 || data[0] != 0x00) {
+            return;
+        }
+        switch (data[1]) {
+            case 0x00: swap_ = kHostLittle; break;                 // CDR_BE
+            case 0x01: swap_ = !kHostLittle; break;                // CDR_LE
+            case 0x06: swap_ = kHostLittle; max_align_ = 4; break;  // CDR2_BE
+            case 0x07: swap_ = !kHostLittle; max_align_ = 4; break; // CDR2_LE
+            default: return;  // parameter lists, delimited (appendable) types
+        }
+        origin_ = data + 4;
+        size_ = size - 4;
+        ok_ = true;
+    }
+
+    bool ok() const noexcept { return ok_; }
+    bool xcdr2() const noexcept { return max_align_ == 4; }
+    bool swapped() const noexcept { return swap_; }
+
+    // Bytes left after the cursor
+    size_t remaining() const noexcept { return ok_ ? size_ - pos_ : 0; }
+
+    // Primitive (integer, floating point, bool, enum) at its natural alignment
+    template<typename T>
+    T read() noexcept {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                      "CdrReader::read needs a primitive type");
+        T value{};
+        if (!align(sizeof(T)) || !has(sizeof(T))) {
+            return value;
+        }
+        std::memcpy(&value, origin_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return swap_ ? byteswap(value) : value;
+    }
+
+    // Enumerations are serialized as 32-bit integers
+    template<typename E>
+    E read_enum() noexcept {
+        return static_cast<E>(read<int32_t>());
+    }
+
+    // String as a view excluding the terminating NUL
+    std::string_view read_string() noexcept {
+        uint32_t len = read<uint32_t>();
+        if (len == 0 || !has(len)) {
+            return {};
+        }
+        const char* chars = reinterpret_cast<const char*>(origin_ + pos_);
+        pos_ += len;
+        return std::string_view(chars, len - 1);
+    }
+
+    // Sequence of primitives as an in-place view
+    template<typename T>
+    CdrArray<T> read_array() noexcept {
+        uint32_t count = read<uint32_t>();
+        if (count == 0 || !align(sizeof(T)) ||
+            count > remaining() / sizeof(T)) {
+            if (count != 0) {
+                ok_ = false;
+            }
+            return {};
+        }
+        CdrArray<T> array(origin_ + pos_, count, swap_);
+        pos_ += static_cast<size_t>(count) * sizeof(T);
+        return array;
+    }
+
+    // Sequence length prefix, for sequences of strings or structs. XCDR2
+    // puts a DHEADER (byte size) before the length of such sequences
+    uint32_t read_length() noexcept {
+        if (xcdr2()) {
+            read<uint32_t>();
+        }
+        return read<uint32_t>();
+    }
+
+    void skip_string() noexcept { read_string(); }
+
+private:
+    static constexpr bool kHostLittle = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+    bool has(size_t bytes) noexcept {
+        if (!ok_ || bytes > size_ - pos_) {
+            ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    bool align(size_t size) noexcept {
+        size_t a = size < max_align_ ? size : max_align_;
+        size_t aligned = (pos_ + a - 1) & ~(a - 1);
+        if (!ok_ || aligned > size_) {
+            ok_ = false;
+            return false;
+        }
+        pos_ = aligned;
+        return true;
+    }
+
+    template<typename T>
+    static T byteswap(T value) noexcept {
+        if constexpr (sizeof(T) == 1) {
+            return value;
+        } else {
+            using U = std::conditional_t<sizeof(T) == 2, uint16_t,
+                      std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+            U bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            if constexpr (sizeof(T) == 2) bits = __builtin_bswap16(bits);
+            if constexpr (sizeof(T) == 4) bits = __builtin_bswap32(bits);
+            if constexpr (sizeof(T) == 8) bits = __builtin_bswap64(bits);
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+    }
+
+    template<typename T>
+    friend class CdrArray;
+
+    const uint8_t* origin_ = nullptr;  // first byte after the encapsulation header
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    size_t max_align_ = 8;
+    bool swap_ = false;
+    bool ok_ = false;
+};
+
+template<typename T>
+T CdrArray<T>::operator[](size_t i) const noexcept {
+    T value;
+    std::memcpy(&value, data_ + i * sizeof(T), sizeof(T));
+    return swap_ ? CdrReader::byteswap(value) : value;
+}
+
+}  // namespace dds
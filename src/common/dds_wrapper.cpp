@@ -15,8 +15,12 @@
 
 #include "common/dds_wrapper.hpp"
 
+#include <dds/ddsi/ddsi_serdata.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
 #include <sstream>
 #include <utility>
 
@@ -99,6 +103,44 @@ Topic::Topic(const Participant& participant,
     LOG(INFO) << "Created DDS topic: " << name_;
 }
 
+void Topic::install_filter(std::unique_ptr<Filter> filter) {
+    if (filter_) {
+        throw Error(DDS_RETCODE_PRECONDITION_NOT_MET, "Topic filter already set");
+    }
+
+    dds_topic_filter spec{};
+    spec.mode = DDS_TOPIC_FILTER_SAMPLE_ARG;
+    spec.f.sample_arg = &Topic::apply_filter;
+    spec.arg = filter.get();
+
+    dds_return_t rc = dds_set_topic_filter_extended(entity_.get(), &spec);
+    if (rc != DDS_RETCODE_OK) {
+        throw Error(rc, "dds_set_topic_filter_extended");
+    }
+    filter_ = std::move(filter);
+}
+
+FilterStats Topic::filter_stats() const noexcept {
+    if (!filter_) {
+        return {};
+    }
+    return {filter_->accepted.load(std::memory_order_relaxed),
+            filter_->rejected.load(std::memory_order_relaxed)};
+}
+
+bool Topic::apply_filter(const void* sample, void* arg) {
+    auto* filter = static_cast<Filter*>(arg);
+    bool accept = true;
+    try {
+        accept = filter->accept(sample);
+    } catch (const std::exception& e) {
+        // Keep the sample rather than unwinding into the DDS receive thread
+        LOG(ERROR) << "Topic filter failed: " << e.what();
+    }
+    (accept ? filter->accepted : filter->rejected).fetch_add(1, std::memory_order_relaxed);
+    return accept;
+}
+
 // Writer implementation
 
 Writer::Writer(const Participant& participant,
@@ -109,6 +151,118 @@ Writer::Writer(const Participant& participant,
     LOG(INFO) << "Created DDS writer for topic: " << topic.name();
 }
 
+void Writer::flush() {
+    dds_return_t rc = dds_write_flush(entity_.get());
+    if (rc != DDS_RETCODE_OK) {
+        throw Error(rc, "dds_write_flush");
+    }
+}
+
+void* Writer::acquire_loan(size_t size, bool& from_dds) {
+    if (loan_outstanding_) {
+        throw Error(DDS_RETCODE_PRECONDITION_NOT_MET, "dds_request_loan");
+    }
+
+    void* sample = nullptr;
+    if (dds_is_loan_available(entity_.get())) {
+        dds_return_t rc = dds_request_loan(entity_.get(), &sample);
+        if (rc != DDS_RETCODE_OK) {
+            throw Error(rc, "dds_request_loan");
+        }
+        from_dds = true;
+    } else {
+        // Not loanable (types with strings/sequences, no shared memory):
+        // hand out the writer's scratch sample instead
+        size_t slots = (size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        if (scratch_.size() < slots) {
+            scratch_.resize(slots);
+        }
+        sample = scratch_.data();
+        from_dds = false;
+    }
+
+    std::memset(sample, 0, size);
+    loan_outstanding_ = true;
+    return sample;
+}
+
+WriterStats Writer::stats() const noexcept {
+    WriterStats stats;
+    stats.written = counters_->written.load(std::memory_order_relaxed);
+    stats.timeouts = counters_->timeouts.load(std::memory_order_relaxed);
+    stats.dropped = counters_->dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+dds_return_t Writer::commit_loan(void* sample, bool from_dds) noexcept {
+    loan_outstanding_ = false;
+
+    dds_return_t rc = account(dds_write(entity_.get(), sample));
+    if (rc != DDS_RETCODE_OK && from_dds) {
+        // A failed write leaves the loan with us
+        dds_return_loan(entity_.get(), &sample, 1);
+    }
+    return rc;
+}
+
+void Writer::release_loan(void* sample, bool from_dds) noexcept {
+    loan_outstanding_ = false;
+    if (from_dds) {
+        dds_return_t rc = dds_return_loan(entity_.get(), &sample, 1);
+        if (rc != DDS_RETCODE_OK) {
+            LOG(WARNING) << "Failed to return DDS writer loan: " << dds_strretcode(rc);
+        }
+    }
+}
+
+// WriteBatch implementation
+
+namespace {
+
+// Batch mode is a process-wide switch; count the scopes that want it on
+std::mutex g_batch_mutex;
+size_t g_batch_scopes = 0;
+
+}  // namespace
+
+WriteBatch::WriteBatch(std::initializer_list<const Writer*> writers) {
+    for (const Writer* writer : writers) {
+        track(*writer);
+    }
+
+    std::lock_guard<std::mutex> lock(g_batch_mutex);
+    if (g_batch_scopes++ == 0) {
+        dds_write_set_batch(true);
+    }
+}
+
+WriteBatch::~WriteBatch() {
+    for (dds_entity_t writer : writers_) {
+        dds_return_t rc = dds_write_flush(writer);
+        if (rc != DDS_RETCODE_OK) {
+            LOG(WARNING) << "Failed to flush batched writes: " << dds_strretcode(rc);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(g_batch_mutex);
+    if (--g_batch_scopes == 0) {
+        dds_write_set_batch(false);
+    }
+}
+
+void WriteBatch::track(const Writer& writer) {
+    writers_.push_back(writer.get());
+}
+
+void WriteBatch::flush() {
+    for (dds_entity_t writer : writers_) {
+        dds_return_t rc = dds_write_flush(writer);
+        if (rc != DDS_RETCODE_OK) {
+            throw Error(rc, "dds_write_flush");
+        }
+    }
+}
+
 // Reader implementation
 
 Reader::Reader(const Participant& participant,
@@ -142,6 +296,185 @@ bool Reader::wait(int32_t timeout_ms) {
     return rc > 0;  // Returns number of triggered conditions
 }
 
+void Reader::set_listener(const dds_listener_t* listener) {
+    dds_return_t rc = dds_set_listener(entity_.get(), listener);
+    if (rc != DDS_RETCODE_OK) {
+        throw Error(rc, "dds_set_listener");
+    }
+}
+
+void Reader::return_loan(void** samples, size_t count) noexcept {
+    if (count > 0) {
+        dds_return_t rc = dds_return_loan(entity_.get(), samples,
+                                          static_cast<int32_t>(count));
+        if (rc != DDS_RETCODE_OK) {
+            LOG(WARNING) << "Failed to return DDS loan: " << dds_strretcode(rc);
+        }
+    }
+    loan_outstanding_->store(false, std::memory_order_release);
+}
+
+size_t Reader::take_serialized_impl(SerializedFn fn, void* context, size_t max_samples,
+                                    size_t* taken) {
+    // DDS rejects a zero-sized take as BAD_PARAMETER
+    if (max_samples == 0) {
+        if (taken != nullptr) {
+            *taken = 0;
+        }
+        return 0;
+    }
+
+    // Holds loan_infos_ for the whole call
+    if (loan_outstanding_->exchange(true, std::memory_order_acquire)) {
+        throw Error(DDS_RETCODE_PRECONDITION_NOT_MET, "dds_takecdr");
+    }
+    struct Claim {
+        std::atomic<bool>& flag;
+        ~Claim() { flag.store(false, std::memory_order_release); }
+    } claim{*loan_outstanding_};
+    if (serdata_.size() < max_samples) {
+        serdata_.resize(max_samples);
+    }
+    if (loan_infos_.size() < max_samples) {
+        loan_infos_.resize(max_samples);
+    }
+
+    dds_return_t count = dds_takecdr(entity_.get(), serdata_.data(),
+                                     static_cast<uint32_t>(max_samples),
+                                     loan_infos_.data(), DDS_ANY_STATE);
+    if (count < 0) {
+        throw Error(count, "dds_takecdr");
+    }
+    if (taken != nullptr) {
+        *taken = static_cast<size_t>(count);
+    }
+
+    // Drop our references even if the callback throws
+    struct Release {
+        ddsi_serdata** serdata;
+        int32_t count;
+        ~Release() {
+            for (int32_t i = 0; i < count; ++i) {
+                ddsi_serdata_unref(serdata[i]);
+            }
+        }
+    } release{serdata_.data(), count};
+
+    size_t valid_count = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        if (!loan_infos_[i].valid_data) {
+            continue;
+        }
+
+        ddsi_serdata* sd = serdata_[i];
+        ddsrt_iovec_t ref;
+        ddsi_serdata* held = ddsi_serdata_to_ser_ref(sd, 0, ddsi_serdata_size(sd), &ref);
+
+        struct Unref {
+            ddsi_serdata* held;
+            ddsrt_iovec_t& ref;
+            ~Unref() { ddsi_serdata_to_ser_unref(held, &ref); }
+        } unref{held, ref};
+
+        fn(context, SerializedSample{static_cast<const uint8_t*>(ref.iov_base),
+                                     static_cast<size_t>(ref.iov_len), loan_infos_[i]});
+        ++valid_count;
+    }
+
+    return valid_count;
+}
+
+// ReadCondition implementation
+
+ReadCondition::ReadCondition(const Reader& reader, uint32_t mask)
+    : entity_(dds_create_readcondition(reader.get(), mask)) {}
+
+bool ReadCondition::triggered() const {
+    dds_return_t rc = dds_triggered(entity_.get());
+    if (rc < 0) {
+        throw Error(rc, "dds_triggered");
+    }
+    return rc > 0;
+}
+
+// WaitSet implementation
+
+namespace {
+// Token of the internal guard condition; never reported to callers
+constexpr dds_attach_t kWakeToken = -1;
+}  // namespace
+
+WaitSet::WaitSet(const Participant& participant)
+    : entity_(dds_create_waitset(participant.get())),
+      guard_(dds_create_guardcondition(participant.get())) {
+    attach(guard_.get(), kWakeToken);
+}
+
+void WaitSet::attach(dds_entity_t entity, dds_attach_t token) {
+    dds_return_t rc = dds_waitset_attach(entity_.get(), entity, token);
+    if (rc != DDS_RETCODE_OK) {
+        throw Error(rc, "dds_waitset_attach");
+    }
+}
+
+void WaitSet::detach(dds_entity_t entity) {
+    dds_return_t rc = dds_waitset_detach(entity_.get(), entity);
+    if (rc != DDS_RETCODE_OK) {
+        throw Error(rc, "dds_waitset_detach");
+    }
+}
+
+size_t WaitSet::wait(dds_attach_t* triggered, size_t capacity, dds_duration_t timeout) {
+    dds_return_t rc = dds_waitset_wait(entity_.get(), triggered, capacity, timeout);
+    if (rc < 0) {
+        throw Error(rc, "dds_waitset_wait");
+    }
+
+    // Drop the wake-up token and re-arm the guard condition
+    size_t count = 0;
+    size_t reported = std::min(static_cast<size_t>(rc), capacity);
+    for (size_t i = 0; i < reported; ++i) {
+        if (triggered[i] == kWakeToken) {
+            dds_set_guardcondition(guard_.get(), false);
+        } else {
+            triggered[count++] = triggered[i];
+        }
+    }
+    return count;
+}
+
+void WaitSet::wake() {
+    dds_return_t rc = dds_set_guardcondition(guard_.get(), true);
+    if (rc != DDS_RETCODE_OK) {
+        throw Error(rc, "dds_set_guardcondition");
+    }
+}
+
+// Listener implementation
+
+Listener::Listener(DataAvailableFn on_data_available)
+    : on_data_available_(std::move(on_data_available)),
+      listener_(dds_create_listener(this)) {
+    if (listener_ == nullptr) {
+        throw std::runtime_error("Failed to create listener");
+    }
+    dds_lset_data_available(listener_, &Listener::data_available);
+}
+
+Listener::~Listener() {
+    dds_delete_listener(listener_);
+}
+
+void Listener::data_available(dds_entity_t reader, void* arg) {
+    auto* self = static_cast<Listener*>(arg);
+    try {
+        self->on_data_available_(reader);
+    } catch (const std::exception& e) {
+        // Never let an exception unwind into the DDS receive thread
+        LOG(ERROR) << "Listener callback failed: " << e.what();
+    }
+}
+
 // Qos implementation
 
 Qos::Qos() : qos_(dds_create_qos()) {
@@ -201,4 +534,34 @@ Qos& Qos::history_keep_all() {
     return *this;
 }
 
+Qos& Qos::resource_limits(int32_t max_samples, int32_t max_instances,
+                          int32_t max_samples_per_instance) {
+    dds_qset_resource_limits(qos_, max_samples, max_instances, max_samples_per_instance);
+    return *this;
+}
+
+Qos& Qos::max_blocking_time(dds_duration_t budget) {
+    dds_reliability_kind_t kind = DDS_RELIABILITY_BEST_EFFORT;
+    dds_duration_t current = 0;
+    if (dds_qget_reliability(qos_, &kind, &current) && kind == DDS_RELIABILITY_RELIABLE) {
+        dds_qset_reliability(qos_, kind, budget);
+    }
+    return *this;
+}
+
+Qos& Qos::time_based_filter(dds_duration_t min_separation) {
+    dds_qset_time_based_filter(qos_, min_separation);
+    return *this;
+}
+
+Qos& Qos::deadline(dds_duration_t period) {
+    dds_qset_deadline(qos_, period);
+    return *this;
+}
+
+Qos& Qos::latency_budget(dds_duration_t duration) {
+    dds_qset_latency_budget(qos_, duration);
+    return *this;
+}
+
 }  // namespace dds
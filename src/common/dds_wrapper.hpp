@@ -23,12 +23,18 @@
 
 #include <dds/dds.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace dds {
@@ -93,6 +99,14 @@ private:
     Entity entity_;
 };
 
+/*
+ * Content filter outcome counters for a topic.
+ */
+struct FilterStats {
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;
+};
+
 /*
  * DDS Topic.
  */
@@ -108,7 +122,40 @@ public:
     const std::string& name() const noexcept { return name_; }
     explicit operator bool() const noexcept { return entity_.valid(); }
 
+    /*
+     * Install a content filter on every reader of this topic entity.
+     *
+     * Cyclone evaluates the predicate on the receive thread right after
+     * deserialization; rejected samples never enter the reader cache, so
+     * they cost no waitset wakeup, take or callback. The predicate must be
+     * cheap and thread-safe. Only one filter may be set per topic, before
+     * data starts flowing.
+     */
+    template<typename T, typename Predicate>
+    void set_filter(Predicate predicate) {
+        install_filter(std::make_unique<Filter>(
+            [predicate = std::move(predicate)](const void* sample) {
+                return predicate(*static_cast<const T*>(sample));
+            }));
+    }
+
+    // Zeroes if no filter is installed
+    FilterStats filter_stats() const noexcept;
+
 private:
+    struct Filter {
+        explicit Filter(std::function<bool(const void*)> fn) : accept(std::move(fn)) {}
+
+        std::function<bool(const void*)> accept;
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> rejected{0};
+    };
+
+    void install_filter(std::unique_ptr<Filter> filter);
+    static bool apply_filter(const void* sample, void* arg);
+
+    // Declared before entity_ so it outlives the topic entity using it
+    std::unique_ptr<Filter> filter_;
     Entity entity_;
     std::string name_;
 };
@@ -116,6 +163,18 @@ private:
 /*
  * DDS DataWriter.
  */
+template<typename T>
+class WriterLoan;
+
+/*
+ * Per-writer outcome counters, updated by every write path.
+ */
+struct WriterStats {
+    uint64_t written = 0;
+    uint64_t timeouts = 0;  // Blocked for max_blocking_time on a full history
+    uint64_t dropped = 0;   // Any other failed write
+};
+
 class Writer {
 public:
     Writer(const Participant& participant,
@@ -134,8 +193,235 @@ public:
     template<typename T>
     void write(const T& sample, dds_time_t timestamp);
 
+    // Write without throwing; returns the DDS return code.
+    // A reliable writer blocks for at most the QoS max_blocking_time when
+    // the history is full (see Qos::max_blocking_time), then returns
+    // DDS_RETCODE_TIMEOUT. Failures are counted in stats().
+    template<typename T>
+    dds_return_t try_write(const T& sample) noexcept;
+
+    WriterStats stats() const noexcept;
+
+    // Push out samples queued by write batching (see WriteBatch)
+    void flush();
+
+    // Borrow a zero-initialized sample to fill in place, then commit() it.
+    // Comes straight from the transport when Cyclone can loan for this
+    // writer (fixed-size types on a shared-memory configuration); otherwise
+    // it is a scratch sample owned by the writer and reused on every loan.
+    // One loan may be outstanding per writer at a time.
+    template<typename T>
+    WriterLoan<T> loan();
+
 private:
+    template<typename T>
+    friend class WriterLoan;
+
+    void* acquire_loan(size_t size, bool& from_dds);
+    dds_return_t commit_loan(void* sample, bool from_dds) noexcept;
+    void release_loan(void* sample, bool from_dds) noexcept;
+
+    dds_return_t account(dds_return_t rc) noexcept;
+
+    struct Counters {
+        std::atomic<uint64_t> written{0};
+        std::atomic<uint64_t> timeouts{0};
+        std::atomic<uint64_t> dropped{0};
+    };
+
     Entity entity_;
+    std::unique_ptr<Counters> counters_ = std::make_unique<Counters>();
+
+    // Fallback sample storage when DDS cannot loan
+    std::vector<std::max_align_t> scratch_;
+    bool loan_outstanding_ = false;
+};
+
+/*
+ * Scoped write batching.
+ *
+ * While a WriteBatch is alive, dds_write() queues samples instead of
+ * sending each one immediately, so back-to-back small samples share RTPS
+ * packets. Queued data goes out when a packet fills, on flush(), and when
+ * the batch is destroyed.
+ *
+ * Cyclone's batch mode is process-wide: it affects every writer, not only
+ * the tracked ones, and stays on until the last WriteBatch is gone.
+ * Writers that must never wait should not be used while one is alive.
+ * Tracked writers must outlive the batch.
+ */
+class WriteBatch {
+public:
+    explicit WriteBatch(std::initializer_list<const Writer*> writers = {});
+    ~WriteBatch();
+
+    WriteBatch(const WriteBatch&) = delete;
+    WriteBatch& operator=(const WriteBatch&) = delete;
+
+    // Include another writer in flush()
+    void track(const Writer& writer);
+
+    // Send everything queued on the tracked writers
+    void flush();
+
+private:
+    std::vector<dds_entity_t> writers_;
+};
+
+/*
+ * Sample borrowed from a Writer.
+ *
+ * Fill it through operator-> / operator*, then commit() to publish.
+ * Dropping an uncommitted loan returns it without writing anything.
+ * Pointers stored in the sample (strings, sequence buffers) are only read
+ * during commit() and remain owned by the caller.
+ */
+template<typename T>
+class WriterLoan {
+public:
+    ~WriterLoan() {
+        if (writer_ != nullptr) {
+            writer_->release_loan(sample_, from_dds_);
+        }
+    }
+
+    WriterLoan(WriterLoan&& other) noexcept
+        : writer_(other.writer_), sample_(other.sample_), from_dds_(other.from_dds_) {
+        other.writer_ = nullptr;
+    }
+
+    WriterLoan(const WriterLoan&) = delete;
+    WriterLoan& operator=(const WriterLoan&) = delete;
+    WriterLoan& operator=(WriterLoan&&) = delete;
+
+    T& operator*() const noexcept { return *sample_; }
+    T* operator->() const noexcept { return sample_; }
+    T* get() const noexcept { return sample_; }
+
+    // True if the sample lives in transport memory (zero-copy write)
+    bool zero_copy() const noexcept { return from_dds_; }
+
+    // Publish the sample; the loan is consumed even if the write fails
+    void commit() {
+        dds_return_t rc = try_commit();
+        if (rc != DDS_RETCODE_OK) {
+            throw Error(rc, "dds_write");
+        }
+    }
+
+    // As commit(), but returns the DDS return code instead of throwing.
+    // PRECONDITION_NOT_MET once the loan is consumed or moved from.
+    dds_return_t try_commit() noexcept {
+        if (writer_ == nullptr) {
+            return DDS_RETCODE_PRECONDITION_NOT_MET;
+        }
+        Writer* writer = writer_;
+        writer_ = nullptr;
+        return writer->commit_loan(sample_, from_dds_);
+    }
+
+private:
+    friend class Writer;
+
+    WriterLoan(Writer* writer, T* sample, bool from_dds)
+        : writer_(writer), sample_(sample), from_dds_(from_dds) {}
+
+    Writer* writer_;
+    T* sample_;
+    bool from_dds_;
+};
+
+class Reader;
+
+/*
+ * One loaned sample: the data together with its sample info.
+ *
+ * Invalid samples (dispose/unregister notifications) carry no data;
+ * check valid() before touching data.
+ */
+template<typename T>
+struct SampleRef {
+    const T& data;
+    const dds_sample_info_t& info;
+
+    bool valid() const noexcept { return info.valid_data; }
+};
+
+/*
+ * RAII range over samples loaned from a reader.
+ *
+ * Holds the DDS loan until destruction (or release()), so string and
+ * sequence members stay valid for the lifetime of the range. The loan
+ * arrays belong to the reader and are reused across calls: only one
+ * LoanedSamples per reader may be alive at a time.
+ */
+template<typename T>
+class LoanedSamples {
+public:
+    class iterator {
+    public:
+        iterator(void* const* samples, const dds_sample_info_t* infos)
+            : samples_(samples), infos_(infos) {}
+
+        SampleRef<T> operator*() const {
+            return {*static_cast<const T*>(*samples_), *infos_};
+        }
+        iterator& operator++() {
+            ++samples_;
+            ++infos_;
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return samples_ != other.samples_; }
+
+    private:
+        void* const* samples_;
+        const dds_sample_info_t* infos_;
+    };
+
+    LoanedSamples() = default;
+    ~LoanedSamples() { release(); }
+
+    LoanedSamples(LoanedSamples&& other) noexcept;
+    LoanedSamples& operator=(LoanedSamples&& other) noexcept;
+
+    LoanedSamples(const LoanedSamples&) = delete;
+    LoanedSamples& operator=(const LoanedSamples&) = delete;
+
+    iterator begin() const { return {samples_, infos_}; }
+    iterator end() const { return {samples_ + count_, infos_ + count_}; }
+
+    size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    SampleRef<T> operator[](size_t i) const {
+        return {*static_cast<const T*>(samples_[i]), infos_[i]};
+    }
+
+    // Return the loan to DDS early
+    void release() noexcept;
+
+private:
+    friend class Reader;
+
+    LoanedSamples(Reader* reader, void** samples, dds_sample_info_t* infos, size_t count)
+        : reader_(reader), samples_(samples), infos_(infos), count_(count) {}
+
+    Reader* reader_ = nullptr;
+    void** samples_ = nullptr;
+    dds_sample_info_t* infos_ = nullptr;
+    size_t count_ = 0;
+};
+
+/*
+ * A sample in serialized form: the CDR stream exactly as received,
+ * starting with its 4-byte encapsulation header.
+ *
+ * Only valid for the duration of the take_serialized() callback.
+ */
+struct SerializedSample {
+    const uint8_t* data;
+    size_t size;
+    const dds_sample_info_t& info;
 };
 
 /*
@@ -151,27 +437,170 @@ public:
     dds_entity_t get() const noexcept { return entity_.get(); }
     explicit operator bool() const noexcept { return entity_.valid(); }
 
+    // Take samples as a zero-copy loan (removes from reader cache).
+    // No heap allocation once the loan arrays have grown to max_samples.
+    template<typename T>
+    LoanedSamples<T> take_loan(size_t max_samples = 100);
+
+    // Read samples as a zero-copy loan (leaves in reader cache)
+    template<typename T>
+    LoanedSamples<T> read_loan(size_t max_samples = 100);
+
     // Take samples (removes from reader cache)
-    // WARNING: Returned samples contain pointers to DDS-managed memory.
-    // Process immediately before any other DDS operations.
+    // WARNING: Returned samples are shallow copies; their string and
+    // sequence pointers dangle once this call returns. Prefer take_loan().
     template<typename T>
     std::vector<T> take(size_t max_samples = 100);
 
     // Take and process each sample with a callback (recommended)
     // Callback is invoked while DDS loan is still valid - safe for string access
+    // Returns the valid samples; `taken` gets every sample taken, including
+    // dispose/unregister notifications.
     template<typename T, typename Callback>
-    size_t take_each(Callback&& callback, size_t max_samples = 100);
+    size_t take_each(Callback&& callback, size_t max_samples = 100, size_t* taken = nullptr);
 
     // Read samples (leaves in reader cache)
+    // WARNING: Same dangling-pointer caveat as take(). Prefer read_loan().
     template<typename T>
     std::vector<T> read(size_t max_samples = 100);
 
+    // Take samples without deserializing them (dds_takecdr).
+    // Callback receives a SerializedSample per valid sample; the bytes are
+    // referenced in place and released when the callback returns.
+    // Returns the valid samples; `taken` gets every sample taken, including
+    // dispose/unregister notifications.
+    template<typename Callback>
+    size_t take_serialized(Callback&& callback, size_t max_samples = 100,
+                           size_t* taken = nullptr);
+
     // Wait for data with timeout (milliseconds)
     bool wait(int32_t timeout_ms);
 
+    // Replace the reader's listener; nullptr removes it. Returns only once
+    // callbacks already running on DDS threads have finished.
+    void set_listener(const dds_listener_t* listener);
+
 private:
+    template<typename T>
+    friend class LoanedSamples;
+
+    using ReadFn = dds_return_t (*)(dds_entity_t, void**, dds_sample_info_t*,
+                                    size_t, uint32_t);
+
+    template<typename T>
+    LoanedSamples<T> loan(ReadFn fn, const char* context, size_t max_samples);
+
+    void return_loan(void** samples, size_t count) noexcept;
+
+    // take_serialized() without the callback's type, in the .cpp, which
+    // keeps DDSI headers out of this one
+    using SerializedFn = void (*)(void* context, const SerializedSample& sample);
+    size_t take_serialized_impl(SerializedFn fn, void* context, size_t max_samples,
+                                size_t* taken);
+
     Entity entity_;
     Entity waitset_;
+
+    // Loan arrays reused across take/read calls. Set from the start of a
+    // take until its loan is returned; atomic because listener callbacks
+    // take on DDS threads while teardown runs elsewhere, and held by pointer
+    // so the Reader stays movable. A take that finds it set fails instead of
+    // sharing the arrays.
+    std::vector<void*> loan_samples_;
+    std::vector<dds_sample_info_t> loan_infos_;
+    std::unique_ptr<std::atomic<bool>> loan_outstanding_ =
+        std::make_unique<std::atomic<bool>>(false);
+
+    // Serdata array reused across take_serialized calls; opaque here
+    std::vector<struct ddsi_serdata*> serdata_;
+};
+
+/*
+ * DDS ReadCondition - triggered while the reader holds matching samples.
+ *
+ * Unlike the DATA_AVAILABLE status, a read condition stays triggered until
+ * the matching samples are taken, so samples left behind by a partial take
+ * are never missed.
+ *
+ * Must be destroyed before the reader it was created from.
+ */
+class ReadCondition {
+public:
+    explicit ReadCondition(const Reader& reader, uint32_t mask = DDS_ANY_STATE);
+
+    dds_entity_t get() const noexcept { return entity_.get(); }
+    explicit operator bool() const noexcept { return entity_.valid(); }
+
+    // Non-blocking check whether matching samples are present
+    bool triggered() const;
+
+private:
+    Entity entity_;
+};
+
+/*
+ * DDS WaitSet - blocks a thread until any attached condition triggers.
+ *
+ * One waitset multiplexes any number of readers or read conditions, so a
+ * single thread can sleep until data arrives on any of them. Each attached
+ * entity carries a caller-chosen token that wait() reports back.
+ */
+class WaitSet {
+public:
+    explicit WaitSet(const Participant& participant);
+
+    dds_entity_t get() const noexcept { return entity_.get(); }
+    explicit operator bool() const noexcept { return entity_.valid(); }
+
+    // Attach an entity (reader, condition) reported as `token` when triggered
+    void attach(dds_entity_t entity, dds_attach_t token);
+    void attach(const ReadCondition& condition, dds_attach_t token) {
+        attach(condition.get(), token);
+    }
+
+    void detach(dds_entity_t entity);
+
+    // Block until at least one attached entity triggers, wake() is called
+    // or the timeout expires. Writes up to `capacity` tokens of triggered
+    // entities to `triggered` and returns how many were written (0 on
+    // timeout or wake-up).
+    size_t wait(dds_attach_t* triggered, size_t capacity, dds_duration_t timeout);
+
+    // Unblock a concurrent wait() from another thread
+    void wake();
+
+private:
+    Entity entity_;
+    Entity guard_;
+};
+
+/*
+ * RAII wrapper for a DDS listener with a data-available callback.
+ *
+ * The callback runs on a Cyclone receive thread as soon as a sample is
+ * stored in the reader: lowest latency, but it delays further receive
+ * processing for as long as it runs, so keep it short and non-blocking.
+ *
+ * Install with Reader::set_listener(); the listener must outlive every
+ * entity it is installed on.
+ */
+class Listener {
+public:
+    using DataAvailableFn = std::function<void(dds_entity_t reader)>;
+
+    explicit Listener(DataAvailableFn on_data_available);
+    ~Listener();
+
+    Listener(const Listener&) = delete;
+    Listener& operator=(const Listener&) = delete;
+
+    const dds_listener_t* get() const noexcept { return listener_; }
+
+private:
+    static void data_available(dds_entity_t reader, void* arg);
+
+    DataAvailableFn on_data_available_;
+    dds_listener_t* listener_;
 };
 
 /*
@@ -199,6 +628,29 @@ public:
     Qos& history_keep_last(int32_t depth);
     Qos& history_keep_all();
 
+    // Bound the reader/writer cache; DDS_LENGTH_UNLIMITED for no limit
+    Qos& resource_limits(int32_t max_samples,
+                         int32_t max_instances = DDS_LENGTH_UNLIMITED,
+                         int32_t max_samples_per_instance = DDS_LENGTH_UNLIMITED);
+
+    // Bound how long a reliable writer may block on a full history.
+    // Keeps the reliability kind; no effect on best-effort writers.
+    Qos& max_blocking_time(dds_duration_t budget);
+
+    // Reader: deliver at most one sample per instance every min_separation.
+    // Not request/offered matched, so safe to set on any reader.
+    Qos& time_based_filter(dds_duration_t min_separation);
+
+    // Expected maximum gap between samples of an instance. Request/offered
+    // matched: a reader's deadline must be >= the writers' or they never
+    // match, so only set it where the publishers offer one.
+    Qos& deadline(dds_duration_t period);
+
+    // Acceptable delivery delay, a hint that lets the middleware batch.
+    // Request/offered matched like deadline, but writers default to 0,
+    // which any reader budget accepts.
+    Qos& latency_budget(dds_duration_t duration);
+
 private:
     dds_qos_t* qos_;
 };
@@ -207,7 +659,7 @@ private:
 
 template<typename T>
 void Writer::write(const T& sample) {
-    dds_return_t rc = dds_write(entity_.get(), &sample);
+    dds_return_t rc = try_write(sample);
     if (rc != DDS_RETCODE_OK) {
         throw Error(rc, "dds_write");
     }
@@ -215,90 +667,172 @@ void Writer::write(const T& sample) {
 
 template<typename T>
 void Writer::write(const T& sample, dds_time_t timestamp) {
-    dds_return_t rc = dds_write_ts(entity_.get(), &sample, timestamp);
+    dds_return_t rc = account(dds_write_ts(entity_.get(), &sample, timestamp));
     if (rc != DDS_RETCODE_OK) {
         throw Error(rc, "dds_write_ts");
     }
 }
 
 template<typename T>
-std::vector<T> Reader::take(size_t max_samples) {
-    std::vector<T> results;
-    results.reserve(max_samples);
+dds_return_t Writer::try_write(const T& sample) noexcept {
+    return account(dds_write(entity_.get(), &sample));
+}
+
+inline dds_return_t Writer::account(dds_return_t rc) noexcept {
+    if (rc == DDS_RETCODE_OK) {
+        counters_->written.fetch_add(1, std::memory_order_relaxed);
+    } else if (rc == DDS_RETCODE_TIMEOUT) {
+        counters_->timeouts.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        counters_->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return rc;
+}
 
-    std::vector<void*> samples(max_samples, nullptr);
-    std::vector<dds_sample_info_t> infos(max_samples);
+template<typename T>
+WriterLoan<T> Writer::loan() {
+    static_assert(std::is_trivially_copyable_v<T>, "Writer::loan needs an IDL-generated C type");
+    bool from_dds = false;
+    void* sample = acquire_loan(sizeof(T), from_dds);
+    return WriterLoan<T>(this, static_cast<T*>(sample), from_dds);
+}
 
-    dds_return_t count = dds_take(entity_.get(), samples.data(), infos.data(),
-                                   max_samples, max_samples);
+template<typename T>
+LoanedSamples<T>::LoanedSamples(LoanedSamples&& other) noexcept
+    : reader_(other.reader_), samples_(other.samples_),
+      infos_(other.infos_), count_(other.count_) {
+    other.reader_ = nullptr;
+    other.count_ = 0;
+}
 
-    if (count < 0) {
-        throw Error(count, "dds_take");
+template<typename T>
+LoanedSamples<T>& LoanedSamples<T>::operator=(LoanedSamples&& other) noexcept {
+    if (this != &other) {
+        release();
+        reader_ = other.reader_;
+        samples_ = other.samples_;
+        infos_ = other.infos_;
+        count_ = other.count_;
+        other.reader_ = nullptr;
+        other.count_ = 0;
     }
+    return *this;
+}
 
-    for (int32_t i = 0; i < count; ++i) {
-        if (infos[i].valid_data && samples[i] != nullptr) {
-            results.push_back(*static_cast<T*>(samples[i]));
+template<typename T>
+void LoanedSamples<T>::release() noexcept {
+    if (reader_ != nullptr) {
+        reader_->return_loan(samples_, count_);
+        reader_ = nullptr;
+        count_ = 0;
+    }
+}
+
+template<typename T>
+LoanedSamples<T> Reader::loan(ReadFn fn, const char* context, size_t max_samples) {
+    // DDS rejects a zero-sized take as BAD_PARAMETER
+    if (max_samples == 0) {
+        return LoanedSamples<T>();
+    }
+    if (loan_outstanding_->exchange(true, std::memory_order_acquire)) {
+        throw Error(DDS_RETCODE_PRECONDITION_NOT_MET, context);
+    }
+    // Until the LoanedSamples owns it, give the claim back on any throw
+    struct Claim {
+        std::atomic<bool>* flag;
+        ~Claim() {
+            if (flag) flag->store(false, std::memory_order_release);
         }
+    } claim{loan_outstanding_.get()};
+
+    // Grow once, then reuse: no allocation in steady state
+    if (loan_samples_.size() < max_samples) {
+        loan_samples_.resize(max_samples);
+        loan_infos_.resize(max_samples);
     }
 
-    // Return loan before returning - samples are shallow copies
-    // Caller must be aware string pointers are only valid until next DDS operation
-    dds_return_loan(entity_.get(), samples.data(), count);
+    // A null first entry asks DDS to loan its own sample buffer
+    loan_samples_[0] = nullptr;
 
-    return results;
+    dds_return_t count = fn(entity_.get(), loan_samples_.data(), loan_infos_.data(),
+                            max_samples, static_cast<uint32_t>(max_samples));
+    if (count < 0) {
+        throw Error(count, context);
+    }
+
+    claim.flag = nullptr;
+    return LoanedSamples<T>(this, loan_samples_.data(), loan_infos_.data(),
+                            static_cast<size_t>(count));
 }
 
-template<typename T, typename Callback>
-size_t Reader::take_each(Callback&& callback, size_t max_samples) {
-    std::vector<void*> samples(max_samples, nullptr);
-    std::vector<dds_sample_info_t> infos(max_samples);
+template<typename T>
+LoanedSamples<T> Reader::take_loan(size_t max_samples) {
+    return loan<T>(&dds_take, "dds_take", max_samples);
+}
 
-    dds_return_t count = dds_take(entity_.get(), samples.data(), infos.data(),
-                                   max_samples, max_samples);
+template<typename T>
+LoanedSamples<T> Reader::read_loan(size_t max_samples) {
+    return loan<T>(&dds_read, "dds_read", max_samples);
+}
 
-    if (count < 0) {
-        throw Error(count, "dds_take");
+template<typename T>
+std::vector<T> Reader::take(size_t max_samples) {
+    std::vector<T> results;
+    results.reserve(max_samples);
+
+    // Samples are shallow copies - caller must be aware string pointers
+    // are only valid until the loan is returned below
+    for (auto sample : take_loan<T>(max_samples)) {
+        if (sample.valid()) {
+            results.push_back(sample.data);
+        }
     }
 
+    return results;
+}
+
+template<typename T, typename Callback>
+size_t Reader::take_each(Callback&& callback, size_t max_samples, size_t* taken) {
+    auto samples = take_loan<T>(max_samples);
+    if (taken) {
+        *taken = samples.size();
+    }
+
+    // Callback runs while the loan is held; it is returned on scope exit
     size_t valid_count = 0;
-    for (int32_t i = 0; i < count; ++i) {
-        if (infos[i].valid_data && samples[i] != nullptr) {
-            callback(*static_cast<T*>(samples[i]));
+    for (auto sample : samples) {
+        if (sample.valid()) {
+            callback(sample.data);
             ++valid_count;
         }
     }
 
-    // Return loan after callback processing
-    dds_return_loan(entity_.get(), samples.data(), count);
-
     return valid_count;
 }
 
+template<typename Callback>
+size_t Reader::take_serialized(Callback&& callback, size_t max_samples, size_t* taken) {
+    using Fn = std::remove_reference_t<Callback>;
+    return take_serialized_impl(
+        [](void* context, const SerializedSample& sample) {
+            (*static_cast<Fn*>(context))(sample);
+        },
+        const_cast<void*>(static_cast<const void*>(std::addressof(callback))), max_samples,
+        taken);
+}
+
 template<typename T>
 std::vector<T> Reader::read(size_t max_samples) {
     std::vector<T> results;
     results.reserve(max_samples);
 
-    std::vector<void*> samples(max_samples, nullptr);
-    std::vector<dds_sample_info_t> infos(max_samples);
-
-    dds_return_t count = dds_read(entity_.get(), samples.data(), infos.data(),
-                                   max_samples, max_samples);
-
-    if (count < 0) {
-        throw Error(count, "dds_read");
-    }
-
-    for (int32_t i = 0; i < count; ++i) {
-        if (infos[i].valid_data && samples[i] != nullptr) {
-            results.push_back(*static_cast<T*>(samples[i]));
+    // Samples are shallow copies, see take()
+    for (auto sample : read_loan<T>(max_samples)) {
+        if (sample.valid()) {
+            results.push_back(sample.data);
         }
     }
 
-    // Return loan - samples are shallow copies
-    dds_return_loan(entity_.get(), samples.data(), count);
-
     return results;
 }
 
@@ -0,0 +1,199 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file mpsc_ring.hpp
+/// @brief Bounded lock-free multi-producer/single-consumer ring
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace utils {
+
+/*
+ * Bounded multi-producer/single-consumer ring of preallocated slots.
+ *
+ * Each slot carries a sequence number (Vyukov's bounded queue): a producer
+ * claims a slot with one CAS on the shared head, fills it in place and
+ * publishes it by bumping its sequence; the consumer reads slots in order
+ * and hands them back the same way. Slots are constructed once and reused,
+ * so a T holding buffers (strings with reserved capacity, arrays) is
+ * refilled without touching the allocator. Head, tail and every slot sit
+ * on their own cache lines.
+ *
+ * A full ring refuses new items (try_push() returns false); producers
+ * never wait. A slot whose fill throws is still published, marked empty,
+ * and the consumer steps over it, so one failed push cannot stall the
+ * ring. The consumer can sleep in wait_for() when the ring is empty;
+ * notify() costs producers a fence and a load while the consumer is busy
+ * and only takes a lock to wake it, so a burst of pushes followed by one
+ * notify() wakes the consumer once.
+ */
+template<typename T>
+class MpscRing {
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscRing(size_t capacity)
+        : MpscRing(capacity, [](T&) {}) {}
+
+    // `init(slot)` runs once per slot, e.g. to reserve payload buffers
+    template<typename Init>
+    MpscRing(size_t capacity, Init&& init)
+        : mask_(round_up_pow2(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+            init(cells_[i].value);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Items pushed and not yet consumed; approximate while producers run
+    size_t size() const noexcept {
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    bool empty() const noexcept {
+        const Cell& cell = cells_[tail_.load(std::memory_order_relaxed) & mask_];
+        return cell.sequence.load(std::memory_order_acquire) !=
+               tail_.load(std::memory_order_relaxed) + 1;
+    }
+
+    // Producers (any thread): claim a slot and `fill(T&)` it in place.
+    // Returns false, without calling fill, if the ring is full. If fill
+    // throws, the slot is published empty and the exception propagates.
+    template<typename Fill>
+    bool try_push(Fill&& fill) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // the slot of the previous lap is not consumed yet
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        struct Publish {
+            Cell* cell;
+            size_t pos;
+            ~Publish() { cell->sequence.store(pos + 1, std::memory_order_release); }
+        } publish{cell, pos};
+        cell->skip = true;
+        fill(cell->value);
+        cell->skip = false;
+        return true;
+    }
+
+    // Consumer (one thread): pass up to `max_items` published items, oldest
+    // first, to `fn(T&)`; returns the number consumed. An item claimed but
+    // not yet published stops the run, keeping FIFO order; empty slots are
+    // released without calling fn.
+    template<typename Fn>
+    size_t consume(Fn&& fn, size_t max_items = SIZE_MAX) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < max_items) {
+            Cell& cell = cells_[tail & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1) {
+                break;
+            }
+            bool skip = cell.skip;
+            if (!skip) {
+                fn(cell.value);
+            }
+            cell.sequence.store(tail + mask_ + 1, std::memory_order_release);
+            ++tail;
+            count += skip ? 0 : 1;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    // Producers: wake the consumer if it sleeps in wait_for(). Call once
+    // after a batch of pushes.
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            woken_ = true;
+            wait_cv_.notify_one();
+        }
+    }
+
+    // Consumer: sleep until notify() or `timeout` unless items are already
+    // waiting. Returns true if the ring is non-empty.
+    template<typename Rep, typename Period>
+    bool wait_for(std::chrono::duration<Rep, Period> timeout) {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (empty()) {
+            wait_cv_.wait_for(lock, timeout, [this] { return woken_; });
+        }
+        woken_ = false;
+        sleeping_.store(false, std::memory_order_relaxed);
+        return !empty();
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    struct alignas(kCacheLine) Cell {
+        std::atomic<size_t> sequence{0};
+        bool skip = false;  // fill threw; written before the sequence is published
+        T value{};
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLine) std::atomic<size_t> head_{0};  // producers: next slot to claim
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};  // consumer: next slot to read
+
+    // Consumer sleep; producers only touch the mutex while it sleeps
+    alignas(kCacheLine) std::atomic<bool> sleeping_{false};
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+    bool woken_ = false;
+};
+
+}  // namespace utils
@@ -0,0 +1,155 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file msgpack_writer.hpp
+/// @brief Streaming MessagePack encoder into a reusable byte buffer
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace utils {
+
+/*
+ * Appends MessagePack (https://msgpack.org/) to a caller-owned buffer.
+ *
+ * There is no document model: callers write an array or map header with
+ * the element count, then the elements. Integers (integer() for signed,
+ * uinteger() for unsigned values) take the smallest encoding that holds
+ * the value, so small counters and enums cost a single byte. The buffer
+ * is only appended to; clear() it between messages and its capacity is
+ * reused.
+ */
+class MsgpackWriter {
+public:
+    explicit MsgpackWriter(std::string& out) : out_(out) {}
+
+    void nil() { put(0xc0); }
+
+    void boolean(bool value) { put(value ? 0xc3 : 0xc2); }
+
+    void uinteger(uint64_t value) {
+        if (value < 0x80) {
+            put(static_cast<uint8_t>(value));  // positive fixint
+        } else if (value <= UINT8_MAX) {
+            put(0xcc);
+            put(static_cast<uint8_t>(value));
+        } else if (value <= UINT16_MAX) {
+            put_be(0xcd, static_cast<uint16_t>(value));
+        } else if (value <= UINT32_MAX) {
+            put_be(0xce, static_cast<uint32_t>(value));
+        } else {
+            put_be(0xcf, value);
+        }
+    }
+
+    void integer(int64_t value) {
+        if (value >= 0) {
+            uinteger(static_cast<uint64_t>(value));
+        } else if (value >= -32) {
+            put(static_cast<uint8_t>(value));  // negative fixint
+        } else if (value >= INT8_MIN) {
+            put(0xd0);
+            put(static_cast<uint8_t>(value));
+        } else if (value >= INT16_MIN) {
+            put_be(0xd1, static_cast<uint16_t>(value));
+        } else if (value >= INT32_MIN) {
+            put_be(0xd2, static_cast<uint32_t>(value));
+        } else {
+            put_be(0xd3, static_cast<uint64_t>(value));
+        }
+    }
+
+    void float32(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        put_be(0xca, bits);
+    }
+
+    void float64(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        put_be(0xcb, bits);
+    }
+
+    void string(std::string_view value) {
+        size_t size = value.size();
+        if (size < 32) {
+            put(static_cast<uint8_t>(0xa0 | size));
+        } else if (size <= UINT8_MAX) {
+            put(0xd9);
+            put(static_cast<uint8_t>(size));
+        } else if (size <= UINT16_MAX) {
+            put_be(0xda, static_cast<uint16_t>(size));
+        } else {
+            put_be(0xdb, static_cast<uint32_t>(size));
+        }
+        out_.append(value.data(), size);
+    }
+
+    // NUL-terminated; nullptr is written as an empty string
+    void string(const char* value) {
+        string(value ? std::string_view(value) : std::string_view());
+    }
+
+    void binary(const uint8_t* data, size_t size) {
+        if (size <= UINT8_MAX) {
+            put(0xc4);
+            put(static_cast<uint8_t>(size));
+        } else if (size <= UINT16_MAX) {
+            put_be(0xc5, static_cast<uint16_t>(size));
+        } else {
+            put_be(0xc6, static_cast<uint32_t>(size));
+        }
+        out_.append(reinterpret_cast<const char*>(data), size);
+    }
+
+    void array(uint32_t count) { container(count, 0x90, 0xdc); }
+
+    void map(uint32_t count) { container(count, 0x80, 0xde); }
+
+    std::string& buffer() noexcept { return out_; }
+
+private:
+    void put(uint8_t byte) { out_.push_back(static_cast<char>(byte)); }
+
+    template<typename U>
+    void put_be(uint8_t type, U value) {
+        char bytes[1 + sizeof(U)];
+        bytes[0] = static_cast<char>(type);
+        for (size_t i = 0; i < sizeof(U); ++i) {
+            bytes[1 + i] = static_cast<char>(value >> (8 * (sizeof(U) - 1 - i)));
+        }
+        out_.append(bytes, sizeof(bytes));
+    }
+
+    void container(uint32_t count, uint8_t fix, uint8_t type16) {
+        if (count < 16) {
+            put(static_cast<uint8_t>(fix | count));
+        } else if (count <= UINT16_MAX) {
+            put_be(type16, static_cast<uint16_t>(count));
+        } else {
+            put_be(static_cast<uint8_t>(type16 + 1), count);
+        }
+    }
+
+    std::string& out_;
+};
+
+}  // namespace utils
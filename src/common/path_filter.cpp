@@ -0,0 +1,99 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/path_filter.hpp"
+
+namespace utils {
+
+namespace {
+
+// Split off the first segment of a dotted path; path keeps the remainder
+std::string_view next_segment(std::string_view& path) {
+    size_t dot = path.find('.');
+    std::string_view head = path.substr(0, dot);
+    path = dot == std::string_view::npos ? std::string_view{} : path.substr(dot + 1);
+    return head;
+}
+
+}  // namespace
+
+PathFilter::PathFilter(std::initializer_list<std::string_view> patterns) {
+    for (std::string_view pattern : patterns) {
+        add(pattern);
+    }
+}
+
+void PathFilter::add(std::string_view pattern) {
+    if (pattern == "**") {
+        match_all_ = true;
+        return;
+    }
+
+    if (pattern.find('*') == std::string_view::npos) {
+        exact_.insert(storage_.emplace_back(pattern));
+        return;
+    }
+
+    Segments segments;
+    while (!pattern.empty()) {
+        segments.emplace_back(next_segment(pattern));
+    }
+    wildcards_.push_back(std::move(segments));
+}
+
+bool PathFilter::matches(std::string_view path) const {
+    if (match_all_ || exact_.count(path) > 0) {
+        return true;
+    }
+    for (const Segments& pattern : wildcards_) {
+        if (match_segments(pattern, 0, path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PathFilter::match_segments(const Segments& pattern, size_t index, std::string_view path) {
+    for (; index < pattern.size(); ++index) {
+        const std::string& segment = pattern[index];
+
+        if (segment == "**") {
+            if (index + 1 == pattern.size()) {
+                return true;
+            }
+            // Let "**" absorb 0, 1, 2, ... segments until the rest matches
+            for (;;) {
+                if (match_segments(pattern, index + 1, path)) {
+                    return true;
+                }
+                if (path.empty()) {
+                    return false;
+                }
+                next_segment(path);
+            }
+        }
+
+        if (path.empty()) {
+            return false;
+        }
+        std::string_view head = next_segment(path);
+        if (segment != "*" && head != segment) {
+            return false;
+        }
+    }
+    return path.empty();
+}
+
+}  // namespace utils
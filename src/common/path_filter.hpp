@@ -0,0 +1,72 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file path_filter.hpp
+/// @brief Dotted-path matcher for VSS signal selection
+
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace utils {
+
+/*
+ * Set of dotted-path patterns, e.g. VSS signal paths.
+ *
+ * A pattern is either an exact path ("Vehicle.Speed") or contains
+ * wildcard segments: "*" matches exactly one segment and "**" matches
+ * any number of segments, including none ("Vehicle.Cabin.*.Temperature",
+ * "Vehicle.Powertrain.**"). Exact paths are resolved with a single hash
+ * lookup; wildcard patterns are tried in order afterwards.
+ *
+ * An empty filter matches nothing. Not thread-safe to modify; matches()
+ * may be called concurrently once the filter is built.
+ */
+class PathFilter {
+public:
+    PathFilter() = default;
+    PathFilter(std::initializer_list<std::string_view> patterns);
+
+    PathFilter(PathFilter&&) = default;
+    PathFilter& operator=(PathFilter&&) = default;
+
+    PathFilter(const PathFilter&) = delete;
+    PathFilter& operator=(const PathFilter&) = delete;
+
+    void add(std::string_view pattern);
+
+    bool matches(std::string_view path) const;
+
+    bool empty() const noexcept { return !match_all_ && exact_.empty() && wildcards_.empty(); }
+
+private:
+    using Segments = std::vector<std::string>;
+
+    static bool match_segments(const Segments& pattern, size_t index, std::string_view path);
+
+    bool match_all_ = false;
+
+    // Views into storage_; deque keeps element addresses stable on growth
+    std::deque<std::string> storage_;
+    std::unordered_set<std::string_view> exact_;
+    std::vector<Segments> wildcards_;
+};
+
+}  // namespace utils
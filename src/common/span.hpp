@@ -0,0 +1,78 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file span.hpp
+/// @brief Non-owning view of a contiguous array (C++17 stand-in for std::span)
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/*
+ * Pointer and length of a contiguous run of T; copying a Span copies the
+ * view, never the elements. Span<const T> binds to a Span<T> or a vector.
+ */
+template<typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    template<typename U, typename A,
+             typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    Span(std::vector<U, A>& vector) noexcept : data_(vector.data()), size_(vector.size()) {}
+
+    template<typename U, typename A,
+             typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    Span(const std::vector<U, A>& vector) noexcept
+        : data_(vector.data()), size_(vector.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T& operator[](size_t i) const noexcept { return data_[i]; }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    // Elements [offset, offset + count), clamped to the span
+    constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+        if (offset > size_) {
+            offset = size_;
+        }
+        if (count > size_ - offset) {
+            count = size_ - offset;
+        }
+        return {data_ + offset, count};
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace utils
@@ -20,6 +20,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <ctime>
 #include <string>
 
 namespace utils {
@@ -42,6 +43,15 @@ inline int64_t now_ms() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
 }
 
+/*
+ * CPU time consumed by the calling thread, in nanoseconds.
+ */
+inline int64_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
 /*
  * Generate a simple UUID-like string.
  * Not cryptographically secure, but good enough for correlation IDs.
@@ -16,7 +16,9 @@
 /// @file test_dds_wrapper.cpp
 /// @brief Unit tests for DDS wrapper
 
+#include "common/arena.hpp"
 #include "common/dds_wrapper.hpp"
+#include "common/path_filter.hpp"
 #include "common/qos_profiles.hpp"
 #include "common/time_utils.hpp"
 #include "telemetry.h"
@@ -26,6 +28,9 @@
 #include <gtest/gtest.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
+#include <string_view>
 #include <thread>
 #include <chrono>
 
@@ -81,6 +86,19 @@ TEST_F(DdsWrapperTest, QosProfiles) {
     EXPECT_NE(best_effort.get(), nullptr);
 }
 
+TEST_F(DdsWrapperTest, QosReaderTimingPolicies) {
+    auto qos = dds::qos_profiles::reliable_standard(1);
+    qos.time_based_filter(DDS_MSECS(100)).deadline(DDS_SECS(1)).latency_budget(DDS_MSECS(50));
+
+    dds_duration_t value = 0;
+    ASSERT_TRUE(dds_qget_time_based_filter(qos.get(), &value));
+    EXPECT_EQ(value, DDS_MSECS(100));
+    ASSERT_TRUE(dds_qget_deadline(qos.get(), &value));
+    EXPECT_EQ(value, DDS_SECS(1));
+    ASSERT_TRUE(dds_qget_latency_budget(qos.get(), &value));
+    EXPECT_EQ(value, DDS_MSECS(50));
+}
+
 TEST_F(DdsWrapperTest, WriteAndRead) {
     dds::Participant participant(DDS_DOMAIN_DEFAULT);
 
@@ -121,6 +139,341 @@ TEST_F(DdsWrapperTest, WriteAndRead) {
     EXPECT_EQ(count, 1);
 }
 
+TEST_F(DdsWrapperTest, WaitSetTriggersOnData) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(10);
+    dds::Topic topic(participant, &vss_Signal_desc, "test/waitset", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+
+    dds::ReadCondition condition(reader);
+    dds::WaitSet waitset(participant);
+    waitset.attach(condition, 42);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Nothing published yet: times out with no tokens
+    dds_attach_t triggered[4];
+    EXPECT_EQ(waitset.wait(triggered, 4, DDS_MSECS(10)), 0u);
+
+    vss_Signal msg = {};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+    writer.write(msg);
+
+    ASSERT_EQ(waitset.wait(triggered, 4, DDS_SECS(2)), 1u);
+    EXPECT_EQ(triggered[0], 42);
+
+    // Stays triggered until the sample is taken
+    EXPECT_EQ(waitset.wait(triggered, 4, 0), 1u);
+    reader.take_each<vss_Signal>([](const vss_Signal&) {});
+    EXPECT_EQ(waitset.wait(triggered, 4, DDS_MSECS(10)), 0u);
+
+    // wake() unblocks without reporting a token
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        waitset.wake();
+    });
+    EXPECT_EQ(waitset.wait(triggered, 4, DDS_SECS(5)), 0u);
+    waker.join();
+}
+
+TEST_F(DdsWrapperTest, TakeLoanHoldsSamplesUntilReleased) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(10);
+    dds::Topic topic(participant, &vss_Signal_desc, "test/loan", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    vss_Signal msg = {};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+    for (int i = 0; i < 3; ++i) {
+        msg.value.double_value = i;
+        writer.write(msg);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    {
+        auto samples = reader.take_loan<vss_Signal>(10);
+        ASSERT_EQ(samples.size(), 3u);
+
+        double expected = 0.0;
+        for (auto sample : samples) {
+            ASSERT_TRUE(sample.valid());
+            EXPECT_STREQ(sample.data.path, "Vehicle.Speed");
+            EXPECT_DOUBLE_EQ(sample.data.value.double_value, expected++);
+            EXPECT_GT(sample.info.source_timestamp, 0);
+        }
+
+        // Loan arrays are shared: a second loan must wait for this one
+        EXPECT_THROW(reader.take_loan<vss_Signal>(10), dds::Error);
+    }
+
+    // Released on scope exit; the reader is usable again
+    auto empty = reader.take_loan<vss_Signal>(10);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST_F(DdsWrapperTest, TakeLoanOfZeroSamplesOnFreshReader) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+    dds::Topic topic(participant, &vss_Signal_desc, "test/loan_zero");
+    dds::Reader reader(participant, topic);
+
+    // Nothing is asked of DDS, which would reject a zero-sized take
+    EXPECT_TRUE(reader.take_loan<vss_Signal>(0).empty());
+    EXPECT_TRUE(reader.read_loan<vss_Signal>(0).empty());
+    EXPECT_TRUE(reader.take<vss_Signal>(0).empty());
+
+    // No claim is held afterwards
+    EXPECT_TRUE(reader.take_loan<vss_Signal>(10).empty());
+}
+
+TEST_F(DdsWrapperTest, TakeSerializedReturnsCdr) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(10);
+    dds::Topic topic(participant, &telemetry_opaque_FreezeFrame_desc,
+                     "test/serialized", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    uint8_t payload[256];
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    telemetry_opaque_FreezeFrame msg = {};
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.frame_type = const_cast<char*>("ecu_dump");
+    msg.trigger_event_id = const_cast<char*>("evt-1");
+    msg.payload._buffer = payload;
+    msg.payload._length = sizeof(payload);
+    msg.payload._maximum = sizeof(payload);
+    writer.write(msg);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // A zero-sized take leaves the sample in the reader
+    size_t taken = 1;
+    EXPECT_EQ(reader.take_serialized([](const dds::SerializedSample&) {
+        ADD_FAILURE() << "zero-sized take delivered a sample";
+    }, 0, &taken), 0u);
+    EXPECT_EQ(taken, 0u);
+
+    size_t count = reader.take_serialized([&](const dds::SerializedSample& sample) {
+        // Encapsulation header, then a body holding at least the payload
+        ASSERT_GT(sample.size, 4 + sizeof(payload));
+        EXPECT_EQ(sample.data[0], 0x00);
+        EXPECT_GT(sample.info.source_timestamp, 0);
+
+        auto* begin = sample.data;
+        auto* end = sample.data + sample.size;
+        EXPECT_NE(std::search(begin, end, payload, payload + sizeof(payload)), end);
+    });
+
+    EXPECT_EQ(count, 1u);
+}
+
+TEST_F(DdsWrapperTest, WriterLoanCommitPublishes) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(10);
+    dds::Topic topic(participant, &vss_Signal_desc, "test/writer_loan", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    {
+        // Dropped without commit: nothing is published
+        auto loan = writer.loan<vss_Signal>();
+        loan->path = const_cast<char*>("Vehicle.Dropped");
+    }
+
+    auto loan = writer.loan<vss_Signal>();
+    EXPECT_EQ(loan->value.double_value, 0.0);  // zero-initialized
+    EXPECT_THROW(writer.loan<vss_Signal>(), dds::Error);
+
+    loan->path = const_cast<char*>("Vehicle.Speed");
+    loan->header.source_id = const_cast<char*>("test");
+    loan->header.correlation_id = const_cast<char*>("");
+    loan->value.type = vss_types_VALUE_TYPE_DOUBLE;
+    loan->value.double_value = 12.5;
+    loan.commit();
+
+    // The loan is consumed; committing it again publishes nothing
+    EXPECT_EQ(loan.try_commit(), DDS_RETCODE_PRECONDITION_NOT_MET);
+    EXPECT_THROW(loan.commit(), dds::Error);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<std::string> paths;
+    reader.take_each<vss_Signal>([&](const vss_Signal& sample) {
+        paths.emplace_back(sample.path);
+        EXPECT_DOUBLE_EQ(sample.value.double_value, 12.5);
+    });
+    EXPECT_EQ(paths, std::vector<std::string>{"Vehicle.Speed"});
+}
+
+TEST_F(DdsWrapperTest, WriteBatchDeliversOnFlush) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(100);
+    dds::Topic topic(participant, &vss_Signal_desc, "test/write_batch", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    vss_Signal msg = {};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+
+    {
+        dds::WriteBatch batch({&writer});
+        for (int i = 0; i < 20; ++i) {
+            msg.header.seq_num = static_cast<uint32_t>(i);
+            writer.write(msg);
+        }
+        batch.flush();
+
+        // Nested scopes share the process-wide batch mode
+        dds::WriteBatch inner({&writer});
+        writer.write(msg);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    size_t count = reader.take_each<vss_Signal>([](const vss_Signal&) {}, 100);
+    EXPECT_EQ(count, 21u);
+}
+
+TEST_F(DdsWrapperTest, TryWriteCountsOutcomes) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_critical();
+    qos.max_blocking_time(DDS_MSECS(5));
+
+    dds_reliability_kind_t kind;
+    dds_duration_t budget = 0;
+    ASSERT_TRUE(dds_qget_reliability(qos.get(), &kind, &budget));
+    EXPECT_EQ(kind, DDS_RELIABILITY_RELIABLE);
+    EXPECT_EQ(budget, DDS_MSECS(5));
+
+    // Best-effort profiles are left alone
+    auto be = dds::qos_profiles::best_effort();
+    be.max_blocking_time(DDS_MSECS(5));
+    ASSERT_TRUE(dds_qget_reliability(be.get(), &kind, &budget));
+    EXPECT_EQ(kind, DDS_RELIABILITY_BEST_EFFORT);
+
+    dds::Topic topic(participant, &vss_Signal_desc, "test/try_write", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+
+    vss_Signal msg = {};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+
+    EXPECT_EQ(writer.try_write(msg), DDS_RETCODE_OK);
+    writer.write(msg);
+
+    auto stats = writer.stats();
+    EXPECT_EQ(stats.written, 2u);
+    EXPECT_EQ(stats.timeouts, 0u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST_F(DdsWrapperTest, ListenerFiresOnData) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(10);
+    dds::Topic topic(participant, &vss_Signal_desc, "test/listener", qos.get());
+    dds::Writer writer(participant, topic, qos.get());
+    dds::Reader reader(participant, topic, qos.get());
+
+    std::atomic<size_t> received{0};
+    dds::Listener listener([&](dds_entity_t) {
+        received += reader.take_each<vss_Signal>([](const vss_Signal&) {});
+    });
+    reader.set_listener(listener.get());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    vss_Signal msg = {};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+    writer.write(msg);
+
+    for (int i = 0; i < 200 && received == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(received, 1u);
+
+    // Detached: new data stays in the reader cache
+    reader.set_listener(nullptr);
+    writer.write(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(received, 1u);
+    size_t taken = 0;
+    EXPECT_EQ(reader.take_each<vss_Signal>([](const vss_Signal&) {}, 100, &taken), 1u);
+    EXPECT_EQ(taken, 1u);
+}
+
+TEST_F(DdsWrapperTest, TopicFilterDropsRejectedSamples) {
+    dds::Participant participant(DDS_DOMAIN_DEFAULT);
+
+    auto qos = dds::qos_profiles::reliable_standard(10);
+    dds::Topic writer_topic(participant, &vss_Signal_desc, "test/topic_filter", qos.get());
+    dds::Topic reader_topic(participant, &vss_Signal_desc, "test/topic_filter", qos.get());
+    reader_topic.set_filter<vss_Signal>([](const vss_Signal& msg) {
+        return std::string_view(msg.path) == "Vehicle.Speed";
+    });
+    EXPECT_THROW(reader_topic.set_filter<vss_Signal>([](const vss_Signal&) { return true; }),
+                 dds::Error);
+
+    dds::Writer writer(participant, writer_topic, qos.get());
+    dds::Reader reader(participant, reader_topic, qos.get());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    vss_Signal msg = {};
+    msg.header.source_id = const_cast<char*>("test");
+    msg.header.correlation_id = const_cast<char*>("");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+    for (const char* path : {"Vehicle.Speed", "Vehicle.Cabin.Door", "Vehicle.Speed"}) {
+        msg.path = const_cast<char*>(path);
+        writer.write(msg);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    size_t count = reader.take_each<vss_Signal>([](const vss_Signal& s) {
+        EXPECT_STREQ(s.path, "Vehicle.Speed");
+    });
+    EXPECT_EQ(count, 2u);
+
+    auto stats = reader_topic.filter_stats();
+    EXPECT_EQ(stats.accepted, 2u);
+    EXPECT_EQ(stats.rejected, 1u);
+    EXPECT_EQ(writer_topic.filter_stats().accepted, 0u);
+}
+
 TEST_F(DdsWrapperTest, TimeUtils) {
     int64_t t1 = utils::now_ns();
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -130,6 +483,55 @@ TEST_F(DdsWrapperTest, TimeUtils) {
     EXPECT_GT(t2 - t1, 9000000);  // At least 9ms in nanoseconds
 }
 
+TEST_F(DdsWrapperTest, ArenaAlignsAndReuses) {
+    utils::Arena arena(64);
+
+    auto* a = arena.allocate_array<uint64_t>(3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % alignof(uint64_t), 0u);
+    char* s = arena.copy_string("hello");
+    EXPECT_STREQ(s, "hello");
+    EXPECT_EQ(arena.copy_string(nullptr), nullptr);
+
+    // Larger than a block: gets a dedicated block
+    void* big = arena.allocate(1000);
+    EXPECT_NE(big, nullptr);
+    size_t reserved = arena.bytes_reserved();
+
+    arena.reset();
+    EXPECT_EQ(arena.bytes_used(), 0u);
+    arena.allocate_array<uint64_t>(3);
+    arena.allocate(1000);
+    EXPECT_EQ(arena.bytes_reserved(), reserved);
+}
+
+TEST_F(DdsWrapperTest, PathFilterMatchesPatterns) {
+    utils::PathFilter filter{"Vehicle.Speed", "Vehicle.Cabin.*.Temperature",
+                             "Vehicle.Powertrain.**", "Vehicle.**.IsOpen"};
+
+    EXPECT_TRUE(filter.matches("Vehicle.Speed"));
+    EXPECT_FALSE(filter.matches("Vehicle.SpeedLimit"));
+    EXPECT_FALSE(filter.matches("Vehicle"));
+
+    EXPECT_TRUE(filter.matches("Vehicle.Cabin.Row1.Temperature"));
+    EXPECT_FALSE(filter.matches("Vehicle.Cabin.Row1.Left.Temperature"));
+    EXPECT_FALSE(filter.matches("Vehicle.Cabin.Temperature"));
+
+    EXPECT_TRUE(filter.matches("Vehicle.Powertrain"));
+    EXPECT_TRUE(filter.matches("Vehicle.Powertrain.Battery.StateOfCharge"));
+    EXPECT_FALSE(filter.matches("Vehicle.PowertrainX"));
+
+    EXPECT_TRUE(filter.matches("Vehicle.IsOpen"));
+    EXPECT_TRUE(filter.matches("Vehicle.Body.Door.Row1.IsOpen"));
+    EXPECT_FALSE(filter.matches("Vehicle.Body.Door.IsOpenX"));
+
+    utils::PathFilter empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.matches("Vehicle.Speed"));
+
+    utils::PathFilter all{"**"};
+    EXPECT_TRUE(all.matches("Anything.At.All"));
+}
+
 TEST_F(DdsWrapperTest, UuidGeneration) {
     std::string uuid1 = utils::generate_uuid();
     std::string uuid2 = utils::generate_uuid();
@@ -147,4 +549,13 @@ TEST_F(DdsWrapperTest, EntityMoveSemantics) {
     dds::Participant p2(std::move(p1));
     EXPECT_TRUE(p2);
     EXPECT_EQ(p2.get(), handle);
+
+    // Readers move too, with their loan state
+    dds::Topic topic(p2, &vss_Signal_desc, "test/reader_move");
+    dds::Reader r1(p2, topic);
+    dds::Reader r2(std::move(r1));
+    EXPECT_TRUE(r2);
+    EXPECT_TRUE(r2.take_loan<vss_Signal>(10).empty());
+    r1 = std::move(r2);
+    EXPECT_TRUE(r1);
 }
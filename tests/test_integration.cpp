@@ -26,6 +26,7 @@
 
 #include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <thread>
 
 using namespace std::chrono_literals;
@@ -338,6 +339,56 @@ TEST_F(IntegrationTest, Sustained_100PerSecond_NoLoss) {
     vdr.stop();
 }
 
+TEST_F(IntegrationTest, SignalRules_DownsampledToMaxHz) {
+    auto sink = std::make_unique<vdr::sinks::CaptureSink>();
+    auto* capture = sink.get();
+
+    vdr::SubscriptionConfig config;
+    config.signal_rules = {{"Vehicle.Speed", 10.0}};
+
+    vdr::testing::TestVdr vdr(domain_id_);
+    ASSERT_TRUE(vdr.start(std::move(sink), config));
+
+    vdr::testing::TestProbe probe("test_probe", domain_id_);
+    ASSERT_TRUE(probe.start());
+
+    std::this_thread::sleep_for(200ms);
+
+    // Both paths at 100 Hz for one second; only Vehicle.Speed has a rule
+    const size_t count = 100;
+    for (size_t i = 0; i < count; ++i) {
+        probe.send_signal("Vehicle.Speed", static_cast<double>(i));
+        probe.send_signal("Vehicle.Cabin.Temperature", static_cast<double>(i));
+        std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_TRUE(capture->wait_for_signals(count, 5000ms));
+    std::this_thread::sleep_for(200ms);
+
+    size_t speed = 0;
+    size_t temperature = 0;
+    for (const auto& signal : capture->signals()) {
+        (signal.path == "Vehicle.Speed" ? speed : temperature)++;
+    }
+    EXPECT_EQ(temperature, count);
+    // About 10 Hz; one filter per reader, so never much less
+    EXPECT_GE(speed, 8u);
+    EXPECT_LE(speed, 13u);
+
+    probe.stop();
+    vdr.stop();
+}
+
+TEST_F(IntegrationTest, DuplicateSignalBinding_Rejected) {
+    dds::Participant participant(domain_id_);
+    vdr::SubscriptionConfig config;
+    vdr::SubscriptionManager subscriptions(participant, config);
+
+    auto handler = [](const vss_Signal&) {};
+    subscriptions.subscribe(vdr::bind<vss_Signal>(config.vss_signals, handler));
+    EXPECT_THROW(subscriptions.subscribe(vdr::bind<vss_Signal>(config.vss_signals, handler)),
+                 std::invalid_argument);
+}
+
 TEST_F(IntegrationTest, NullSink_HighThroughput) {
     // Test with null sink to measure raw throughput
     auto sink = std::make_unique<vdr::sinks::NullSink>();
@@ -0,0 +1,1931 @@
+// Copyright 2025 VDR-Light Contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file test_vdr_core.cpp
+/// @brief Unit tests for VDR building blocks that need no DDS traffic
+
+#include "common/mpsc_ring.hpp"
+#include "common/msgpack_writer.hpp"
+#include "codec/signal_batch_decoder.hpp"
+#include "vdr/can_decoder.hpp"
+#include "vdr/can_ingest.hpp"
+#include "vdr/cdr_views.hpp"
+#include "vdr/drain_scheduler.hpp"
+#include "vdr/envelope.hpp"
+#include "vdr/signal_rates.hpp"
+#include "vdr/signal_transforms.hpp"
+#include "vdr/sinks/batch_compressor.hpp"
+#include "vdr/sinks/capture_sink.hpp"
+#include "vdr/sinks/composite_sink.hpp"
+#include "vdr/sinks/json_encoder.hpp"
+#include "vdr/sinks/msgpack_encoder.hpp"
+#include "vdr/sinks/protobuf_encoder.hpp"
+#include "vdr/sinks/signal_batch_encoder.hpp"
+#include "vdr/sinks/topic_batcher.hpp"
+#include "vdr/subscriber.hpp"
+#include "vdr/vssdag_mapping.hpp"
+
+#include "offboard.pb.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================================================
+// DrainScheduler
+// =============================================================================
+
+namespace {
+
+/// Fake reader: a backlog counter plus a trace of every take.
+struct FakeTopic {
+    std::string name;
+    size_t backlog = 0;
+    std::vector<std::string>* trace = nullptr;
+
+    size_t take(size_t max_samples) {
+        size_t n = std::min(max_samples, backlog);
+        backlog -= n;
+        trace->push_back(name + ":" + std::to_string(n));
+        return n;
+    }
+};
+
+}  // namespace
+
+TEST(DrainSchedulerTest, ParsePriority) {
+    EXPECT_EQ(vdr::parse_priority("critical"), vdr::Priority::Critical);
+    EXPECT_EQ(vdr::parse_priority("low"), vdr::Priority::Low);
+    EXPECT_FALSE(vdr::parse_priority("urgent").has_value());
+}
+
+TEST(DrainSchedulerTest, AdaptiveBatchFollowsBacklog) {
+    vdr::AdaptiveBatch batch;
+    EXPECT_EQ(batch.size(), vdr::AdaptiveBatch::kMin);
+
+    for (int i = 0; i < 10; ++i) {
+        batch.update(batch.size(), batch.size());
+    }
+    EXPECT_EQ(batch.size(), vdr::AdaptiveBatch::kMax);
+
+    batch.update(batch.size(), 0);
+    EXPECT_EQ(batch.size(), vdr::AdaptiveBatch::kMax / 2);
+}
+
+TEST(DrainSchedulerTest, CriticalDrainedFirstAndLowBudgeted) {
+    std::vector<std::string> trace;
+    FakeTopic low{"low", 1000, &trace};
+    FakeTopic critical{"critical", 20, &trace};
+
+    vdr::DrainScheduler scheduler;
+    dds_attach_t low_token = scheduler.add(
+        vdr::Priority::Low, 40,
+        [&](size_t n) { return low.take(n); },
+        [&] { return low.backlog > 0; });
+    dds_attach_t critical_token = scheduler.add(
+        vdr::Priority::Critical, 0,
+        [&](size_t n) { return critical.take(n); },
+        [&] { return critical.backlog > 0; });
+
+    dds_attach_t triggered[] = {low_token, critical_token};
+    scheduler.run(triggered, 2);
+
+    // Critical runs before low even though low triggered first
+    ASSERT_FALSE(trace.empty());
+    EXPECT_EQ(trace.front().rfind("critical:", 0), 0u);
+    EXPECT_EQ(critical.backlog, 0u);
+
+    // Low stops at its budget, the rest waits for the next round
+    EXPECT_EQ(low.backlog, 1000u - 40u);
+}
+
+TEST(DrainSchedulerTest, CriticalPreemptsLowerPriorityBatches) {
+    std::vector<std::string> trace;
+    FakeTopic low{"low", 1000, &trace};
+    FakeTopic critical{"critical", 0, &trace};
+
+    vdr::DrainScheduler scheduler;
+    size_t low_batches = 0;
+    dds_attach_t low_token = scheduler.add(
+        vdr::Priority::Low, 200,
+        [&](size_t n) {
+            // A critical event arrives while the low topic is being drained
+            if (++low_batches == 2) {
+                critical.backlog = 1;
+            }
+            return low.take(n);
+        },
+        [&] { return low.backlog > 0; });
+    scheduler.add(
+        vdr::Priority::Critical, 0,
+        [&](size_t n) { return critical.take(n); },
+        [&] { return critical.backlog > 0; });
+
+    dds_attach_t triggered[] = {low_token};
+    scheduler.run(triggered, 1);
+
+    // The critical sample is taken right after the batch during which it arrived
+    ASSERT_GE(trace.size(), 3u);
+    EXPECT_EQ(trace[2], "critical:1");
+    EXPECT_EQ(critical.backlog, 0u);
+}
+
+// =============================================================================
+// Topic QoS
+// =============================================================================
+
+TEST(TopicQosTest, ParseProfile) {
+    EXPECT_EQ(vdr::parse_qos_profile("best_effort"), vdr::QosProfile::BestEffort);
+    EXPECT_EQ(vdr::parse_qos_profile("reliable_critical"), vdr::QosProfile::ReliableCritical);
+    EXPECT_EQ(vdr::parse_qos_profile("reliable"), std::nullopt);
+    EXPECT_STREQ(vdr::to_string(vdr::QosProfile::ReliableStandard), "reliable_standard");
+}
+
+TEST(TopicQosTest, ValidateRejectsInconsistentLimits) {
+    using vdr::QosProfile;
+
+    EXPECT_FALSE(vdr::validate({QosProfile::ReliableStandard, 100}));
+    EXPECT_FALSE(vdr::validate({QosProfile::ReliableCritical, 0}));
+    EXPECT_FALSE(vdr::validate({QosProfile::BestEffort, 0, 500}));
+    EXPECT_FALSE(vdr::validate({QosProfile::BestEffort, 10, 10, 1}));
+
+    EXPECT_TRUE(vdr::validate({QosProfile::ReliableStandard, -1}));
+    EXPECT_TRUE(vdr::validate({QosProfile::ReliableStandard, 10, 0}));
+    EXPECT_TRUE(vdr::validate({QosProfile::ReliableStandard, 10, DDS_LENGTH_UNLIMITED, -5}));
+    EXPECT_TRUE(vdr::validate({QosProfile::ReliableStandard, 100, 50}));
+    EXPECT_TRUE(vdr::validate({QosProfile::BestEffort, 0}));
+
+    // Shipped defaults must be usable
+    vdr::SubscriptionConfig defaults;
+    EXPECT_FALSE(vdr::validate(defaults.vss_signals.qos));
+    EXPECT_FALSE(vdr::validate(defaults.events.qos));
+    EXPECT_FALSE(vdr::validate(defaults.gauges.qos));
+}
+
+TEST(TopicRegistryTest, BindUsesTraitDefaults) {
+    using Incident = telemetry_security_Incident;
+
+    EXPECT_STREQ(vdr::TopicTraits<Incident>::name, "rt/security/incidents");
+    EXPECT_EQ(vdr::TopicTraits<Incident>::descriptor(), &telemetry_security_Incident_desc);
+    EXPECT_FALSE(vdr::validate(vdr::TopicTraits<telemetry_avtp_AcfCanBatch>::default_qos));
+
+    size_t handled = 0;
+    auto binding = vdr::bind<Incident>([&handled](const Incident&) { ++handled; });
+    EXPECT_TRUE(binding.config().enabled);
+    EXPECT_EQ(binding.config().qos.profile, vdr::QosProfile::ReliableCritical);
+    EXPECT_EQ(binding.config().qos.history_depth, 0);
+
+    vdr::TopicConfig disabled;
+    disabled.enabled = false;
+    auto explicit_binding = vdr::bind<vss_Signal>(disabled, [](const vss_Signal&) {});
+    EXPECT_FALSE(explicit_binding.config().enabled);
+}
+
+// =============================================================================
+// Signal rates
+// =============================================================================
+
+TEST(SignalRatesTest, GroupsByRateFirstRuleWins) {
+    vdr::SignalRates rates({"Vehicle.**"},
+                           {{"Vehicle.Speed", 1.0},
+                            {"Vehicle.CurrentLocation.*", 0.1},
+                            {"Vehicle.Powertrain.**", 1.0},
+                            {"Vehicle.Powertrain.Engine.Speed", 0.0}});
+
+    ASSERT_EQ(rates.group_count(), 3u);
+    EXPECT_DOUBLE_EQ(rates.max_hz(1), 0.1);
+    EXPECT_DOUBLE_EQ(rates.max_hz(2), 1.0);
+    EXPECT_FALSE(rates.trivial());
+
+    EXPECT_EQ(rates.group_for("Vehicle.Speed"), 2);
+    EXPECT_EQ(rates.group_for("Vehicle.Powertrain.Engine.Speed"), 2);
+    EXPECT_EQ(rates.group_for("Vehicle.CurrentLocation.Latitude"), 1);
+    EXPECT_EQ(rates.group_for("Vehicle.Cabin.Door"), 0);
+    EXPECT_EQ(rates.group_for("Other.Speed"), vdr::SignalRates::kNotReceived);
+
+    EXPECT_TRUE(vdr::SignalRates({}, {}).trivial());
+}
+
+TEST(SignalRatesTest, RateLimiterSeparatesPerPath) {
+    vdr::RateLimiter limiter(1000);
+
+    EXPECT_TRUE(limiter.admit("Vehicle.Speed", 0));
+    EXPECT_TRUE(limiter.admit("Vehicle.Cabin.Door", 10));
+    EXPECT_FALSE(limiter.admit("Vehicle.Speed", 999));
+    EXPECT_TRUE(limiter.admit("Vehicle.Speed", 1000));
+    EXPECT_FALSE(limiter.admit("Vehicle.Speed", 1500));
+
+    // Publisher restart: timestamps jump back
+    EXPECT_TRUE(limiter.admit("Vehicle.Speed", 5));
+    EXPECT_FALSE(limiter.admit("Vehicle.Speed", 6));
+}
+
+// =============================================================================
+// Envelopes
+// =============================================================================
+
+TEST(EnvelopeTest, SignalCopySurvivesSource) {
+    std::string path = "Vehicle.Cabin.Door.Row1.IsOpen";
+    std::string source = "probe";
+    double values[] = {1.0, 2.0, 3.0};
+
+    vss_Signal src = {};
+    src.path = path.data();
+    src.header.source_id = source.data();
+    src.header.seq_num = 7;
+    src.value.type = vss_types_VALUE_TYPE_DOUBLE_ARRAY;
+    src.value.double_array._buffer = values;
+    src.value.double_array._length = 3;
+    src.value.double_array._maximum = 3;
+
+    vdr::EnvelopeBatch<vss_Signal> batch;
+    const vss_Signal& copy = batch.add(src);
+
+    // Scribble over the source: the copy owns its own storage
+    path.assign(path.size(), 'x');
+    values[1] = -1.0;
+
+    EXPECT_STREQ(copy.path, "Vehicle.Cabin.Door.Row1.IsOpen");
+    EXPECT_STREQ(copy.header.source_id, "probe");
+    EXPECT_EQ(copy.header.correlation_id, nullptr);
+    EXPECT_EQ(copy.header.seq_num, 7u);
+    ASSERT_EQ(copy.value.double_array._length, 3u);
+    EXPECT_DOUBLE_EQ(copy.value.double_array._buffer[1], 2.0);
+    EXPECT_FALSE(copy.value.double_array._release);
+}
+
+TEST(EnvelopeTest, InactiveValueMembersAreNotCopied) {
+    char stale[] = "stale";
+    vss_Signal src = {};
+    src.value.type = vss_types_VALUE_TYPE_INT32;
+    src.value.int32_value = 5;
+    src.value.string_value = stale;  // garbage left behind by a previous use
+
+    vdr::EnvelopeBatch<vss_Signal> batch;
+    const vss_Signal& copy = batch.add(src);
+
+    EXPECT_EQ(copy.value.int32_value, 5);
+    EXPECT_EQ(copy.value.string_value, nullptr);
+}
+
+TEST(EnvelopeTest, EventCopiesAttributesAndContext) {
+    vss_types_KeyValue attrs[] = {{const_cast<char*>("k"), const_cast<char*>("v")}};
+    vss_Signal context[1] = {};
+    context[0].path = const_cast<char*>("Vehicle.Speed");
+    context[0].value.type = vss_types_VALUE_TYPE_STRING;
+    context[0].value.string_value = const_cast<char*>("fast");
+
+    telemetry_events_Event src = {};
+    src.event_id = const_cast<char*>("evt-1");
+    src.category = const_cast<char*>("ADAS");
+    src.attributes._buffer = attrs;
+    src.attributes._length = 1;
+    src.context._buffer = context;
+    src.context._length = 1;
+
+    vdr::EnvelopeBatch<telemetry_events_Event> batch;
+    const auto& copy = batch.add(src);
+
+    EXPECT_NE(copy.event_id, src.event_id);
+    EXPECT_STREQ(copy.event_id, "evt-1");
+    ASSERT_EQ(copy.attributes._length, 1u);
+    EXPECT_NE(copy.attributes._buffer, attrs);
+    EXPECT_STREQ(copy.attributes._buffer[0].value, "v");
+    ASSERT_EQ(copy.context._length, 1u);
+    EXPECT_NE(copy.context._buffer[0].value.string_value, context[0].value.string_value);
+    EXPECT_STREQ(copy.context._buffer[0].value.string_value, "fast");
+}
+
+TEST(EnvelopeTest, ClearReusesArena) {
+    vss_Signal src = {};
+    src.path = const_cast<char*>("Vehicle.Speed");
+
+    vdr::EnvelopeBatch<vss_Signal> batch(256);
+    for (int i = 0; i < 100; ++i) {
+        batch.add(src);
+    }
+    EXPECT_EQ(batch.size(), 100u);
+    EXPECT_GE(batch.arena_bytes(), 100 * std::strlen(src.path));
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(batch.arena_bytes(), 0u);
+
+    batch.add(src);
+    EXPECT_STREQ(batch[0].path, "Vehicle.Speed");
+}
+
+// =============================================================================
+// CDR views
+// =============================================================================
+
+namespace {
+
+/// Minimal CDR encoder for building test inputs.
+class CdrBuilder {
+public:
+    CdrBuilder(bool xcdr2, bool big_endian) : xcdr2_(xcdr2), big_endian_(big_endian) {
+        uint8_t id = static_cast<uint8_t>((xcdr2 ? 0x06 : 0x00) | (big_endian ? 0 : 1));
+        bytes_ = {0x00, id, 0x00, 0x00};
+    }
+
+    template<typename T>
+    CdrBuilder& put(T value) {
+        size_t align = std::min(sizeof(T), xcdr2_ ? size_t{4} : size_t{8});
+        while ((bytes_.size() - 4) % align != 0) {
+            bytes_.push_back(0);
+        }
+        uint8_t raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        if (big_endian_) {
+            std::reverse(raw, raw + sizeof(T));
+        }
+        bytes_.insert(bytes_.end(), raw, raw + sizeof(T));
+        return *this;
+    }
+
+    CdrBuilder& str(const std::string& value) {
+        put<uint32_t>(static_cast<uint32_t>(value.size() + 1));
+        bytes_.insert(bytes_.end(), value.begin(), value.end());
+        bytes_.push_back(0);
+        return *this;
+    }
+
+    CdrBuilder& header(const std::string& source, int64_t ts, uint32_t seq) {
+        return str(source).put<int64_t>(ts).put<uint32_t>(seq).str("");
+    }
+
+    /// Value members up to and including string_value
+    CdrBuilder& value_scalars(vss_types_ValueType type, double d, const std::string& s) {
+        put<int32_t>(type).put<uint8_t>(0).put<int8_t>(0).put<int16_t>(0)
+            .put<int32_t>(0).put<int64_t>(0).put<uint8_t>(0).put<uint16_t>(0)
+            .put<uint32_t>(0).put<uint64_t>(0).put<float>(0).put<double>(d);
+        return str(s);
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    bool xcdr2_;
+    bool big_endian_;
+    std::vector<uint8_t> bytes_;
+};
+
+}  // namespace
+
+TEST(CdrViewTest, SignalXcdr1LittleEndian) {
+    CdrBuilder cdr(false, false);
+    cdr.str("Vehicle.Speed").header("probe", 123456789, 42)
+        .put<int32_t>(vss_types_QUALITY_VALID)
+        .value_scalars(vss_types_VALUE_TYPE_DOUBLE, 88.5, "");
+
+    vdr::SignalView view;
+    ASSERT_TRUE(vdr::decode(cdr.bytes().data(), cdr.bytes().size(), view));
+    EXPECT_EQ(view.path, "Vehicle.Speed");
+    EXPECT_EQ(view.header.source_id, "probe");
+    EXPECT_EQ(view.header.timestamp_ns, 123456789);
+    EXPECT_EQ(view.header.seq_num, 42u);
+    EXPECT_EQ(view.quality, vss_types_QUALITY_VALID);
+    EXPECT_EQ(view.value.type, vss_types_VALUE_TYPE_DOUBLE);
+    EXPECT_DOUBLE_EQ(view.value.double_value, 88.5);
+
+    // Views point into the buffer
+    auto* begin = reinterpret_cast<const char*>(cdr.bytes().data());
+    EXPECT_GE(view.path.data(), begin);
+    EXPECT_LT(view.path.data(), begin + cdr.bytes().size());
+}
+
+TEST(CdrViewTest, SignalXcdr2BigEndianArray) {
+    CdrBuilder cdr(true, true);
+    cdr.str("Vehicle.Body.Lights").header("probe", -1, 1)
+        .put<int32_t>(vss_types_QUALITY_VALID)
+        .value_scalars(vss_types_VALUE_TYPE_INT64_ARRAY, 0.0, "")
+        .put<uint32_t>(0)                                        // bool_array
+        .put<uint32_t>(0)                                        // int32_array
+        .put<uint32_t>(2).put<int64_t>(7).put<int64_t>(-9);      // int64_array
+
+    vdr::SignalView view;
+    ASSERT_TRUE(vdr::decode(cdr.bytes().data(), cdr.bytes().size(), view));
+    EXPECT_EQ(view.header.timestamp_ns, -1);
+    ASSERT_EQ(view.value.int64_array.size(), 2u);
+    EXPECT_EQ(view.value.int64_array[0], 7);
+    EXPECT_EQ(view.value.int64_array[1], -9);
+}
+
+TEST(CdrViewTest, GaugeLabelsAreLazy) {
+    for (bool xcdr2 : {false, true}) {
+        SCOPED_TRACE(xcdr2 ? "XCDR2" : "XCDR1");
+        CdrBuilder cdr(xcdr2, false);
+        cdr.str("cpu_load").header("metrics_probe", 5, 9);
+        if (xcdr2) {
+            cdr.put<uint32_t>(0);  // DHEADER, not checked by the decoder
+        }
+        cdr.put<uint32_t>(2).str("core").str("0").str("host").str("ecu1").put<double>(0.75);
+
+        vdr::MetricView view;
+        ASSERT_TRUE(vdr::decode(cdr.bytes().data(), cdr.bytes().size(), view));
+        EXPECT_EQ(view.name, "cpu_load");
+        EXPECT_DOUBLE_EQ(view.value, 0.75);
+
+        std::vector<std::string> labels;
+        for (const auto& label : view.labels) {
+            labels.push_back(std::string(label.key) + "=" + std::string(label.value));
+        }
+        EXPECT_EQ(labels, (std::vector<std::string>{"core=0", "host=ecu1"}));
+    }
+}
+
+TEST(CdrViewTest, ScalarMeasurement) {
+    CdrBuilder cdr(true, false);
+    cdr.str("engine.temp").header("diag", 1, 2).str("C")
+        .put<int32_t>(telemetry_diagnostics_MEASUREMENT_TYPE_MOMENTARY)
+        .put<double>(91.0);
+
+    vdr::ScalarMeasurementView view;
+    ASSERT_TRUE(vdr::decode(cdr.bytes().data(), cdr.bytes().size(), view));
+    EXPECT_EQ(view.unit, "C");
+    EXPECT_EQ(view.measurement_type, telemetry_diagnostics_MEASUREMENT_TYPE_MOMENTARY);
+    EXPECT_DOUBLE_EQ(view.value, 91.0);
+}
+
+TEST(CdrViewTest, RejectsTruncatedAndUnsupported) {
+    CdrBuilder cdr(false, false);
+    cdr.str("cpu_load").header("metrics_probe", 5, 9).put<uint32_t>(0).put<double>(1.0);
+    std::vector<uint8_t> bytes = cdr.bytes();
+
+    vdr::MetricView view;
+    EXPECT_FALSE(vdr::decode(bytes.data(), bytes.size() - 1, view));
+
+    // Parameter-list encoding (mutable types) is not handled
+    bytes[1] = 0x03;
+    EXPECT_FALSE(vdr::decode(bytes.data(), bytes.size(), view));
+
+    // Absurd sequence length must not read past the buffer
+    CdrBuilder huge(false, false);
+    huge.str("x").header("", 0, 0).put<uint32_t>(0xFFFFFFFFu);
+    EXPECT_FALSE(vdr::decode(huge.bytes().data(), huge.bytes().size(), view));
+}
+
+// =============================================================================
+// CAN ingest
+// =============================================================================
+
+namespace {
+
+void put_can_frame(CdrBuilder& cdr, uint32_t can_id, uint8_t bus,
+                   const std::vector<uint8_t>& payload, uint32_t seq) {
+    cdr.header("can_probe", 1000 + seq, seq).put<uint64_t>(0xA1).put<uint32_t>(can_id)
+        .put<uint8_t>(bus)
+        .put<uint8_t>(1).put<uint8_t>(1).put<uint8_t>(0).put<uint8_t>(0).put<uint8_t>(0)
+        .put<uint32_t>(static_cast<uint32_t>(payload.size()));
+    for (uint8_t byte : payload) {
+        cdr.put<uint8_t>(byte);
+    }
+    cdr.put<uint64_t>(5000 + seq).put<uint32_t>(seq);
+}
+
+/// AcfCanBatch with `frames` frames of `payload_size` bytes.
+CdrBuilder can_batch(bool xcdr2, size_t frames, size_t payload_size) {
+    CdrBuilder cdr(xcdr2, false);
+    cdr.header("can_probe", 1, 1).put<uint64_t>(0xA1);
+    if (xcdr2) {
+        cdr.put<uint32_t>(0);  // DHEADER, not checked by the decoder
+    }
+    cdr.put<uint32_t>(static_cast<uint32_t>(frames));
+    for (size_t i = 0; i < frames; ++i) {
+        std::vector<uint8_t> payload(payload_size, static_cast<uint8_t>(i));
+        put_can_frame(cdr, 0x100 + static_cast<uint32_t>(i), 2, payload,
+                      static_cast<uint32_t>(i));
+    }
+    return cdr;
+}
+
+std::vector<vdr::CanFrame> consume_all(vdr::CanFrameRing& ring) {
+    std::vector<vdr::CanFrame> out;
+    ring.consume([&out](const vdr::CanFrame* frames, size_t count) {
+        out.insert(out.end(), frames, frames + count);
+    });
+    return out;
+}
+
+}  // namespace
+
+TEST(CanIngestTest, DecodesBatchIntoRing) {
+    CdrBuilder cdr = can_batch(false, 2, 64);
+
+    vdr::CanFrameRing ring(8);
+    vdr::CanIngest ingest(ring);
+    EXPECT_EQ(ingest.ingest(cdr.bytes().data(), cdr.bytes().size()), 2u);
+
+    auto frames = consume_all(ring);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[1].can_id, 0x101u);
+    EXPECT_EQ(frames[1].bus_id, 2);
+    EXPECT_EQ(frames[1].flags, vdr::CanFrame::kExtendedId | vdr::CanFrame::kFd);
+    EXPECT_EQ(frames[1].length, 64);
+    EXPECT_EQ(frames[1].data[63], 1);
+    EXPECT_EQ(frames[1].timestamp_ns, 1001);
+    EXPECT_EQ(frames[1].avtp_timestamp, 5001u);
+    EXPECT_EQ(frames[1].sequence_num, 1u);
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(CanIngestTest, FullRingDropsAndMalformedBatchRollsBack) {
+    vdr::CanFrameRing ring(3);  // rounded up to 4
+    EXPECT_EQ(ring.capacity(), 4u);
+    vdr::CanIngest ingest(ring);
+
+    CdrBuilder three = can_batch(true, 3, 8);
+    EXPECT_EQ(ingest.ingest(three.bytes().data(), three.bytes().size()), 3u);
+    EXPECT_EQ(consume_all(ring).size(), 3u);
+
+    // Wraps around the end of the ring; the fifth frame does not fit
+    CdrBuilder five = can_batch(true, 5, 8);
+    EXPECT_EQ(ingest.ingest(five.bytes().data(), five.bytes().size()), 4u);
+    size_t spans = 0;
+    std::vector<uint32_t> ids;
+    ring.consume([&](const vdr::CanFrame* frames, size_t count) {
+        ++spans;
+        for (size_t i = 0; i < count; ++i) {
+            ids.push_back(frames[i].can_id);
+        }
+    });
+    EXPECT_EQ(spans, 2u);
+    EXPECT_EQ(ids, (std::vector<uint32_t>{0x100, 0x101, 0x102, 0x103}));
+
+    // A truncated batch leaves nothing behind
+    std::vector<uint8_t> truncated = three.bytes();
+    truncated.resize(truncated.size() - 3);
+    EXPECT_EQ(ingest.ingest(truncated.data(), truncated.size()), 0u);
+    EXPECT_EQ(ring.size(), 0u);
+
+    auto stats = ingest.stats();
+    EXPECT_EQ(stats.batches, 3u);
+    EXPECT_EQ(stats.frames, 7u);
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_EQ(stats.malformed, 1u);
+}
+
+// =============================================================================
+// DBC decoding
+// =============================================================================
+
+namespace {
+
+const char* const kTestDbc = R"(VERSION ""
+
+BU_: VCU BMS
+
+BO_ 256 DI_speed: 8 VCU
+ SG_ DI_vehicleSpeed : 0|16@1+ (0.1,0) [0|655.35] "km/h" Vector__XXX
+ SG_ DI_gear : 16|3@1+ (1,0) [0|7] "" Vector__XXX
+
+BO_ 512 BMS_status: 8 BMS
+ SG_ BMS_packCurrent : 40|16@1- (0.1,0) [-500|500] "A" Vector__XXX
+ SG_ BMS_mode M : 56|8@1+ (1,0) [0|255] "" Vector__XXX
+
+BO_ 2147484416 EXT_motorola: 8 VCU
+ SG_ EXT_word : 7|16@0+ (1,0) [0|65535] "" Vector__XXX
+ SG_ EXT_torque : 23|12@0- (0.5,10) [-1000|1000] "Nm" Vector__XXX
+
+CM_ BO_ 256 "Drive inverter";
+)";
+
+vdr::CanFrame make_frame(uint32_t can_id, bool extended, std::vector<uint8_t> payload,
+                         int64_t ts) {
+    vdr::CanFrame frame{};
+    frame.can_id = can_id;
+    frame.flags = extended ? vdr::CanFrame::kExtendedId : 0;
+    frame.timestamp_ns = ts;
+    frame.length = static_cast<uint8_t>(payload.size());
+    std::memcpy(frame.data, payload.data(), payload.size());
+    return frame;
+}
+
+}  // namespace
+
+TEST(DbcTest, ParsesMessagesAndSignals) {
+    std::istringstream in(kTestDbc);
+    auto messages = vdr::parse_dbc(in);
+    ASSERT_EQ(messages.size(), 3u);
+
+    EXPECT_EQ(messages[0].id, 256u);
+    EXPECT_EQ(messages[0].name, "DI_speed");
+    EXPECT_EQ(messages[0].length, 8u);
+    ASSERT_EQ(messages[0].signals.size(), 2u);
+    EXPECT_DOUBLE_EQ(messages[0].signals[0].scale, 0.1);
+    EXPECT_EQ(messages[0].signals[0].unit, "km/h");
+
+    const auto& current = messages[1].signals[0];
+    EXPECT_TRUE(current.is_signed);
+    EXPECT_FALSE(current.big_endian);
+    EXPECT_DOUBLE_EQ(current.minimum, -500.0);
+    EXPECT_TRUE(messages[1].signals[1].multiplexed);
+
+    EXPECT_TRUE(messages[2].extended);
+    EXPECT_EQ(messages[2].id, 0x300u);
+    EXPECT_TRUE(messages[2].signals[0].big_endian);
+
+    std::istringstream broken("BO_ 1 X: 8 VCU\n SG_ X_a : 0|70@1+ (1,0) [0|1] \"\" X\n");
+    EXPECT_THROW(vdr::parse_dbc(broken), std::runtime_error);
+}
+
+TEST(CanDecoderTest, DecodesByteOrderAndSign) {
+    std::istringstream in(kTestDbc);
+    vdr::CanDecoder decoder(vdr::parse_dbc(in), {
+        {"DI_vehicleSpeed", "Vehicle.Speed", vss_types_VALUE_TYPE_FLOAT},
+        {"DI_gear", "Vehicle.Powertrain.Transmission.CurrentGear", vss_types_VALUE_TYPE_INT32},
+        {"BMS_packCurrent", "Vehicle.Powertrain.TractionBattery.Current",
+         vss_types_VALUE_TYPE_DOUBLE},
+        {"BMS_mode", "Vehicle.Mode", vss_types_VALUE_TYPE_UINT8},
+        {"EXT_word", "Test.Word", vss_types_VALUE_TYPE_UINT16},
+        {"EXT_torque", "Test.Torque", vss_types_VALUE_TYPE_DOUBLE},
+        {"NO_such_signal", "Test.Missing", vss_types_VALUE_TYPE_DOUBLE},
+    });
+    EXPECT_EQ(decoder.signal_count(), 5u);
+    EXPECT_EQ(decoder.unmapped(), (std::vector<std::string>{"BMS_mode", "NO_such_signal"}));
+
+    std::vector<vdr::CanFrame> frames = {
+        make_frame(256, false, {0xE8, 0x03, 0x02, 0, 0, 0, 0, 0}, 1),        // 100.0 km/h, D
+        make_frame(512, false, {0, 0, 0, 0, 0, 0x9C, 0xFF, 0}, 2),           // -10.0 A
+        make_frame(0x300, true, {0x12, 0x34, 0xFF, 0xE0, 0, 0, 0, 0}, 3),    // Motorola
+        make_frame(256, false, {0x01, 0x00, 0x03, 0, 0, 0, 0, 0}, 4),        // 0.1 km/h, L
+        make_frame(0x7FF, false, {0, 0, 0, 0, 0, 0, 0, 0}, 5),               // not in the DBC
+        make_frame(512, false, {0, 0, 0}, 6),                                // too short
+    };
+
+    std::vector<std::pair<std::string, double>> out;
+    size_t decoded = decoder.decode(frames.data(), frames.size(), [&](const vss_Signal& msg) {
+        double value = 0.0;
+        switch (msg.value.type) {
+            case vss_types_VALUE_TYPE_FLOAT: value = msg.value.float_value; break;
+            case vss_types_VALUE_TYPE_INT32: value = msg.value.int32_value; break;
+            case vss_types_VALUE_TYPE_UINT16: value = msg.value.uint16_value; break;
+            default: value = msg.value.double_value; break;
+        }
+        out.emplace_back(msg.path, value);
+        EXPECT_STREQ(msg.header.source_id, vdr::CanDecoder::kSourceId);
+    });
+
+    EXPECT_EQ(decoded, 4u);
+    ASSERT_EQ(out.size(), 7u);
+    // Per signal, in frame order
+    EXPECT_EQ(out[0].first, "Vehicle.Speed");
+    EXPECT_FLOAT_EQ(out[0].second, 100.0f);
+    EXPECT_FLOAT_EQ(out[1].second, 0.1f);
+    EXPECT_EQ(out[2].second, 2);
+    EXPECT_EQ(out[3].second, 3);
+    EXPECT_DOUBLE_EQ(out[4].second, -10.0);
+    EXPECT_EQ(out[5].first, "Test.Word");
+    EXPECT_EQ(out[5].second, 0x1234);
+    // 0xFFE (12 bits from bit 23, MSB first) = -2 -> -2 * 0.5 + 10
+    EXPECT_DOUBLE_EQ(out[6].second, 9.0);
+
+    EXPECT_EQ(decoder.stats().unknown, 1u);
+    EXPECT_EQ(decoder.stats().short_frames, 1u);
+    EXPECT_EQ(decoder.stats().signals, 7u);
+}
+
+// =============================================================================
+// Signal transforms
+// =============================================================================
+
+TEST(SignalTransformTest, RecognizesBuiltinForms) {
+    using vdr::TransformKind;
+    EXPECT_EQ(vdr::parse_transform_code("x").kind, TransformKind::Identity);
+    EXPECT_EQ(vdr::parse_transform_code(" x ").kind, TransformKind::Identity);
+
+    auto lowpass = vdr::parse_transform_code("lowpass(x, 0.3)");
+    EXPECT_EQ(lowpass.kind, TransformKind::Lowpass);
+    EXPECT_DOUBLE_EQ(lowpass.alpha, 0.3);
+    EXPECT_EQ(vdr::parse_transform_code("moving_average(x, 10)").window, 10u);
+    auto clamp = vdr::parse_transform_code("threshold(x, -500, 500)");
+    EXPECT_EQ(clamp.kind, TransformKind::Threshold);
+    EXPECT_DOUBLE_EQ(clamp.low, -500.0);
+
+    auto compare = vdr::parse_transform_code("x >= 1");
+    EXPECT_EQ(compare.kind, TransformKind::Compare);
+    EXPECT_EQ(compare.op, vdr::CompareOp::GreaterEqual);
+    auto sustained = vdr::parse_transform_code("sustained_condition(x > 30, 2000)");
+    EXPECT_EQ(sustained.kind, TransformKind::SustainedCondition);
+    EXPECT_EQ(sustained.hold_ns, 2000000000);
+
+    auto custom = vdr::parse_transform_code("x * 2 + 1");
+    EXPECT_EQ(custom.kind, TransformKind::Lua);
+    EXPECT_EQ(custom.code, "x * 2 + 1");
+    EXPECT_EQ(vdr::parse_transform_code("lowpass(y, 0.3)").kind, TransformKind::Lua);
+
+    if (!vdr::SignalTransform::lua_available()) {
+        EXPECT_THROW(vdr::SignalTransform{custom}, std::invalid_argument);
+    }
+    lowpass.alpha = 1.5;
+    EXPECT_THROW(vdr::SignalTransform{lowpass}, std::invalid_argument);
+
+    for (const char* bad : {"moving_average(x, -3)", "moving_average(x, nan)",
+                            "moving_average(x, 1e300)", "moving_average(x, 2.5)"}) {
+        SCOPED_TRACE(bad);
+        auto average = vdr::parse_transform_code(bad);
+        EXPECT_EQ(average.kind, TransformKind::MovingAverage);
+        EXPECT_THROW(vdr::SignalTransform{average}, std::invalid_argument);
+    }
+}
+
+TEST(SignalTransformTest, StatefulFilters) {
+    constexpr int64_t kMs = 1000000;
+    double out = 0.0;
+
+    vdr::SignalTransform lowpass(vdr::parse_transform_code("lowpass(x, 0.5)"));
+    ASSERT_TRUE(lowpass.apply(10.0, 0, out));
+    EXPECT_DOUBLE_EQ(out, 10.0);
+    lowpass.apply(20.0, kMs, out);
+    EXPECT_DOUBLE_EQ(out, 15.0);
+
+    vdr::SignalTransform average(vdr::parse_transform_code("moving_average(x, 2)"));
+    average.apply(1.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 1.0);
+    average.apply(3.0, kMs, out);
+    EXPECT_DOUBLE_EQ(out, 2.0);
+    average.apply(7.0, 2 * kMs, out);
+    EXPECT_DOUBLE_EQ(out, 5.0);
+
+    vdr::SignalTransform derivative(vdr::parse_transform_code("derivative(x)"));
+    derivative.apply(5.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 0.0);
+    derivative.apply(6.0, 500 * kMs, out);
+    EXPECT_DOUBLE_EQ(out, 2.0);
+
+    vdr::SignalTransform clamp(vdr::parse_transform_code("threshold(x, 0, 100)"));
+    clamp.apply(-3.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 0.0);
+    clamp.apply(130.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 100.0);
+
+    vdr::SignalTransform compare(vdr::parse_transform_code("x ~= 0"));
+    compare.apply(0.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 0.0);
+    compare.apply(2.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 1.0);
+
+    vdr::SignalTransform sustained(
+        vdr::parse_transform_code("sustained_condition(x > 30, 100)"));
+    sustained.apply(40.0, 0, out);
+    EXPECT_DOUBLE_EQ(out, 0.0);
+    sustained.apply(40.0, 100 * kMs, out);
+    EXPECT_DOUBLE_EQ(out, 1.0);
+    sustained.apply(10.0, 150 * kMs, out);
+    EXPECT_DOUBLE_EQ(out, 0.0);
+    sustained.apply(40.0, 200 * kMs, out);
+    EXPECT_DOUBLE_EQ(out, 0.0);
+
+    vdr::TransformSpec gears;
+    gears.kind = vdr::TransformKind::ValueMap;
+    gears.value_map = {{0, -1}, {4, 1}};
+    vdr::SignalTransform map(gears);
+    ASSERT_TRUE(map.apply(4.0, 0, out));
+    EXPECT_DOUBLE_EQ(out, 1.0);
+    EXPECT_FALSE(map.apply(5.0, 0, out));
+}
+
+TEST(SignalTransformTest, DecoderAppliesTransforms) {
+    std::istringstream in(kTestDbc);
+    vdr::CanSignalMapping speed{"DI_vehicleSpeed", "Vehicle.Speed", vss_types_VALUE_TYPE_FLOAT,
+                                vdr::parse_transform_code("x > 50")};
+    vdr::CanSignalMapping gear{"DI_gear", "Vehicle.Powertrain.Transmission.CurrentGear",
+                               vss_types_VALUE_TYPE_INT32, {}};
+    gear.transform.kind = vdr::TransformKind::ValueMap;
+    gear.transform.value_map = {{2, 1}};
+    vdr::CanDecoder decoder(vdr::parse_dbc(in), {speed, gear});
+
+    std::vector<vdr::CanFrame> frames = {
+        make_frame(256, false, {0xE8, 0x03, 0x02, 0, 0, 0, 0, 0}, 1),  // 100.0 km/h, D
+        make_frame(256, false, {0x01, 0x00, 0x03, 0, 0, 0, 0, 0}, 2),  // 0.1 km/h, L
+    };
+    std::vector<double> out;
+    decoder.decode(frames.data(), frames.size(), [&](const vss_Signal& msg) {
+        out.push_back(msg.value.type == vss_types_VALUE_TYPE_FLOAT ? msg.value.float_value
+                                                                  : msg.value.int32_value);
+    });
+
+    // Gear 3 is not in the value_map
+    EXPECT_EQ(out, (std::vector<double>{1.0, 0.0, 1.0}));
+    EXPECT_EQ(decoder.stats().signals, 3u);
+    EXPECT_EQ(decoder.stats().filtered, 1u);
+}
+
+TEST(SignalTransformTest, DecoderEvaluatesDerivedSignals) {
+    auto derived = [](const char* path, std::vector<std::string> depends_on,
+                      std::string_view code) {
+        vdr::CanSignalMapping mapping{"", path, vss_types_VALUE_TYPE_DOUBLE,
+                                      vdr::parse_transform_code(code)};
+        mapping.depends_on = std::move(depends_on);
+        return mapping;
+    };
+    std::istringstream in(kTestDbc);
+    vdr::CanDecoder decoder(vdr::parse_dbc(in), {
+        {"DI_vehicleSpeed", "Vehicle.Speed", vss_types_VALUE_TYPE_DOUBLE},
+        {"DI_gear", "Vehicle.Powertrain.Transmission.CurrentGear", vss_types_VALUE_TYPE_DOUBLE},
+        derived("Test.Fast", {"Vehicle.Speed"}, "x > 50"),
+        derived("Test.Both", {"Vehicle.Powertrain.Transmission.CurrentGear", "Vehicle.Speed"},
+                "x"),
+        derived("Test.Chain", {"Test.Fast"}, "x"),
+        derived("Test.A", {"Test.B"}, "x"),
+        derived("Test.B", {"Test.A"}, "x"),
+        derived("Test.Orphan", {"CAN.VehicleSpeed"}, "x"),
+    });
+    EXPECT_EQ(decoder.signal_count(), 5u);
+    EXPECT_EQ(decoder.unmapped(), (std::vector<std::string>{"Test.A", "Test.B", "Test.Orphan"}));
+
+    std::vector<vdr::CanFrame> frames = {
+        make_frame(256, false, {0xE8, 0x03, 0x02, 0, 0, 0, 0, 0}, 1),  // 100.0 km/h, D
+        make_frame(256, false, {0x01, 0x00, 0x03, 0, 0, 0, 0, 0}, 2),  // 0.1 km/h, L
+    };
+    std::vector<std::pair<std::string, double>> out;
+    std::vector<int64_t> timestamps;
+    decoder.decode(frames.data(), frames.size(), [&](const vss_Signal& msg) {
+        out.emplace_back(msg.path, msg.value.double_value);
+        timestamps.push_back(msg.header.timestamp_ns);
+    });
+
+    // Decoded signals first, then derived ones frame by frame: Test.Both
+    // pairs each gear with the speed of the same frame
+    std::vector<std::pair<std::string, double>> expected = {
+        {"Vehicle.Speed", 100.0}, {"Vehicle.Speed", 0.1},
+        {"Vehicle.Powertrain.Transmission.CurrentGear", 2.0},
+        {"Vehicle.Powertrain.Transmission.CurrentGear", 3.0},
+        {"Test.Fast", 1.0}, {"Test.Both", 2.0}, {"Test.Chain", 1.0},
+        {"Test.Fast", 0.0}, {"Test.Both", 3.0}, {"Test.Chain", 0.0},
+    };
+    EXPECT_EQ(out, expected);
+    EXPECT_EQ(timestamps, (std::vector<int64_t>{1, 2, 1, 2, 1, 1, 1, 2, 2, 2}));
+    EXPECT_EQ(decoder.stats().signals, 10u);
+}
+
+TEST(SignalTransformTest, RunsShippedDerivedSnippet) {
+    auto mappings = vdr::load_vssdag_mappings(VDR_SOURCE_DIR "/config/vssdag_probe_config.yaml");
+    auto find = [&](const std::string& path) {
+        return std::find_if(mappings.begin(), mappings.end(),
+                            [&](const auto& mapping) { return mapping.vss_path == path; });
+    };
+    auto acceleration = find("Vehicle.Acceleration.Longitudinal");
+    if (!vdr::SignalTransform::lua_available()) {
+        // Its snippet reads deps[]; without Lua it is left out, not published raw
+        EXPECT_EQ(acceleration, mappings.end());
+        GTEST_SKIP() << "no Lua in this build";
+    }
+    ASSERT_NE(acceleration, mappings.end());
+    EXPECT_EQ(acceleration->depends_on, (std::vector<std::string>{"Vehicle.Speed"}));
+
+    vdr::CanDecoder decoder(vdr::load_dbc(VDR_SOURCE_DIR "/config/sample_vehicle.dbc"),
+                            mappings);
+    // Depends on a mock signal, which is not decoded
+    EXPECT_NE(std::find(decoder.unmapped().begin(), decoder.unmapped().end(),
+                        "Vehicle.Speed.Simulated"),
+              decoder.unmapped().end());
+
+    constexpr int64_t kSecond = 1000000000;
+    std::vector<vdr::CanFrame> frames = {
+        make_frame(256, false, {0x68, 0x01, 0, 0, 0, 0, 0, 0}, 0),        // 36.0 km/h
+        make_frame(256, false, {0xD0, 0x02, 0, 0, 0, 0, 0, 0}, kSecond),  // 72.0 km/h
+    };
+    std::vector<float> accel;
+    decoder.decode(frames.data(), frames.size(), [&](const vss_Signal& msg) {
+        if (std::string(msg.path) == "Vehicle.Acceleration.Longitudinal") {
+            accel.push_back(msg.value.float_value);
+        }
+    });
+
+    // Vehicle.Speed is lowpass(x, 0.3): 36 -> 46.8 km/h in 1 s = 3 m/s^2
+    ASSERT_EQ(accel.size(), 2u);
+    EXPECT_FLOAT_EQ(accel[0], 0.0f);
+    EXPECT_FLOAT_EQ(accel[1], 3.0f);
+}
+
+// =============================================================================
+// CompositeSink
+// =============================================================================
+
+namespace {
+
+using namespace std::chrono_literals;
+
+vss_Signal make_signal(const char* path) {
+    vss_Signal msg{};
+    msg.path = const_cast<char*>(path);
+    msg.header.source_id = const_cast<char*>("test");
+    msg.value.type = vss_types_VALUE_TYPE_DOUBLE;
+    return msg;
+}
+
+/// Records signal paths; send() blocks while the gate is closed.
+class GatedSink : public vdr::OutputSink {
+public:
+    bool start() override { return true; }
+    void stop() override { open(); }
+
+    void send(const vss_Signal& msg) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++in_send_;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return open_; });
+        paths_.emplace_back(msg.path);
+        cv_.notify_all();
+    }
+    void send(const telemetry_events_Event&) override {}
+    void send(const telemetry_metrics_Gauge&) override {}
+    void send(const telemetry_metrics_Counter&) override {}
+    void send(const telemetry_metrics_Histogram&) override {}
+    void send(const telemetry_logs_LogEntry&) override {}
+    void send(const telemetry_diagnostics_ScalarMeasurement&) override {}
+    void send(const telemetry_diagnostics_VectorMeasurement&) override {}
+
+    bool healthy() const override { return true; }
+    vdr::SinkStats stats() const override { return {}; }
+    std::string name() const override { return "GatedSink"; }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+    /// Wait until the worker is stuck in send()
+    bool wait_in_send() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, 2s, [this] { return in_send_ > 0; });
+    }
+
+    std::vector<std::string> wait_for(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, 2s, [&] { return paths_.size() >= count; });
+        return paths_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+    size_t in_send_ = 0;
+    std::vector<std::string> paths_;
+};
+
+/// Records the size of every send_batch() call (0 for a plain send()).
+class BatchSizeSink : public vdr::OutputSink {
+public:
+    using OutputSink::send_batch;
+
+    bool start() override { return true; }
+    void stop() override {}
+
+    void send(const vss_Signal&) override { record(0); }
+    void send(const telemetry_events_Event&) override { record(0); }
+    void send(const telemetry_metrics_Gauge&) override {}
+    void send(const telemetry_metrics_Counter&) override {}
+    void send(const telemetry_metrics_Histogram&) override {}
+    void send(const telemetry_logs_LogEntry&) override {}
+    void send(const telemetry_diagnostics_ScalarMeasurement&) override {}
+    void send(const telemetry_diagnostics_VectorMeasurement&) override {}
+
+    void send_batch(utils::Span<const vss_Signal> msgs) override { record(msgs.size()); }
+    void send_batch(utils::Span<const telemetry_events_Event> msgs) override {
+        record(msgs.size());
+    }
+
+    bool healthy() const override { return true; }
+    vdr::SinkStats stats() const override { return {}; }
+    std::string name() const override { return "BatchSizeSink"; }
+
+    std::vector<size_t> wait_for(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, 2s, [&] { return calls_.size() >= count; });
+        return calls_;
+    }
+
+private:
+    void record(size_t size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.push_back(size);
+        cv_.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<size_t> calls_;
+};
+
+}  // namespace
+
+TEST(CompositeSinkTest, ParseOverflowPolicy) {
+    EXPECT_EQ(vdr::sinks::parse_overflow_policy("drop_oldest"),
+              vdr::sinks::OverflowPolicy::DropOldest);
+    EXPECT_EQ(vdr::sinks::parse_overflow_policy("block"), vdr::sinks::OverflowPolicy::Block);
+    EXPECT_FALSE(vdr::sinks::parse_overflow_policy("drop"));
+}
+
+TEST(CompositeSinkTest, FansOutCopiesToEveryChild) {
+    auto first = std::make_unique<vdr::sinks::CaptureSink>();
+    auto second = std::make_unique<vdr::sinks::CaptureSink>();
+    auto* a = first.get();
+    auto* b = second.get();
+
+    vdr::sinks::CompositeSink sink;
+    sink.add(std::move(first));
+    sink.add(std::move(second));
+    ASSERT_TRUE(sink.start());
+    EXPECT_EQ(sink.name(), "CompositeSink(CaptureSink, CaptureSink)");
+
+    {
+        // The queued copy must not point into the caller's buffer
+        std::string path = "Vehicle.Speed";
+        sink.send(make_signal(path.c_str()));
+        path.assign(path.size(), '#');
+    }
+    sink.send(make_signal("Vehicle.Cabin.Temperature"));
+
+    ASSERT_TRUE(a->wait_for_signals(2, 2s));
+    ASSERT_TRUE(b->wait_for_signals(2, 2s));
+    EXPECT_EQ(b->signals()[0].path, "Vehicle.Speed");
+    EXPECT_EQ(b->signals()[1].path, "Vehicle.Cabin.Temperature");
+    EXPECT_TRUE(sink.healthy());
+
+    sink.stop();
+    EXPECT_FALSE(sink.healthy());
+    EXPECT_EQ(sink.stats().messages_sent, 4u);
+    for (const auto& lane : sink.lane_stats()) {
+        EXPECT_EQ(lane.delivered, 2u);
+        EXPECT_EQ(lane.depth, 0u);
+        // Recorded by the worker, not read from the child by this thread
+        EXPECT_EQ(lane.sink_stats.messages_sent, 2u);
+    }
+}
+
+TEST(CompositeSinkTest, StalledChildOnlyLosesItsOwnMessages) {
+    constexpr const char* kPaths[] = {"p0", "p1", "p2", "p3", "p4", "p5"};
+
+    for (auto policy : {vdr::sinks::OverflowPolicy::DropNewest,
+                        vdr::sinks::OverflowPolicy::DropOldest}) {
+        auto gated = std::make_unique<GatedSink>();
+        auto capture = std::make_unique<vdr::sinks::CaptureSink>();
+        auto* slow = gated.get();
+        auto* fast = capture.get();
+
+        vdr::sinks::CompositeSink sink;
+        sink.add(std::move(gated), {2, policy, 0ms});
+        sink.add(std::move(capture));
+        ASSERT_TRUE(sink.start());
+
+        // p0 holds the slow worker; p1..p5 compete for two queue slots
+        sink.send(make_signal(kPaths[0]));
+        ASSERT_TRUE(slow->wait_in_send());
+        for (size_t i = 1; i < 6; ++i) {
+            sink.send(make_signal(kPaths[i]));
+        }
+        ASSERT_TRUE(fast->wait_for_signals(6, 2s));
+
+        auto lanes = sink.lane_stats();
+        EXPECT_EQ(lanes[0].dropped, 3u);
+        EXPECT_EQ(lanes[0].depth, 2u);
+        EXPECT_EQ(lanes[1].dropped, 0u);
+
+        slow->open();
+        auto delivered = slow->wait_for(3);
+        if (policy == vdr::sinks::OverflowPolicy::DropNewest) {
+            EXPECT_EQ(delivered, (std::vector<std::string>{"p0", "p1", "p2"}));
+        } else {
+            EXPECT_EQ(delivered, (std::vector<std::string>{"p0", "p4", "p5"}));
+        }
+        sink.stop();
+        EXPECT_EQ(sink.stats().messages_failed, 3u);
+        EXPECT_GT(sink.lane_stats()[0].max_lag_ns, 0);
+    }
+}
+
+TEST(CompositeSinkTest, BlockTimeoutIsSharedByOneBatch) {
+    auto gated = std::make_unique<GatedSink>();
+    auto* slow = gated.get();
+    vdr::sinks::CompositeSink sink;
+    sink.add(std::move(gated), {1, vdr::sinks::OverflowPolicy::Block, 50ms});
+    ASSERT_TRUE(sink.start());
+
+    // p0 holds the worker, p1 fills the queue; the batch finds no room
+    sink.send(make_signal("p0"));
+    ASSERT_TRUE(slow->wait_in_send());
+    sink.send(make_signal("p1"));
+
+    std::vector<vss_Signal> batch(20, make_signal("late"));
+    auto start = std::chrono::steady_clock::now();
+    sink.send_batch(utils::Span<const vss_Signal>(batch));
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(waited, 50ms);
+    EXPECT_LT(waited, 500ms);  // 20 x 50ms if each message waited
+    EXPECT_EQ(sink.lane_stats()[0].dropped, 20u);
+
+    slow->open();
+    EXPECT_EQ(slow->wait_for(2), (std::vector<std::string>{"p0", "p1"}));
+    sink.stop();
+}
+
+TEST(CompositeSinkTest, BatchGoesThroughOneQueueInOrder) {
+    auto capture = std::make_unique<vdr::sinks::CaptureSink>();
+    auto* child = capture.get();
+
+    vdr::sinks::CompositeSink sink;
+    sink.add(std::move(capture), {2, vdr::sinks::OverflowPolicy::DropNewest, 0ms});
+    ASSERT_TRUE(sink.start());
+
+    // CaptureSink keeps the default send_batch(), which loops over send()
+    std::vector<vss_Signal> batch = {make_signal("a"), make_signal("b"), make_signal("c")};
+    sink.send_batch(utils::Span<const vss_Signal>(batch));
+    ASSERT_TRUE(child->wait_for_signals(2, 2s));
+    sink.stop();
+
+    auto signals = child->signals();
+    ASSERT_EQ(signals.size(), 2u);
+    EXPECT_EQ(signals[0].path, "a");
+    EXPECT_EQ(signals[1].path, "b");
+    EXPECT_EQ(sink.lane_stats()[0].dropped, 1u);
+}
+
+TEST(CompositeSinkTest, WorkerHandsRunsToChildSendBatch) {
+    auto child = std::make_unique<BatchSizeSink>();
+    auto* batches = child.get();
+    vdr::sinks::CompositeSink sink;
+    sink.add(std::move(child));
+    ASSERT_TRUE(sink.start());
+
+    // One enqueue holds the lane lock throughout: the worker swaps out all of it
+    std::vector<vss_Signal> signals = {make_signal("s0"), make_signal("s1"), make_signal("s2"),
+                                       make_signal("s3"), make_signal("s4")};
+    sink.send_batch(utils::Span<const vss_Signal>(signals));
+    EXPECT_EQ(batches->wait_for(1), std::vector<size_t>{5});
+
+    telemetry_events_Event event{};
+    std::vector<telemetry_events_Event> events(2, event);
+    sink.send_batch(utils::Span<const telemetry_events_Event>(events));
+    EXPECT_EQ(batches->wait_for(2), (std::vector<size_t>{5, 2}));
+    sink.stop();
+    EXPECT_EQ(sink.lane_stats()[0].delivered, 7u);
+}
+
+// =============================================================================
+// MpscRing
+// =============================================================================
+
+TEST(MpscRingTest, FullRingRefusesAndWrapsInOrder) {
+    utils::MpscRing<std::string> ring(3, [](std::string& slot) { slot.reserve(32); });
+    ASSERT_EQ(ring.capacity(), 4u);
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push([i](std::string& slot) { slot = std::to_string(i); }));
+    }
+    EXPECT_FALSE(ring.try_push([](std::string&) { FAIL() << "full ring called fill"; }));
+    EXPECT_EQ(ring.size(), 4u);
+
+    std::vector<std::string> out;
+    auto collect = [&](std::string& slot) { out.push_back(slot); };
+    EXPECT_EQ(ring.consume(collect, 3), 3u);
+    EXPECT_TRUE(ring.try_push([](std::string& slot) { slot = "4"; }));
+    EXPECT_EQ(ring.consume(collect), 2u);
+    EXPECT_EQ(out, (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.wait_for(std::chrono::milliseconds(1)));
+}
+
+TEST(MpscRingTest, ThrowingFillDoesNotStallTheRing) {
+    utils::MpscRing<int> ring(4);
+    EXPECT_TRUE(ring.try_push([](int& slot) { slot = 1; }));
+    EXPECT_THROW(ring.try_push([](int&) { throw std::bad_alloc(); }), std::bad_alloc);
+    EXPECT_TRUE(ring.try_push([](int& slot) { slot = 3; }));
+
+    std::vector<int> out;
+    EXPECT_EQ(ring.consume([&](int& slot) { out.push_back(slot); }), 2u);
+    EXPECT_EQ(out, (std::vector<int>{1, 3}));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MpscRingTest, ConcurrentProducersKeepPerProducerOrder) {
+    constexpr uint32_t kProducers = 4;
+    constexpr uint32_t kPerProducer = 20000;
+    utils::MpscRing<uint64_t> ring(256);
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint32_t i = 0; i < kPerProducer; ++i) {
+                uint64_t value = (uint64_t{p} << 32) | i;
+                while (!ring.try_push([value](uint64_t& slot) { slot = value; })) {
+                    ring.notify();
+                    std::this_thread::yield();
+                }
+                ring.notify();
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(kProducers, 0);
+    size_t received = 0;
+    bool ordered = true;
+    while (received < kProducers * kPerProducer) {
+        received += ring.consume([&](uint64_t& value) {
+            auto producer = static_cast<uint32_t>(value >> 32);
+            ordered &= static_cast<uint32_t>(value) == next[producer]++;
+        });
+        if (received < kProducers * kPerProducer) {
+            ring.wait_for(std::chrono::milliseconds(10));
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(next, std::vector<uint32_t>(kProducers, kPerProducer));
+    EXPECT_TRUE(ring.empty());
+}
+
+// =============================================================================
+// TopicBatcher
+// =============================================================================
+
+namespace {
+
+/// Batches emitted by a TopicBatcher, decoded back into messages.
+struct EmittedBatch {
+    std::string topic;
+    std::vector<std::string> messages;
+};
+
+struct BatchRecorder {
+    std::vector<EmittedBatch> batches;
+
+    void operator()(const char* topic, const char* data, size_t size, size_t messages) {
+        EmittedBatch batch{topic, {}};
+        bool ok = vdr::sinks::for_each_batch_message(
+            reinterpret_cast<const uint8_t*>(data), size,
+            [&](std::string_view message) { batch.messages.emplace_back(message); });
+        EXPECT_TRUE(ok);
+        EXPECT_EQ(batch.messages.size(), messages);
+        batches.push_back(std::move(batch));
+    }
+};
+
+constexpr int64_t kMs = 1000000;
+
+}  // namespace
+
+TEST(TopicBatcherTest, FlushesOnCountAndKeepsTopicsApart) {
+    vdr::sinks::BatchConfig config;
+    config.max_messages = 3;
+    vdr::sinks::TopicBatcher batcher(config);
+    ASSERT_TRUE(batcher.enabled());
+    BatchRecorder out;
+
+    batcher.add("vss/signals", "s0", 0, out);
+    batcher.add("logs", "l0", 0, out);
+    batcher.add("vss/signals", "s1", 0, out);
+    EXPECT_TRUE(out.batches.empty());
+    EXPECT_EQ(batcher.pending(), 3u);
+
+    batcher.add("vss/signals", "s2", 0, out);
+    ASSERT_EQ(out.batches.size(), 1u);
+    EXPECT_EQ(out.batches[0].topic, "vss/signals");
+    EXPECT_EQ(out.batches[0].messages, (std::vector<std::string>{"s0", "s1", "s2"}));
+
+    batcher.flush_all(out);
+    ASSERT_EQ(out.batches.size(), 2u);
+    EXPECT_EQ(out.batches[1].topic, "logs");
+    EXPECT_EQ(out.batches[1].messages, std::vector<std::string>{"l0"});
+    EXPECT_EQ(batcher.pending(), 0u);
+    EXPECT_EQ(batcher.next_deadline(), INT64_MAX);
+
+    vdr::sinks::BatchConfig unbatched;
+    unbatched.max_messages = 1;
+    EXPECT_FALSE(vdr::sinks::TopicBatcher(unbatched).enabled());
+}
+
+TEST(TopicBatcherTest, ByteBudgetSplitsBatches) {
+    vdr::sinks::BatchConfig config;
+    config.max_messages = 100;
+    config.max_bytes = vdr::sinks::kBatchHeaderSize + 2 * (vdr::sinks::kBatchLengthSize + 10);
+    vdr::sinks::TopicBatcher batcher(config);
+    BatchRecorder out;
+
+    std::string ten(10, 'x');
+    batcher.add("logs", ten, 0, out);
+    batcher.add("logs", ten, 0, out);  // exactly max_bytes
+    ASSERT_EQ(out.batches.size(), 1u);
+    EXPECT_EQ(out.batches[0].messages.size(), 2u);
+
+    batcher.add("logs", "short", 0, out);
+    batcher.add("logs", std::string(20, 'y'), 0, out);  // would overflow: "short" goes first
+    ASSERT_EQ(out.batches.size(), 2u);
+    EXPECT_EQ(out.batches[1].messages, std::vector<std::string>{"short"});
+
+    batcher.add("logs", std::string(100, 'z'), 0, out);  // oversized: a batch of one
+    ASSERT_EQ(out.batches.size(), 4u);
+    EXPECT_EQ(out.batches[2].messages, std::vector<std::string>{std::string(20, 'y')});
+    EXPECT_EQ(out.batches[3].messages, std::vector<std::string>{std::string(100, 'z')});
+    EXPECT_EQ(batcher.pending(), 0u);
+}
+
+TEST(TopicBatcherTest, CriticalTopicsHaveTighterDeadlines) {
+    vdr::sinks::BatchConfig config;
+    config.flush_interval = std::chrono::milliseconds(1000);
+    config.critical_flush_interval = std::chrono::milliseconds(20);
+    vdr::sinks::TopicBatcher batcher(config);
+    BatchRecorder out;
+
+    batcher.add("telemetry/gauges", "g0", 0, out);
+    batcher.add("events", "e0", 5 * kMs, out);
+    batcher.add("events", "e1", 10 * kMs, out);  // deadline set by the first message
+    EXPECT_EQ(batcher.next_deadline(), 25 * kMs);
+
+    batcher.flush_due(24 * kMs, out);
+    EXPECT_TRUE(out.batches.empty());
+    batcher.flush_due(25 * kMs, out);
+    ASSERT_EQ(out.batches.size(), 1u);
+    EXPECT_EQ(out.batches[0].topic, "events");
+    EXPECT_EQ(out.batches[0].messages, (std::vector<std::string>{"e0", "e1"}));
+    EXPECT_EQ(batcher.next_deadline(), 1000 * kMs);
+
+    batcher.flush_due(1000 * kMs, out);
+    ASSERT_EQ(out.batches.size(), 2u);
+    EXPECT_EQ(out.batches[1].topic, "telemetry/gauges");
+}
+
+TEST(TopicBatcherTest, RejectsMalformedBatches) {
+    const uint8_t one[] = {'V', 'B', vdr::sinks::kBatchVersion, 0, 0, 0, 0, 1,
+                           0, 0, 0, 2, 'h', 'i'};
+    size_t calls = 0;
+    auto count = [&](std::string_view) { ++calls; };
+    EXPECT_TRUE(vdr::sinks::for_each_batch_message(one, sizeof(one), count));
+    EXPECT_FALSE(vdr::sinks::for_each_batch_message(one, sizeof(one) - 1, count));
+
+    uint8_t bad_magic[sizeof(one)];
+    std::memcpy(bad_magic, one, sizeof(one));
+    bad_magic[0] = 'X';
+    EXPECT_FALSE(vdr::sinks::for_each_batch_message(bad_magic, sizeof(bad_magic), count));
+    EXPECT_EQ(calls, 1u);
+}
+
+// =============================================================================
+// MessagePack
+// =============================================================================
+
+TEST(MsgpackTest, WriterPicksSmallestEncoding) {
+    std::string out;
+    utils::MsgpackWriter w(out);
+    auto bytes = [&out] {
+        std::vector<int> b(out.begin(), out.end());
+        for (int& v : b) v &= 0xff;
+        out.clear();
+        return b;
+    };
+
+    w.uinteger(127);
+    EXPECT_EQ(bytes(), (std::vector<int>{0x7f}));
+    w.uinteger(128);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xcc, 0x80}));
+    w.uinteger(65536);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xce, 0x00, 0x01, 0x00, 0x00}));
+    w.integer(-32);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xe0}));
+    w.integer(-33);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xd0, 0xdf}));
+    w.integer(-129);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xd1, 0xff, 0x7f}));
+    w.string("ab");
+    EXPECT_EQ(bytes(), (std::vector<int>{0xa2, 'a', 'b'}));
+    w.string(nullptr);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xa0}));
+    w.array(16);
+    EXPECT_EQ(bytes(), (std::vector<int>{0xdc, 0x00, 0x10}));
+    w.map(1);
+    EXPECT_EQ(bytes(), (std::vector<int>{0x81}));
+
+    // Every width round-trips through an independent decoder
+    std::vector<int64_t> values = {0, 255, 256, 65535, 70000, 5000000000LL, -1, -128,
+                                   -32768, -32769, -5000000000LL, INT64_MIN};
+    w.array(static_cast<uint32_t>(values.size() + 1));
+    for (int64_t v : values) {
+        w.integer(v);
+    }
+    w.uinteger(UINT64_MAX);
+    auto decoded = nlohmann::json::from_msgpack(out);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(decoded[i].get<int64_t>(), values[i]) << i;
+    }
+    EXPECT_EQ(decoded[values.size()].get<uint64_t>(), UINT64_MAX);
+}
+
+TEST(MsgpackTest, SignalLayoutAndSizeAgainstJson) {
+    vss_Signal msg{};
+    msg.path = const_cast<char*>("Vehicle.Speed");
+    msg.header.source_id = const_cast<char*>("can_probe");
+    msg.header.timestamp_ns = 1700000000123456789LL;
+    msg.header.seq_num = 42;
+    msg.quality = vss_types_QUALITY_VALID;
+    msg.value.type = vss_types_VALUE_TYPE_FLOAT;
+    msg.value.float_value = 88.5f;
+
+    std::string out;
+    vdr::sinks::encode_msgpack(msg, out);
+    auto decoded = nlohmann::json::from_msgpack(out);
+    ASSERT_TRUE(decoded.is_array());
+    ASSERT_EQ(decoded.size(), 5u);
+    EXPECT_EQ(decoded[0], nlohmann::json::parse(
+        R"(["can_probe", 1700000000123456789, 42, ""])"));
+    EXPECT_EQ(decoded[1], "Vehicle.Speed");
+    EXPECT_EQ(decoded[2], static_cast<int>(vss_types_QUALITY_VALID));
+    EXPECT_EQ(decoded[3], static_cast<int>(vss_types_VALUE_TYPE_FLOAT));
+    EXPECT_FLOAT_EQ(decoded[4].get<float>(), 88.5f);
+
+    // Appends, so a cleared buffer is reused for the next message
+    vdr::sinks::encode_msgpack(msg, out);
+    EXPECT_EQ(out.size() % 2, 0u);
+    EXPECT_LT(out.size() / 2 * 3, vdr::sinks::encode_json(msg).dump().size());
+}
+
+TEST(MsgpackTest, StructValueAndLabelsMatchJsonContent) {
+    vss_types_StructField fields[2] = {};
+    fields[0].name = const_cast<char*>("lat");
+    fields[0].type = vss_types_VALUE_TYPE_DOUBLE;
+    fields[0].double_value = 57.7;
+    fields[1].name = const_cast<char*>("fix");
+    fields[1].type = vss_types_VALUE_TYPE_BOOL;
+    fields[1].bool_value = true;
+
+    vss_Signal signal{};
+    signal.path = const_cast<char*>("Vehicle.CurrentLocation");
+    signal.value.type = vss_types_VALUE_TYPE_STRUCT;
+    signal.value.struct_value.type_name = const_cast<char*>("Location");
+    signal.value.struct_value.fields._buffer = fields;
+    signal.value.struct_value.fields._length = 2;
+
+    std::string out;
+    vdr::sinks::encode_msgpack(signal, out);
+    EXPECT_EQ(nlohmann::json::from_msgpack(out)[4], vdr::sinks::encode_json(signal)["value"]);
+
+    vss_types_KeyValue labels[3] = {{const_cast<char*>("ecu"), const_cast<char*>("bms")},
+                                    {nullptr, const_cast<char*>("skipped")},
+                                    {const_cast<char*>("unit"), const_cast<char*>("V")}};
+    telemetry_metrics_Gauge gauge{};
+    gauge.name = const_cast<char*>("pack_voltage");
+    gauge.labels._buffer = labels;
+    gauge.labels._length = 3;
+    gauge.value = 398.25;
+
+    out.clear();
+    vdr::sinks::encode_msgpack(gauge, out);
+    auto decoded = nlohmann::json::from_msgpack(out);
+    ASSERT_EQ(decoded.size(), 4u);
+    EXPECT_EQ(decoded[1], "pack_voltage");
+    EXPECT_EQ(decoded[2], vdr::sinks::encode_json(gauge)["labels"]);
+    EXPECT_EQ(decoded[3], 398.25);
+}
+
+// =============================================================================
+// Protobuf
+// =============================================================================
+
+TEST(ProtobufTest, EventKeepsFullContext) {
+    vss_types_KeyValue attributes[2] = {{const_cast<char*>("decel_g"), const_cast<char*>("0.9")},
+                                        {const_cast<char*>("abs"), nullptr}};
+    int32_t cells[3] = {-1, 0, 300};
+    vss_Signal context[2] = {};
+    context[0].path = const_cast<char*>("Vehicle.Speed");
+    context[0].quality = vss_types_QUALITY_VALID;
+    context[0].value.type = vss_types_VALUE_TYPE_FLOAT;
+    context[0].value.float_value = 42.5f;
+    context[1].path = const_cast<char*>("Vehicle.Cells");
+    context[1].value.type = vss_types_VALUE_TYPE_INT32_ARRAY;
+    context[1].value.int32_array._buffer = cells;
+    context[1].value.int32_array._length = 3;
+
+    telemetry_events_Event event{};
+    event.event_id = const_cast<char*>("evt-1");
+    event.header.source_id = const_cast<char*>("adas");
+    event.header.timestamp_ns = 1700000000000000000LL;
+    event.header.seq_num = 7;
+    event.category = const_cast<char*>("ADAS");
+    event.event_type = const_cast<char*>("harsh_brake");
+    event.severity = telemetry_events_SEVERITY_WARNING;
+    event.attributes._buffer = attributes;
+    event.attributes._length = 2;
+    event.context._buffer = context;
+    event.context._length = 2;
+
+    std::string out = "prefix";
+    vdr::sinks::encode_protobuf(event, out);
+    ASSERT_EQ(out.compare(0, 6, "prefix"), 0);
+
+    vdr::offboard::Event decoded;
+    ASSERT_TRUE(decoded.ParseFromString(out.substr(6)));
+    EXPECT_EQ(decoded.event_id(), "evt-1");
+    EXPECT_EQ(decoded.header().source_id(), "adas");
+    EXPECT_EQ(decoded.header().timestamp_ns(), 1700000000000000000LL);
+    EXPECT_EQ(decoded.header().seq_num(), 7u);
+    EXPECT_EQ(decoded.event_type(), "harsh_brake");
+    EXPECT_EQ(decoded.severity(), vdr::offboard::SEVERITY_WARNING);
+    ASSERT_EQ(decoded.attributes_size(), 1);
+    EXPECT_EQ(decoded.attributes(0).key(), "decel_g");
+
+    ASSERT_EQ(decoded.context_size(), 2);
+    EXPECT_EQ(decoded.context(0).path(), "Vehicle.Speed");
+    EXPECT_EQ(decoded.context(0).quality(), vdr::offboard::QUALITY_VALID);
+    EXPECT_EQ(decoded.context(0).value().kind_case(), vdr::offboard::Value::kFloatValue);
+    EXPECT_FLOAT_EQ(decoded.context(0).value().float_value(), 42.5f);
+    const auto& array = decoded.context(1).value().int32_array().values();
+    EXPECT_EQ(std::vector<int32_t>(array.begin(), array.end()),
+              (std::vector<int32_t>{-1, 0, 300}));
+
+    // The thread arena is reset between messages; a second encode is identical
+    std::string again;
+    vdr::sinks::encode_protobuf(event, again);
+    EXPECT_EQ(again, out.substr(6));
+}
+
+TEST(ProtobufTest, IncidentCarriesRawEvidence) {
+    uint8_t evidence[4] = {0xde, 0xad, 0x00, 0x01};
+    vss_types_KeyValue indicators[1] = {{const_cast<char*>("src_ip"),
+                                         const_cast<char*>("10.0.0.7")}};
+    telemetry_security_Incident incident{};
+    incident.incident_id = const_cast<char*>("inc-9");
+    incident.threat_level = telemetry_security_THREAT_LEVEL_HIGH;
+    incident.incident_type = const_cast<char*>("can_injection");
+    incident.indicators._buffer = indicators;
+    incident.indicators._length = 1;
+    incident.raw_evidence._buffer = evidence;
+    incident.raw_evidence._length = 4;
+
+    std::string out;
+    vdr::sinks::encode_protobuf(incident, out);
+    vdr::offboard::Incident decoded;
+    ASSERT_TRUE(decoded.ParseFromString(out));
+    EXPECT_EQ(decoded.incident_id(), "inc-9");
+    EXPECT_EQ(decoded.threat_level(), vdr::offboard::THREAT_LEVEL_HIGH);
+    EXPECT_EQ(decoded.description(), "");
+    EXPECT_EQ(decoded.indicators(0).value(), "10.0.0.7");
+    EXPECT_EQ(decoded.raw_evidence(), std::string("\xde\xad\x00\x01", 4));
+    EXPECT_EQ(vdr::sinks::encode_json(incident)["raw_evidence"], "dead0001");
+}
+
+// =============================================================================
+// EncodedSignalBatch
+// =============================================================================
+
+namespace {
+
+using vdr::codec::DecodeStatus;
+
+vdr::codec::DecodeStatus decode_frame(vdr::codec::SignalBatchDecoder& decoder,
+                                      const std::string& frame,
+                                      std::vector<vdr::codec::DecodedSignal>* out = nullptr) {
+    return decoder.decode(reinterpret_cast<const uint8_t*>(frame.data()), frame.size(),
+                          [out](const vdr::codec::DecodedSignal& signal) {
+                              if (out) out->push_back(signal);
+                          });
+}
+
+}  // namespace
+
+TEST(SignalBatchTest, RoundTripsValuesAndTimestamps) {
+    int32_t cells[3] = {-1, 0, 300};
+    const char* modes[2] = {"eco", ""};
+    vss_types_StructField fields[2] = {};
+    fields[0].name = const_cast<char*>("lat");
+    fields[0].type = vss_types_VALUE_TYPE_DOUBLE;
+    fields[0].double_value = 57.7;
+    fields[1].name = const_cast<char*>("fix");
+    fields[1].type = vss_types_VALUE_TYPE_BOOL;
+    fields[1].bool_value = true;
+
+    std::vector<vss_Signal> signals(5);
+    for (size_t i = 0; i < signals.size(); ++i) {
+        signals[i].header.source_id = const_cast<char*>("can_probe");
+        signals[i].header.timestamp_ns = 1700000000000000000LL + static_cast<int64_t>(i) * 1000;
+        signals[i].quality = vss_types_QUALITY_VALID;
+    }
+    signals[0].path = const_cast<char*>("Vehicle.Speed");
+    signals[0].value.type = vss_types_VALUE_TYPE_FLOAT;
+    signals[0].value.float_value = 88.5f;
+    signals[1].path = const_cast<char*>("Vehicle.Powertrain.Range");
+    signals[1].value.type = vss_types_VALUE_TYPE_INT64;
+    signals[1].value.int64_value = -123456789;
+    signals[1].header.timestamp_ns -= 5000;  // out of order: negative delta
+    signals[2].path = const_cast<char*>("Vehicle.Battery.CellVoltages");
+    signals[2].header.source_id = const_cast<char*>("bms");
+    signals[2].quality = vss_types_QUALITY_NOT_AVAILABLE;
+    signals[2].value.type = vss_types_VALUE_TYPE_INT32_ARRAY;
+    signals[2].value.int32_array._buffer = cells;
+    signals[2].value.int32_array._length = 3;
+    signals[3].path = const_cast<char*>("Vehicle.DriveMode");
+    signals[3].value.type = vss_types_VALUE_TYPE_STRING_ARRAY;
+    signals[3].value.string_array._buffer = const_cast<char**>(modes);
+    signals[3].value.string_array._length = 2;
+    signals[4].path = const_cast<char*>("Vehicle.CurrentLocation");
+    signals[4].value.type = vss_types_VALUE_TYPE_STRUCT;
+    signals[4].value.struct_value.type_name = const_cast<char*>("Location");
+    signals[4].value.struct_value.fields._buffer = fields;
+    signals[4].value.struct_value.fields._length = 2;
+
+    vdr::sinks::SignalBatchEncoder encoder(42);
+    std::string dictionary, batch;
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+
+    vdr::codec::SignalBatchDecoder decoder;
+    std::vector<vdr::codec::DecodedSignal> decoded;
+    ASSERT_EQ(decode_frame(decoder, dictionary), DecodeStatus::Ok);
+    ASSERT_EQ(decode_frame(decoder, batch, &decoded), DecodeStatus::Ok);
+    EXPECT_EQ(decoder.session_id(), 42u);
+    ASSERT_EQ(decoded.size(), signals.size());
+
+    for (size_t i = 0; i < signals.size(); ++i) {
+        EXPECT_EQ(decoded[i].path, signals[i].path);
+        EXPECT_EQ(decoded[i].source_id, signals[i].header.source_id);
+        EXPECT_EQ(decoded[i].timestamp_ns, signals[i].header.timestamp_ns);
+        EXPECT_EQ(decoded[i].quality, signals[i].quality);
+        EXPECT_EQ(static_cast<int>(decoded[i].value.type), signals[i].value.type);
+    }
+    EXPECT_EQ(decoded[0].value.double_value, 88.5);
+    EXPECT_EQ(decoded[1].value.int_value, -123456789);
+    EXPECT_EQ(decoded[2].value.int_array, (std::vector<int64_t>{-1, 0, 300}));
+    EXPECT_EQ(decoded[3].value.string_array, (std::vector<std::string>{"eco", ""}));
+    const auto& location = decoded[4].value.struct_value;
+    EXPECT_EQ(location.type_name, "Location");
+    ASSERT_EQ(location.fields.size(), 2u);
+    EXPECT_EQ(location.fields[0].name, "lat");
+    EXPECT_EQ(location.fields[0].double_value, 57.7);
+    EXPECT_TRUE(location.fields[1].bool_value);
+
+    // Well below MessagePack for the same signals
+    std::string msgpack;
+    for (const auto& signal : signals) {
+        vdr::sinks::encode_msgpack(signal, msgpack);
+    }
+    EXPECT_LT(batch.size() * 2, msgpack.size());
+}
+
+TEST(SignalBatchTest, DictionaryIsSentOncePerSession) {
+    std::vector<vss_Signal> signals = {make_signal("Vehicle.Speed"),
+                                       make_signal("Vehicle.Cabin.Temperature")};
+    vdr::sinks::SignalBatchEncoder encoder(7);
+    std::string dictionary, batch;
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    EXPECT_FALSE(dictionary.empty());
+    EXPECT_EQ(encoder.dictionary_size(), 3u);  // two paths, one source
+
+    // Known paths need no dictionary frame; a new one sends only itself
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    EXPECT_TRUE(dictionary.empty());
+    std::string first_batch = batch;
+    signals.push_back(make_signal("Vehicle.Acceleration.Longitudinal"));
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    std::string update = dictionary;
+    EXPECT_NE(update.find("Longitudinal"), std::string::npos);
+    EXPECT_EQ(update.find("Vehicle.Speed"), std::string::npos);
+
+    // A decoder that joins late waits for a snapshot
+    vdr::codec::SignalBatchDecoder decoder;
+    EXPECT_EQ(decode_frame(decoder, first_batch), DecodeStatus::UnknownSession);
+    EXPECT_EQ(decode_frame(decoder, update), DecodeStatus::UnknownSession);
+    encoder.resend_dictionary();
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    EXPECT_EQ(decode_frame(decoder, dictionary), DecodeStatus::Ok);
+    EXPECT_EQ(decoder.dictionary_size(), 4u);
+    std::vector<vdr::codec::DecodedSignal> decoded;
+    EXPECT_EQ(decode_frame(decoder, first_batch, &decoded), DecodeStatus::Ok);
+    EXPECT_EQ(decode_frame(decoder, batch, &decoded), DecodeStatus::Ok);
+    ASSERT_EQ(decoded.size(), 5u);
+    EXPECT_EQ(decoded[4].path, "Vehicle.Acceleration.Longitudinal");
+
+    // A repeated update is harmless
+    EXPECT_EQ(decode_frame(decoder, update), DecodeStatus::Ok);
+    EXPECT_EQ(decoder.dictionary_size(), 4u);
+}
+
+TEST(SignalBatchTest, ExtremeTimestampDeltasWrap) {
+    std::vector<vss_Signal> signals = {make_signal("a"), make_signal("b"), make_signal("c")};
+    signals[0].header.timestamp_ns = std::numeric_limits<int64_t>::max();
+    signals[1].header.timestamp_ns = std::numeric_limits<int64_t>::min();
+    signals[2].header.timestamp_ns = std::numeric_limits<int64_t>::max();
+
+    vdr::sinks::SignalBatchEncoder encoder(3);
+    std::string dictionary, batch;
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+
+    vdr::codec::SignalBatchDecoder decoder;
+    std::vector<vdr::codec::DecodedSignal> decoded;
+    ASSERT_EQ(decode_frame(decoder, dictionary), DecodeStatus::Ok);
+    ASSERT_EQ(decode_frame(decoder, batch, &decoded), DecodeStatus::Ok);
+    ASSERT_EQ(decoded.size(), 3u);
+    for (size_t i = 0; i < signals.size(); ++i) {
+        EXPECT_EQ(decoded[i].timestamp_ns, signals[i].header.timestamp_ns);
+    }
+}
+
+TEST(SignalBatchTest, RejectsGapsAndMalformedFrames) {
+    std::vector<vss_Signal> signals = {make_signal("a")};
+    vdr::sinks::SignalBatchEncoder encoder(9);
+    std::string snapshot, batch, dictionary;
+    encoder.encode(utils::Span<const vss_Signal>(signals), snapshot, batch);
+
+    vdr::codec::SignalBatchDecoder decoder;
+    ASSERT_EQ(decode_frame(decoder, snapshot), DecodeStatus::Ok);
+
+    // The update for "b" is lost; "c" cannot be applied, nor the batches
+    signals[0] = make_signal("b");
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    signals[0] = make_signal("c");
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    EXPECT_EQ(decode_frame(decoder, dictionary), DecodeStatus::MissingEntries);
+    EXPECT_EQ(decode_frame(decoder, batch), DecodeStatus::MissingEntries);
+
+    // Every truncation is refused, never read past
+    encoder.resend_dictionary();
+    encoder.encode(utils::Span<const vss_Signal>(signals), dictionary, batch);
+    ASSERT_EQ(decode_frame(decoder, dictionary), DecodeStatus::Ok);
+    for (size_t size = 0; size < batch.size(); ++size) {
+        EXPECT_NE(decode_frame(decoder, batch.substr(0, size)), DecodeStatus::Ok) << size;
+    }
+    EXPECT_EQ(decode_frame(decoder, batch), DecodeStatus::Ok);
+
+    std::string future = batch;
+    future[2] = 2;
+    EXPECT_EQ(decode_frame(decoder, future), DecodeStatus::UnsupportedVersion);
+}
+
+// =============================================================================
+// Batch compression
+// =============================================================================
+
+namespace {
+
+using vdr::sinks::Compression;
+
+/// One framed batch of `count` JSON-like signal messages.
+std::string make_batch(size_t count) {
+    vdr::sinks::BatchConfig config;
+    config.max_messages = count;
+    vdr::sinks::TopicBatcher batcher(config);
+    std::string framed;
+    auto keep = [&framed](const char*, const char* data, size_t size, size_t) {
+        framed.assign(data, size);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        batcher.add("vss/signals",
+                    "{\"path\":\"Vehicle.Speed\",\"quality\":\"valid\",\"value\":" +
+                        std::to_string(i % 7) + "}",
+                    0, keep);
+    }
+    return framed;
+}
+
+std::vector<std::string> batch_messages(const std::string& framed) {
+    std::vector<std::string> messages;
+    EXPECT_TRUE(vdr::sinks::for_each_batch_message(
+        reinterpret_cast<const uint8_t*>(framed.data()), framed.size(),
+        [&](std::string_view message) { messages.emplace_back(message); }));
+    return messages;
+}
+
+std::vector<Compression> built_in_compressions() {
+    std::vector<Compression> out;
+    for (Compression c : {Compression::Zstd, Compression::Lz4}) {
+        if (vdr::sinks::compression_available(c)) out.push_back(c);
+    }
+    return out;
+}
+
+bool inflate(std::string_view compressed, std::string& out, std::string_view dictionary = {}) {
+    return vdr::sinks::decompress_batch(reinterpret_cast<const uint8_t*>(compressed.data()),
+                                        compressed.size(), out, dictionary);
+}
+
+}  // namespace
+
+TEST(BatchCompressionTest, RoundTripsWithAndWithoutDictionary) {
+    std::string batch = make_batch(50);
+    std::string dictionary;
+    for (int i = 0; i < 20; ++i) {
+        dictionary += "{\"path\":\"Vehicle.Speed\",\"quality\":\"valid\",\"value\":";
+    }
+
+    for (Compression algorithm : built_in_compressions()) {
+        for (bool with_dictionary : {false, true}) {
+            SCOPED_TRACE(std::string(vdr::sinks::to_string(algorithm)) +
+                         (with_dictionary ? " with dictionary" : ""));
+            vdr::sinks::CompressionConfig config;
+            config.algorithm = algorithm;
+            if (with_dictionary) config.dictionary = dictionary;
+            vdr::sinks::BatchCompressor compressor(config);
+
+            std::string scratch;
+            std::string_view compressed = compressor.compress(batch, scratch);
+            ASSERT_LT(compressed.size(), batch.size());
+            uint8_t flags = static_cast<uint8_t>(compressed[3]);
+            EXPECT_EQ(flags & vdr::sinks::kBatchCompressionMask, static_cast<int>(algorithm));
+            EXPECT_EQ((flags & vdr::sinks::kBatchFlagDictionary) != 0, with_dictionary);
+
+            // Compressed frames are not readable as plain batches
+            EXPECT_FALSE(vdr::sinks::for_each_batch_message(
+                reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size(),
+                [](std::string_view) {}));
+
+            std::string restored;
+            ASSERT_TRUE(inflate(compressed, restored, config.dictionary));
+            EXPECT_EQ(restored, batch);
+            EXPECT_EQ(batch_messages(restored).size(), 50u);
+
+            std::string ignored;
+            if (with_dictionary) {
+                EXPECT_FALSE(inflate(compressed, ignored));
+                EXPECT_FALSE(inflate(compressed, ignored, dictionary + "x"));
+            }
+            EXPECT_FALSE(inflate(compressed.substr(0, compressed.size() - 1), ignored,
+                                 config.dictionary));
+        }
+    }
+}
+
+TEST(BatchCompressionTest, SmallAndIncompressibleBatchesPassThrough) {
+    for (Compression algorithm : built_in_compressions()) {
+        vdr::sinks::CompressionConfig config;
+        config.algorithm = algorithm;
+        config.min_bytes = 512;
+        vdr::sinks::BatchCompressor compressor(config);
+        std::string scratch;
+
+        std::string small = make_batch(3);
+        ASSERT_LT(small.size(), config.min_bytes);
+        EXPECT_EQ(compressor.compress(small, scratch).data(), small.data());
+
+        // A single message of pseudo-random bytes does not shrink
+        std::string noise(2000, '\0');
+        uint32_t x = 2463534242u;
+        for (char& c : noise) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            c = static_cast<char>(x);
+        }
+        vdr::sinks::BatchConfig one;
+        one.max_messages = 1;
+        std::string framed;
+        vdr::sinks::TopicBatcher(one).add("logs", noise, 0,
+                                          [&](const char*, const char* data, size_t size,
+                                              size_t) { framed.assign(data, size); });
+        EXPECT_EQ(compressor.compress(framed, scratch).data(), framed.data());
+
+        std::string restored;
+        ASSERT_TRUE(inflate(small, restored));
+        EXPECT_EQ(restored, small);
+    }
+}
+
+TEST(BatchCompressionTest, LevelFollowsBatchSize) {
+    vdr::sinks::CompressionConfig config;
+    config.levels = {{0, 1}, {1000, 3}, {5000, 9}};
+    vdr::sinks::BatchCompressor compressor(config);
+    EXPECT_FALSE(compressor.enabled());
+    EXPECT_EQ(compressor.level_for(0), 1);
+    EXPECT_EQ(compressor.level_for(999), 1);
+    EXPECT_EQ(compressor.level_for(1000), 3);
+    EXPECT_EQ(compressor.level_for(1 << 20), 9);
+
+    EXPECT_EQ(vdr::sinks::parse_compression("lz4"), Compression::Lz4);
+    EXPECT_FALSE(vdr::sinks::parse_compression("gzip").has_value());
+    EXPECT_NE(vdr::sinks::compression_dictionary_id("abc"), 0u);
+
+    for (Compression algorithm : {Compression::Zstd, Compression::Lz4}) {
+        if (!vdr::sinks::compression_available(algorithm)) {
+            vdr::sinks::CompressionConfig missing;
+            missing.algorithm = algorithm;
+            EXPECT_THROW(vdr::sinks::BatchCompressor{missing}, std::invalid_argument);
+        }
+    }
+}